@@ -0,0 +1,383 @@
+// Micro-benchmarks des chemins chauds, chacun isolé sur le même jeu de positions.
+// Une régression de nps se lit ici par sous-système : make/unmake, génération, légalité, SEE, éval, TT, MovePicker.
+//
+//   ./chess26_microbench --benchmark_filter=MoveGen
+//
+// items_per_second : opérations élémentaires (coups joués, coups générés, sondes...) par seconde.
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/move/generator/move_generator.hpp"
+#include "engine/engine_manager.hpp"
+#include "engine/eval/pos_eval.hpp"
+#include "engine/search/move_picker.hpp"
+#include "engine/search/worker.hpp"
+#include "engine/tt/transp_table.hpp"
+
+namespace
+{
+    // Ouvertures, milieux de partie, finales, prises et promotions en suspens
+    constexpr std::array<const char *, 16> Fens = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "rnbqkb1r/pp2pppp/3p1n2/8/3NP3/8/PPP2PPP/RNBQKB1R w KQkq - 1 5",
+        "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/3P1N2/PPP2PPP/RNBQK2R w KQkq - 1 5",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "2r2rk1/1bq1bpp1/p2ppn1p/1p6/3NP3/1BN1BP2/PPQ2P1P/2RR2K1 w - - 0 1",
+        "r2q1rk1/pp2bppp/2n2n2/2bp4/2P5/1PN1PN2/PB1QBPPP/2R2RK1 b - - 0 1",
+        "r1b2rk1/2q1b1pp/p2ppn2/1p6/3QP3/1BN1B3/PPP3PP/R4RK1 w - - 0 1",
+        "3r1rk1/p4ppp/1qp1b3/4P3/2Pn4/1P3N2/P2Q1PPP/R3R1K1 b - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "8/5pk1/1p1p2p1/2pP1p1p/2P2P1P/1P4P1/5K2/8 w - - 0 1",
+        "6k1/5p2/6p1/8/7p/8/6PP/6K1 b - - 0 1",
+        "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1",
+        "2k5/4P3/8/8/8/8/1p4K1/8 w - - 0 1",
+        "r2qk2r/pb4pp/1n2Pb2/2B2Q2/p1p5/2P5/2B2PPP/RN2R1K1 w - - 1 0",
+    };
+
+    void init_tables()
+    {
+        static const bool done = []
+        {
+            MoveGen::initialize_bitboard_tables();
+            return true;
+        }();
+        (void)done;
+    }
+
+    std::vector<VBoard> positions()
+    {
+        init_tables();
+        std::vector<VBoard> boards(Fens.size());
+        for (size_t i = 0; i < Fens.size(); ++i)
+            boards[i].load_fen(Fens[i]);
+        return boards;
+    }
+
+    template <typename F>
+    decltype(auto) by_side(const Board &board, F &&f)
+    {
+        return board.get_side_to_move() == WHITE ? f.template operator()<WHITE>() : f.template operator()<BLACK>();
+    }
+
+    // Un SearchWorker par position, comme au début d'une recherche (heuristiques vides) ; partagé, lecture seule
+    struct WorkerSet
+    {
+        VBoard root;
+        EngineManager manager{root, 1};
+        TranspositionTable tt;
+        std::atomic<bool> stop{false};
+        std::atomic<long long> nodes{0};
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int time_limit = 0;
+        double lmr[64][64] = {};
+        std::vector<std::unique_ptr<SearchWorker>> workers;
+
+        WorkerSet()
+        {
+            tt.resize(1);
+            for (const VBoard &b : positions())
+                workers.push_back(std::make_unique<SearchWorker>(manager, b, tt, manager.get_tb(), stop, nodes, start, time_limit, lmr, 0));
+        }
+    };
+
+    WorkerSet &worker_set()
+    {
+        static WorkerSet set;
+        return set;
+    }
+}
+
+static void BM_PlayUnplay(benchmark::State &state)
+{
+    std::vector<VBoard> boards = positions();
+    std::vector<MoveList> legal(boards.size());
+    for (size_t i = 0; i < boards.size(); ++i)
+        MoveGen::generate_legal_moves(boards[i], legal[i]);
+
+    long long moves = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < boards.size(); ++i)
+        {
+            Board &b = boards[i];
+            for (int j = 0; j < legal[i].count; ++j)
+            {
+                b.play(legal[i][j]);
+                b.unplay(legal[i][j]);
+            }
+            moves += legal[i].count;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(moves);
+}
+BENCHMARK(BM_PlayUnplay);
+
+// Même chose avec la mise à jour incrémentale de l'éval (VBoard, chemin de la recherche)
+static void BM_PlayUnplayEval(benchmark::State &state)
+{
+    std::vector<VBoard> boards = positions();
+    std::vector<MoveList> legal(boards.size());
+    for (size_t i = 0; i < boards.size(); ++i)
+        MoveGen::generate_legal_moves(boards[i], legal[i]);
+
+    long long moves = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < boards.size(); ++i)
+        {
+            VBoard &b = boards[i];
+            for (int j = 0; j < legal[i].count; ++j)
+            {
+                b.play(legal[i][j]);
+                b.unplay(legal[i][j]);
+            }
+            moves += legal[i].count;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(moves);
+}
+BENCHMARK(BM_PlayUnplayEval);
+
+static void BM_MoveGenPseudoLegal(benchmark::State &state)
+{
+    std::vector<VBoard> boards = positions();
+    long long moves = 0;
+    for (auto _ : state)
+    {
+        for (VBoard &b : boards)
+        {
+            MoveList list;
+            by_side(b, [&]<Color Us>()
+                    { MoveGen::generate_pseudo_legal_moves<Us>(b, list); });
+            benchmark::DoNotOptimize(list.count);
+            moves += list.count;
+        }
+    }
+    state.SetItemsProcessed(moves);
+}
+BENCHMARK(BM_MoveGenPseudoLegal);
+
+static void BM_MoveGenCaptures(benchmark::State &state)
+{
+    const std::vector<VBoard> boards = positions();
+    long long moves = 0;
+    for (auto _ : state)
+    {
+        for (const VBoard &b : boards)
+        {
+            MoveList list;
+            by_side(b, [&]<Color Us>()
+                    { MoveGen::generate_pseudo_legal_captures<Us>(b, list); });
+            benchmark::DoNotOptimize(list.count);
+            moves += list.count;
+        }
+    }
+    state.SetItemsProcessed(moves);
+}
+BENCHMARK(BM_MoveGenCaptures);
+
+static void BM_MoveGenPromotions(benchmark::State &state)
+{
+    const std::vector<VBoard> boards = positions();
+    long long calls = 0;
+    for (auto _ : state)
+    {
+        for (const VBoard &b : boards)
+        {
+            MoveList list;
+            by_side(b, [&]<Color Us>()
+                    { MoveGen::generate_pseudo_legal_promotions<Us>(b, list); });
+            benchmark::DoNotOptimize(list.count);
+        }
+        calls += static_cast<long long>(boards.size());
+    }
+    state.SetItemsProcessed(calls);
+}
+BENCHMARK(BM_MoveGenPromotions);
+
+// Légalité de tous les coups pseudo-légaux (coups calmes et prises)
+static void BM_IsMoveLegal(benchmark::State &state)
+{
+    std::vector<VBoard> boards = positions();
+    std::vector<MoveList> pseudo(boards.size());
+    for (size_t i = 0; i < boards.size(); ++i)
+    {
+        VBoard &b = boards[i];
+        by_side(b, [&]<Color Us>()
+                {
+            MoveGen::generate_pseudo_legal_moves<Us>(b, pseudo[i]);
+            MoveGen::generate_pseudo_legal_captures<Us>(b, pseudo[i]); });
+    }
+
+    long long checks = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < boards.size(); ++i)
+        {
+            int legal = 0;
+            for (int j = 0; j < pseudo[i].count; ++j)
+                legal += boards[i].is_move_legal(pseudo[i][j]);
+            benchmark::DoNotOptimize(legal);
+            checks += pseudo[i].count;
+        }
+    }
+    state.SetItemsProcessed(checks);
+}
+BENCHMARK(BM_IsMoveLegal);
+
+// SEE de toutes les prises, avec les arguments passés par le MovePicker
+static void BM_SEE(benchmark::State &state)
+{
+    WorkerSet &set = worker_set();
+    std::vector<MoveList> captures(set.workers.size());
+    for (size_t i = 0; i < set.workers.size(); ++i)
+    {
+        const VBoard &b = set.workers[i]->get_board();
+        by_side(b, [&]<Color Us>()
+                { MoveGen::generate_pseudo_legal_captures<Us>(b, captures[i]); });
+    }
+
+    long long calls = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < set.workers.size(); ++i)
+        {
+            const SearchWorker &worker = *set.workers[i];
+            const MoveList &list = captures[i];
+            int sum = by_side(worker.board, [&]<Color Us>()
+                              {
+                int s = 0;
+                for (int j = 0; j < list.count; ++j)
+                {
+                    const Move m = list.moves[j];
+                    s += worker.see<Us>(m.get_to_sq(), static_cast<Piece>(m.get_to_piece()), static_cast<Piece>(m.get_from_piece()), m.get_from_sq());
+                }
+                return s; });
+            benchmark::DoNotOptimize(sum);
+            calls += list.count;
+        }
+    }
+    state.SetItemsProcessed(calls);
+}
+BENCHMARK(BM_SEE);
+
+static void BM_Eval(benchmark::State &state)
+{
+    const std::vector<VBoard> boards = positions();
+    for (auto _ : state)
+        for (const VBoard &b : boards)
+            benchmark::DoNotOptimize(Eval::eval(b, -engine_constants::eval::MateScore, engine_constants::eval::MateScore));
+    state.SetItemsProcessed(state.iterations() * static_cast<long long>(boards.size()));
+}
+BENCHMARK(BM_Eval);
+
+static void BM_LazyEval(benchmark::State &state)
+{
+    const std::vector<VBoard> boards = positions();
+    for (auto _ : state)
+        for (const VBoard &b : boards)
+            benchmark::DoNotOptimize(by_side(b, [&]<Color Us>()
+                                             { return Eval::lazy_eval_relative<Us>(b); }));
+    state.SetItemsProcessed(state.iterations() * static_cast<long long>(boards.size()));
+}
+BENCHMARK(BM_LazyEval);
+
+// Clés des positions atteintes en un coup : accès dispersés, comme en recherche
+static std::vector<std::uint64_t> tt_keys()
+{
+    std::vector<std::uint64_t> keys;
+    for (VBoard &b : positions())
+    {
+        MoveList list;
+        MoveGen::generate_legal_moves(b, list);
+        for (int j = 0; j < list.count; ++j)
+        {
+            b.play(list[j]);
+            keys.push_back(b.get_hash());
+            b.unplay(list[j]);
+        }
+    }
+    return keys;
+}
+
+// state.range(0) : taille de la TT en Mio (dans le cache ou non)
+static void BM_TTStore(benchmark::State &state)
+{
+    TranspositionTable tt;
+    tt.resize(static_cast<size_t>(state.range(0)));
+    const std::vector<std::uint64_t> keys = tt_keys();
+    int depth = 0;
+    for (auto _ : state)
+    {
+        for (const std::uint64_t key : keys)
+            tt.store(key, depth, 0, 17, TT_EXACT, Move(12, 28, PAWN));
+        depth = (depth + 1) & 31;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long long>(keys.size()));
+}
+BENCHMARK(BM_TTStore)->Arg(1)->Arg(64);
+
+static void BM_TTProbe(benchmark::State &state)
+{
+    TranspositionTable tt;
+    tt.resize(static_cast<size_t>(state.range(0)));
+    const std::vector<std::uint64_t> keys = tt_keys();
+    // Une clé sur deux présente
+    for (size_t i = 0; i < keys.size(); i += 2)
+        tt.store(keys[i], 8, 0, 17, TT_EXACT, Move(12, 28, PAWN));
+
+    for (auto _ : state)
+    {
+        int hits = 0;
+        for (const std::uint64_t key : keys)
+        {
+            int score;
+            Move move;
+            TTFlag flag;
+            hits += tt.probe(key, 4, 0, -100, 100, score, move, flag);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long long>(keys.size()));
+}
+BENCHMARK(BM_TTProbe)->Arg(1)->Arg(64);
+
+// Tous les coups d'un nœud dans l'ordre du MovePicker (génération par étapes, tri, SEE des prises)
+static void BM_MovePicker(benchmark::State &state)
+{
+    WorkerSet &set = worker_set();
+    long long moves = 0;
+    for (auto _ : state)
+    {
+        for (const std::unique_ptr<SearchWorker> &worker : set.workers)
+        {
+            VBoard &b = worker->get_board();
+            const int n = by_side(b, [&]<Color Us>()
+                                  {
+                CheckInfo check_info;
+                b.compute_check_info<Us>(check_info);
+                MovePicker picker(b, 0, 0, 0, 0, check_info);
+                int count = 0;
+                while (picker.pick_next<Us>(*worker).get_value() != 0)
+                    ++count;
+                return count; });
+            moves += n;
+        }
+    }
+    state.SetItemsProcessed(moves);
+}
+BENCHMARK(BM_MovePicker);
+
+BENCHMARK_MAIN();
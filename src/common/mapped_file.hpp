@@ -0,0 +1,123 @@
+#pragma once
+
+// Fichier en lecture seule projeté en mémoire (mmap), lu sans copie.
+// Les pages viennent du cache du noyau : plusieurs processus qui projettent le même fichier les partagent.
+// Sans mmap (Windows), le fichier est lu entièrement dans un tampon.
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CHESS26_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace file
+{
+    // Indication de parcours pour le noyau (lecture anticipée ou non)
+    enum class Access
+    {
+        Sequential,
+        Random
+    };
+
+    class MappedFile
+    {
+        const char *ptr = nullptr;
+        std::size_t length = 0;
+#ifdef CHESS26_HAS_MMAP
+        bool mapped = false;
+#endif
+        std::vector<char> buffer;
+
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+        MappedFile &operator=(MappedFile &&other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                ptr = std::exchange(other.ptr, nullptr);
+                length = std::exchange(other.length, 0);
+#ifdef CHESS26_HAS_MMAP
+                mapped = std::exchange(other.mapped, false);
+#endif
+                buffer = std::move(other.buffer);
+            }
+            return *this;
+        }
+
+        ~MappedFile() { close(); }
+
+        bool open(const std::string &path, Access access = Access::Sequential)
+        {
+            close();
+#ifdef CHESS26_HAS_MMAP
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+
+            struct stat st;
+            if (fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            length = static_cast<std::size_t>(st.st_size);
+            if (length > 0)
+            {
+                void *p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED)
+                {
+                    ::close(fd);
+                    length = 0;
+                    return false;
+                }
+                madvise(p, length, access == Access::Random ? MADV_RANDOM : MADV_SEQUENTIAL);
+                ptr = static_cast<const char *>(p);
+                mapped = true;
+            }
+            ::close(fd);
+            return true;
+#else
+            (void)access;
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open())
+                return false;
+            buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            ptr = buffer.data();
+            length = buffer.size();
+            return true;
+#endif
+        }
+
+        void close()
+        {
+#ifdef CHESS26_HAS_MMAP
+            if (mapped)
+                munmap(const_cast<char *>(ptr), length);
+            mapped = false;
+#endif
+            buffer.clear();
+            ptr = nullptr;
+            length = 0;
+        }
+
+        const char *data() const { return ptr; }
+        std::size_t size() const { return length; }
+        std::string_view view() const { return {ptr, length}; }
+    };
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+// Compteurs matériels Linux (perf_event_open) autour d'une mesure : cycles, instructions, erreurs de
+// prédiction de branchement, défauts L1d, LLC et dTLB. Espace utilisateur seulement (exclude_kernel),
+// ce que perf_event_paranoid <= 2 autorise pour son propre processus.
+// Les compteurs sont hérités : les threads créés pendant la mesure (workers de la recherche) sont comptés
+// une fois terminés. Un compteur que le noyau ou la machine refuse (VM, paranoid 3) est simplement absent.
+// Hors Linux, aucun compteur n'est disponible.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#define CHESS26_HAS_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace perf
+{
+    enum Counter
+    {
+        Cycles,
+        Instructions,
+        BranchMisses,
+        L1dMisses,
+        LlcMisses,
+        DtlbMisses,
+        CounterCount
+    };
+
+    inline const char *counter_name(Counter c)
+    {
+        static constexpr const char *names[] = {"cycles", "instructions", "branch-misses", "l1d-misses", "llc-misses", "dtlb-misses"};
+        return names[c];
+    }
+
+    struct Sample
+    {
+        std::array<std::uint64_t, CounterCount> values{};
+        std::array<bool, CounterCount> valid{};
+
+        bool any() const
+        {
+            for (const bool v : valid)
+                if (v)
+                    return true;
+            return false;
+        }
+    };
+
+    class Counters
+    {
+        std::array<int, CounterCount> fds;
+
+#ifdef CHESS26_HAS_PERF_EVENT
+        static int open_counter(std::uint32_t type, std::uint64_t config)
+        {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+        static constexpr std::uint64_t cache_miss(std::uint64_t cache)
+        {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+#endif
+
+        enum Op
+        {
+            Reset,
+            Enable,
+            Disable
+        };
+
+        void ioctl_all([[maybe_unused]] Op op)
+        {
+#ifdef CHESS26_HAS_PERF_EVENT
+            static constexpr unsigned long requests[] = {PERF_EVENT_IOC_RESET, PERF_EVENT_IOC_ENABLE, PERF_EVENT_IOC_DISABLE};
+            for (const int fd : fds)
+                if (fd >= 0)
+                    ioctl(fd, requests[op], 0);
+#endif
+        }
+
+    public:
+        Counters() { fds.fill(-1); }
+        ~Counters() { close(); }
+        Counters(const Counters &) = delete;
+        Counters &operator=(const Counters &) = delete;
+
+        // Vrai si au moins un compteur est ouvert
+        bool open()
+        {
+            close();
+#ifdef CHESS26_HAS_PERF_EVENT
+            fds[Cycles] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            fds[Instructions] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            fds[BranchMisses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+            fds[L1dMisses] = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D));
+            fds[LlcMisses] = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL));
+            fds[DtlbMisses] = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB));
+#endif
+            for (const int fd : fds)
+                if (fd >= 0)
+                    return true;
+            return false;
+        }
+
+        void close()
+        {
+#ifdef CHESS26_HAS_PERF_EVENT
+            for (int &fd : fds)
+                if (fd >= 0)
+                    ::close(fd);
+#endif
+            fds.fill(-1);
+        }
+
+        // Remise à zéro, puis enable/disable autour de chaque portion mesurée : les valeurs s'additionnent
+        void reset()
+        {
+            ioctl_all(Reset);
+        }
+
+        void enable()
+        {
+            ioctl_all(Enable);
+        }
+
+        void disable()
+        {
+            ioctl_all(Disable);
+        }
+
+        // Valeurs extrapolées si le noyau a multiplexé les compteurs
+        Sample read() const
+        {
+            Sample s;
+#ifdef CHESS26_HAS_PERF_EVENT
+            for (int c = 0; c < CounterCount; ++c)
+            {
+                std::uint64_t data[3]; // valeur, temps activé, temps compté
+                if (fds[c] < 0 || ::read(fds[c], data, sizeof(data)) != sizeof(data) || data[2] == 0)
+                    continue;
+                s.values[c] = data[2] < data[1] ? static_cast<std::uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]) : data[0];
+                s.valid[c] = true;
+            }
+#endif
+            return s;
+        }
+    };
+
+    // "info string perf ..." : totaux, puis IPC et valeurs par nœud
+    inline std::string format(const Sample &s, long long nodes)
+    {
+        std::ostringstream out;
+        out << "info string perf";
+        if (!s.any())
+            return out.str() + " unavailable";
+        for (int c = 0; c < CounterCount; ++c)
+            if (s.valid[c])
+                out << " " << counter_name(static_cast<Counter>(c)) << " " << s.values[c];
+
+        const double n = static_cast<double>(std::max(1LL, nodes));
+        out << std::fixed << std::setprecision(2);
+        out << "\ninfo string perf";
+        if (s.valid[Cycles] && s.valid[Instructions] && s.values[Cycles])
+            out << " ipc " << static_cast<double>(s.values[Instructions]) / s.values[Cycles];
+        for (int c = 0; c < CounterCount; ++c)
+            if (s.valid[c])
+                out << " " << counter_name(static_cast<Counter>(c)) << "/node " << s.values[c] / n;
+        return out.str();
+    }
+
+    // Objet JSON (totaux, ipc, valeurs par nœud), null sans compteur
+    inline std::string json(const Sample &s, long long nodes)
+    {
+        if (!s.any())
+            return "null";
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(4) << "{";
+        const char *sep = "";
+        const double n = static_cast<double>(std::max(1LL, nodes));
+        for (int c = 0; c < CounterCount; ++c)
+        {
+            if (!s.valid[c])
+                continue;
+            const char *name = counter_name(static_cast<Counter>(c));
+            out << sep << "\"" << name << "\":" << s.values[c] << ",\"" << name << "_per_node\":" << s.values[c] / n;
+            sep = ",";
+        }
+        if (s.valid[Cycles] && s.valid[Instructions] && s.values[Cycles])
+            out << ",\"ipc\":" << static_cast<double>(s.values[Instructions]) / s.values[Cycles];
+        out << "}";
+        return out.str();
+    }
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+// Pool de threads persistant pour les boucles parallèles courtes et répétées (tuning).
+// Chaque appel à run découpe [begin, end) en blocs de grain éléments, répartis en plages contiguës
+// entre les workers ; un worker qui a vidé sa plage vole la moitié haute de la plage d'un autre.
+// Le thread appelant participe comme worker 0. Un seul run à la fois.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool
+{
+    // Plage de blocs [lo, hi) d'un worker, 32 bits chacun, modifiée par CAS (propriétaire et voleurs)
+    struct alignas(64) Range
+    {
+        std::atomic<std::uint64_t> bounds{0};
+    };
+
+    using Task = void (*)(void *ctx, unsigned worker, std::size_t begin, std::size_t end);
+
+    std::vector<std::jthread> threads;
+    std::unique_ptr<Range[]> ranges;
+    unsigned count = 1;
+
+    // Travail courant, publié avant l'incrément de generation
+    Task task = nullptr;
+    void *task_ctx = nullptr;
+    std::size_t task_begin = 0, task_end = 0, task_grain = 1;
+
+    alignas(64) std::atomic<std::uint32_t> generation{0};
+    alignas(64) std::atomic<std::uint32_t> pending{0};
+    std::atomic<bool> quit{false};
+
+    static constexpr std::uint64_t pack(std::uint64_t lo, std::uint64_t hi) { return (hi << 32) | lo; }
+    static constexpr std::uint32_t lo_of(std::uint64_t v) { return static_cast<std::uint32_t>(v); }
+    static constexpr std::uint32_t hi_of(std::uint64_t v) { return static_cast<std::uint32_t>(v >> 32); }
+
+    bool pop_own(unsigned w, std::uint32_t &block)
+    {
+        std::uint64_t v = ranges[w].bounds.load(std::memory_order_relaxed);
+        while (lo_of(v) < hi_of(v))
+        {
+            if (ranges[w].bounds.compare_exchange_weak(v, pack(lo_of(v) + 1, hi_of(v)), std::memory_order_acq_rel))
+            {
+                block = lo_of(v);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Vole la moitié haute d'une plage ; garde le premier bloc volé et installe le reste chez w
+    bool steal(unsigned w, std::uint32_t &block)
+    {
+        for (unsigned k = 1; k < count; ++k)
+        {
+            Range &victim = ranges[(w + k) % count];
+            std::uint64_t v = victim.bounds.load(std::memory_order_relaxed);
+            while (lo_of(v) < hi_of(v))
+            {
+                const std::uint32_t mid = lo_of(v) + (hi_of(v) - lo_of(v)) / 2;
+                if (victim.bounds.compare_exchange_weak(v, pack(lo_of(v), mid), std::memory_order_acq_rel))
+                {
+                    block = mid;
+                    ranges[w].bounds.store(pack(mid + 1, hi_of(v)), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void work(unsigned w)
+    {
+        std::uint32_t block;
+        while (pop_own(w, block) || steal(w, block))
+        {
+            const std::size_t b = task_begin + static_cast<std::size_t>(block) * task_grain;
+            task(task_ctx, w, b, std::min(task_end, b + task_grain));
+        }
+    }
+
+    void worker_loop(unsigned w)
+    {
+        std::uint32_t seen = 0;
+        while (true)
+        {
+            generation.wait(seen, std::memory_order_acquire);
+            if (quit.load(std::memory_order_acquire))
+                return;
+            seen = generation.load(std::memory_order_acquire);
+
+            work(w);
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                pending.notify_one();
+        }
+    }
+
+public:
+    explicit ThreadPool(unsigned thread_count = std::thread::hardware_concurrency())
+    {
+        resize(thread_count);
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() { stop(); }
+
+    void resize(unsigned thread_count)
+    {
+        stop();
+        count = std::max(1u, thread_count);
+        ranges = std::make_unique<Range[]>(count);
+        quit.store(false);
+        generation.store(0);
+        for (unsigned w = 1; w < count; ++w)
+            threads.emplace_back([this, w]()
+                                 { worker_loop(w); });
+    }
+
+    unsigned size() const { return count; }
+
+    // f(worker, b, e) sur des blocs de grain éléments couvrant [begin, end) ; worker < size()
+    template <typename F>
+    void run(std::size_t begin, std::size_t end, std::size_t grain, F &&f)
+    {
+        if (begin >= end)
+            return;
+        grain = std::max<std::size_t>(1, grain);
+        const std::size_t blocks = (end - begin + grain - 1) / grain;
+
+        task = [](void *ctx, unsigned w, std::size_t b, std::size_t e)
+        { (*static_cast<std::remove_reference_t<F> *>(ctx))(w, b, e); };
+        task_ctx = const_cast<void *>(static_cast<const void *>(std::addressof(f)));
+        task_begin = begin;
+        task_end = end;
+        task_grain = grain;
+
+        // Un seul worker ou un seul bloc : pas de réveil
+        if (count == 1 || blocks == 1)
+        {
+            ranges[0].bounds.store(pack(0, blocks), std::memory_order_relaxed);
+            work(0);
+            return;
+        }
+
+        for (unsigned w = 0; w < count; ++w)
+            ranges[w].bounds.store(pack(blocks * w / count, blocks * (w + 1) / count), std::memory_order_relaxed);
+
+        pending.store(count - 1, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_release);
+        generation.notify_all();
+
+        work(0);
+
+        for (std::uint32_t p = pending.load(std::memory_order_acquire); p != 0; p = pending.load(std::memory_order_acquire))
+            pending.wait(p, std::memory_order_acquire);
+    }
+
+private:
+    void stop()
+    {
+        if (threads.empty())
+            return;
+        quit.store(true, std::memory_order_release);
+        generation.fetch_add(1, std::memory_order_release);
+        generation.notify_all();
+        threads.clear();
+    }
+};
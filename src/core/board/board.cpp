@@ -1,4 +1,5 @@
 #include "core/board/board.hpp"
+#include "core/board/cuckoo.hpp"
 #include "core/move/generator/move_generator.hpp"
 
 // clang-format off
@@ -212,6 +213,10 @@ void Board::unplay(const Move move)
 }
 bool Board::is_repetition() const
 {
+    // Filtre O(1) : la plupart des noeuds n'ont aucune clé identique dans l'historique
+    if (!get_history()->may_contain(zobrist_key))
+        return false;
+
     const int n = (int)get_history()->size();
     // On recule de 2 en 2 car la répétition doit être au même trait
     // On s'arrête au dernier coup irréversible
@@ -225,6 +230,40 @@ bool Board::is_repetition() const
     return false;
 }
 
+bool Board::has_upcoming_repetition(int ply) const
+{
+    const History &h = *get_history();
+    const int n = (int)h.size();
+    const int end = std::min<int>(state.halfmove_clock, n - state.last_irreversible_index);
+    if (end < 3)
+        return false;
+
+    // Un coup réversible du camp au trait suffit à revenir à une position déjà vue (même trait : i impair)
+    for (int i = 3; i <= end; i += 2)
+    {
+        const U64 move_key = zobrist_key ^ h[n - i].zobrist_key;
+
+        int slot = Cuckoo::h1(move_key);
+        if (Cuckoo::keys[slot] != move_key)
+        {
+            slot = Cuckoo::h2(move_key);
+            if (Cuckoo::keys[slot] != move_key)
+                continue;
+        }
+
+        const Move move = Cuckoo::moves[slot];
+        const int s1 = move.get_from_sq();
+        const int s2 = move.get_to_sq();
+        if (occupancies[NO_COLOR] & MoveGen::BetweenMasks[s1][s2])
+            continue;
+
+        // La répétition doit tomber à l'intérieur de l'arbre : avant la racine il faudrait une 3e occurrence
+        if (ply > i)
+            return true;
+    }
+    return false;
+}
+
 template void Board::play<WHITE>(const Move move);
 template void Board::play<BLACK>(const Move move);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <expected>
 #include <cstdint>
 #include <array>
@@ -12,6 +13,8 @@
 #include "core/move/history.hpp"
 #include "core/move/move_list.hpp"
 #include "core/board/zobrist.hpp"
+#include "core/board/position.hpp"
+#include "core/board/packed_position.hpp"
 
 enum CastlingRights : std::uint8_t
 {
@@ -22,6 +25,15 @@ enum CastlingRights : std::uint8_t
     ALL_CASTLING = 0b1111     // 15
 };
 
+// Cases depuis lesquelles chaque type de pièce donne échec au roi adverse,
+// calculées une fois par nœud pour tester les coups sans les jouer
+struct CheckInfo
+{
+    U64 check_sq[constants::PieceTypeCount];
+    U64 dc_blockers; // Nos pièces dont le départ découvre un échec
+    int king_sq;
+};
+
 class Board
 {
 private:
@@ -68,12 +80,12 @@ public:
     // Rule of five
     Board()
     {
-        History *raw = new History();
+        History *raw = HistoryArena::acquire();
         history_tagged = reinterpret_cast<History *>(
             reinterpret_cast<uintptr_t>(raw) | 1ULL);
     }
 
-    // 1. Copy
+    // 1. Copy (only the history window still needed by the search is copied)
     Board(const Board &other)
     {
         std::memcpy(occupancies, other.occupancies, sizeof(occupancies));
@@ -83,7 +95,8 @@ public:
         zobrist_key = other.zobrist_key;
         std::memcpy(king_sq, other.king_sq, sizeof(king_sq));
 
-        History *raw_copy = new History(*other.get_history());
+        History *raw_copy = HistoryArena::acquire();
+        raw_copy->copy_tail_from(*other.get_history(), other.history_window_start());
         history_tagged = reinterpret_cast<History *>(
             reinterpret_cast<uintptr_t>(raw_copy) | 1ULL);
     }
@@ -92,9 +105,9 @@ public:
     {
         if (this != &other)
         {
-            if (history_tagged && owns_history())
-                delete get_history();
-            History *raw_copy = new History(*other.get_history());
+            // On réutilise notre bloc s'il nous appartient déjà
+            History *raw_copy = (history_tagged && owns_history()) ? get_history() : HistoryArena::acquire();
+            raw_copy->copy_tail_from(*other.get_history(), other.history_window_start());
             std::memcpy(occupancies, other.occupancies, sizeof(occupancies));
             std::memcpy(&state, &other.state, sizeof(state));
             std::memcpy(king_sq, other.king_sq, sizeof(king_sq));
@@ -113,13 +126,14 @@ public:
     {
         if (history_tagged && owns_history())
         {
-            delete get_history();
+            HistoryArena::release(get_history());
         }
     }
 
     // 4. Move
     Board(Board &&other) noexcept : history_tagged(other.history_tagged)
     {
+        copy_position_from(other);
         other.history_tagged = nullptr;
     }
     // 5. Affectation & move operator
@@ -128,14 +142,41 @@ public:
         if (this != &other)
         {
             if (history_tagged && owns_history())
-                delete get_history();
+                HistoryArena::release(get_history());
+            copy_position_from(other);
             history_tagged = other.history_tagged;
             other.history_tagged = nullptr;
         }
         return *this;
     }
+
+    // Position seule (sans l'historique), pour les déplacements
+    inline void copy_position_from(const Board &other)
+    {
+        std::memcpy(occupancies, other.occupancies, sizeof(occupancies));
+        std::memcpy(&state, &other.state, sizeof(state));
+        pieces_occ = other.pieces_occ;
+        std::memcpy(mailbox, other.mailbox, sizeof(mailbox));
+        zobrist_key = other.zobrist_key;
+        std::memcpy(king_sq, other.king_sq, sizeof(king_sq));
+    }
+
+    // First history index a copy still needs : repetitions only look back to the
+    // last irreversible move, and move ordering reads the last two moves
+    inline size_t history_window_start() const
+    {
+        const size_t n = get_history()->size();
+        const size_t last_moves = n >= 2 ? n - 2 : 0;
+        const size_t irreversible = static_cast<size_t>(std::max(0, state.last_irreversible_index));
+        return std::min(irreversible, last_moves);
+    }
     bool load_fen(const std::string_view fen_string);
 
+    // Encodage binaire de 32 octets (packed_position.hpp), sans passer par une FEN.
+    // pack laisse score, result et ply à l'appelant ; unpack refuse un enregistrement incohérent.
+    void pack(PackedPosition &out) const;
+    bool unpack(const PackedPosition &in);
+
     inline static std::expected<Move, Move::MoveError> parse_move_uci(std::string_view uci, const Board &board)
     {
         if (uci.length() < 4 || uci.length() > 5)
@@ -150,8 +191,37 @@ public:
             to_f < 0 || to_f > 7 || to_r < 0 || to_r > 7)
             return std::unexpected(Move::MoveError::SquareOutOfBounds);
 
-        int from_sq = from_r * 8 + from_f;
-        int to_sq = to_r * 8 + to_f;
+        Piece prom_piece = NO_PIECE;
+        if (uci.length() == 5)
+        {
+            switch (uci[4])
+            {
+            case 'q':
+                prom_piece = QUEEN;
+                break;
+            case 'r':
+                prom_piece = ROOK;
+                break;
+            case 'b':
+                prom_piece = BISHOP;
+                break;
+            case 'n':
+                prom_piece = KNIGHT;
+                break;
+            default:
+                return std::unexpected(Move::MoveError::InvalidFormat);
+            }
+        }
+
+        return move_from_squares(from_r * 8 + from_f, to_r * 8 + to_f, prom_piece, board);
+    }
+
+    // Coup complet (drapeaux, pièces) à partir des cases, par lecture du mailbox : pas de génération de coups.
+    // Le coup n'est pas vérifié : is_move_pseudo_legal / is_move_legal restent à la charge de l'appelant.
+    inline static std::expected<Move, Move::MoveError> move_from_squares(int from_sq, int to_sq, Piece prom_piece, const Board &board)
+    {
+        const int from_f = from_sq & 7, from_r = from_sq >> 3;
+        const int to_f = to_sq & 7, to_r = to_sq >> 3;
 
         Piece from_piece = board.get_p(from_sq);
         if (from_piece == NO_PIECE)
@@ -181,29 +251,11 @@ public:
             to_piece = PAWN; // La pièce capturée est un pion
         }
 
-        // 4. Promotion
-        Piece prom_piece = NO_PIECE;
-        if (uci.length() == 5)
-        {
+        // 4. Promotion (sans promotion, le champ garde la valeur par défaut du générateur)
+        if (prom_piece != NO_PIECE)
             flags = Move::Flags::PROMOTION_MASK;
-            switch (uci[4])
-            {
-            case 'q':
-                prom_piece = QUEEN;
-                break;
-            case 'r':
-                prom_piece = ROOK;
-                break;
-            case 'b':
-                prom_piece = BISHOP;
-                break;
-            case 'n':
-                prom_piece = KNIGHT;
-                break;
-            default:
-                return std::unexpected(Move::MoveError::InvalidFormat);
-            }
-        }
+        else
+            prom_piece = QUEEN;
 
         return Move(from_sq, to_sq, from_piece, flags, to_piece, prom_piece);
     }
@@ -212,7 +264,7 @@ public:
     {
         if (history_tagged && owns_history())
         {
-            delete get_history();
+            HistoryArena::release(get_history());
         }
         history_tagged = h;
     }
@@ -346,6 +398,47 @@ public:
         }
         return play<BLACK>(move);
     }
+    // Copy-make : sauvegarde compacte avant play, restauration à la place de unplay
+    FORCE_INLINE void save_position(Position &p) const
+    {
+        for (int t = PAWN; t <= KING; ++t)
+            p.by_type[t] = pieces_occ[t] | pieces_occ[t + constants::PieceTypeCount];
+        p.by_color[WHITE] = occupancies[WHITE];
+        p.by_color[BLACK] = occupancies[BLACK];
+        p.zobrist_key = zobrist_key;
+        p.last_irreversible_index = state.last_irreversible_index;
+        p.halfmove_clock = state.halfmove_clock;
+        p.castling_rights = state.castling_rights;
+        p.en_passant_sq = state.en_passant_sq;
+        p.side_to_move = state.side_to_move;
+        p.king_sq[WHITE] = king_sq[WHITE];
+        p.king_sq[BLACK] = king_sq[BLACK];
+        std::memcpy(p.mailbox, mailbox, sizeof(mailbox));
+    }
+
+    // Restores a snapshot taken just before the last play() and drops its UndoInfo
+    FORCE_INLINE void restore_position(const Position &p)
+    {
+        for (int t = PAWN; t <= KING; ++t)
+        {
+            pieces_occ[t] = p.by_type[t] & p.by_color[WHITE];
+            pieces_occ[t + constants::PieceTypeCount] = p.by_type[t] & p.by_color[BLACK];
+        }
+        occupancies[WHITE] = p.by_color[WHITE];
+        occupancies[BLACK] = p.by_color[BLACK];
+        occupancies[NO_COLOR] = p.by_color[WHITE] | p.by_color[BLACK];
+        zobrist_key = p.zobrist_key;
+        state.last_irreversible_index = p.last_irreversible_index;
+        state.halfmove_clock = p.halfmove_clock;
+        state.castling_rights = p.castling_rights;
+        state.en_passant_sq = p.en_passant_sq;
+        state.side_to_move = static_cast<Color>(p.side_to_move);
+        king_sq[WHITE] = p.king_sq[WHITE];
+        king_sq[BLACK] = p.king_sq[BLACK];
+        std::memcpy(mailbox, p.mailbox, sizeof(mailbox));
+        get_history()->pop_back();
+    }
+
     template <Color Us>
     bool is_move_legal(const Move move);
     inline bool is_move_legal(const Move move)
@@ -355,6 +448,27 @@ public:
             return is_move_legal<WHITE>(move);
         return is_move_legal<BLACK>(move);
     };
+    template <Color Us>
+    void compute_check_info(CheckInfo &ci) const;
+
+    // Assumes a pseudo-legal move for the side to move
+    template <Color Us>
+    bool gives_check(const Move move, const CheckInfo &ci) const;
+
+    template <Color Us>
+    inline bool gives_check(const Move move) const
+    {
+        CheckInfo ci;
+        compute_check_info<Us>(ci);
+        return gives_check<Us>(move, ci);
+    }
+    inline bool gives_check(const Move move) const
+    {
+        if (state.side_to_move == WHITE)
+            return gives_check<WHITE>(move);
+        return gives_check<BLACK>(move);
+    }
+
     void compute_full_hash();
     char piece_to_char(Color color, Piece type) const;
     void show() const;
@@ -383,6 +497,9 @@ public:
 
     bool is_repetition() const;
 
+    // Un coup réversible du camp au trait mène-t-il à une répétition à l'intérieur de l'arbre ? (ply = distance à la racine)
+    bool has_upcoming_repetition(int ply) const;
+
     bool is_move_pseudo_legal(const Move &move) const;
 
     inline std::uint8_t get_castling_rights() const
@@ -399,8 +516,12 @@ public:
         return zobrist_key;
     }
 
-    inline void play_null_move(int &stored_ep_sq)
+    // Le coup nul n'entre pas dans l'historique : on coupe la fenêtre de répétition à cet endroit
+    inline void play_null_move(int &stored_ep_sq, int &stored_irreversible)
     {
+        stored_irreversible = state.last_irreversible_index;
+        state.last_irreversible_index = (int)get_history()->size();
+
         if (state.en_passant_sq != constants::EnPassantSqNone)
             zobrist_key ^= zobrist_en_passant[state.en_passant_sq % 8];
         else
@@ -411,9 +532,10 @@ public:
 
         switch_trait();
     }
-    inline void unplay_null_move(int stored_ep_sq)
+    inline void unplay_null_move(int stored_ep_sq, int stored_irreversible)
     {
         switch_trait();
+        state.last_irreversible_index = stored_irreversible;
         zobrist_key ^= zobrist_en_passant[8];
         state.en_passant_sq = stored_ep_sq;
         if (state.en_passant_sq != constants::EnPassantSqNone)
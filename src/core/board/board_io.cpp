@@ -1,5 +1,7 @@
 #include "core/board/board.hpp"
 
+#include <bit>
+#include <cstring>
 #include <sstream>
 
 #include "common/logger.hpp"
@@ -107,6 +109,63 @@ bool Board::load_fen(const std::string_view fen_string)
     return true;
 }
 
+void Board::pack(PackedPosition &out) const
+{
+    out.occupancy = occupancies[NO_COLOR];
+    std::memset(out.pieces, 0, sizeof(out.pieces));
+
+    U64 occ = out.occupancy;
+    for (int i = 0; occ; ++i)
+    {
+        const int sq = cpu::pop_lsb(occ);
+        const std::uint8_t nibble = static_cast<std::uint8_t>((get_c(sq) << 3) | get_p(sq));
+        out.pieces[i >> 1] |= nibble << ((i & 1) * 4);
+    }
+
+    out.stm_castling = static_cast<std::uint8_t>((state.side_to_move == BLACK ? 0x80 : 0) | state.castling_rights);
+    out.en_passant_sq = state.en_passant_sq;
+    out.halfmove_clock = static_cast<std::uint8_t>(std::min<int>(state.halfmove_clock, 255));
+}
+
+bool Board::unpack(const PackedPosition &in)
+{
+    clear();
+
+    if (std::popcount(in.occupancy) > 32)
+        return false;
+
+    int kings[2] = {0, 0};
+    U64 occ = in.occupancy;
+    for (int i = 0; occ; ++i)
+    {
+        const int sq = cpu::pop_lsb(occ);
+        const std::uint8_t nibble = (in.pieces[i >> 1] >> ((i & 1) * 4)) & 0x0F;
+        const Color color = static_cast<Color>(nibble >> 3);
+        const Piece type = static_cast<Piece>(nibble & PIECE_MASK);
+        if (type > KING)
+            return false;
+
+        if (type == KING)
+        {
+            king_sq[color] = sq;
+            ++kings[color];
+        }
+        mailbox[sq] = (color << COLOR_SHIFT) | type;
+        update_square_bitboard(color, type, sq, true);
+    }
+    if (kings[WHITE] != 1 || kings[BLACK] != 1)
+        return false;
+
+    state.side_to_move = (in.stm_castling & 0x80) ? BLACK : WHITE;
+    state.castling_rights = in.stm_castling & ALL_CASTLING;
+    state.en_passant_sq = (in.en_passant_sq < constants::BoardSize) ? in.en_passant_sq : constants::EnPassantSqNone;
+    state.halfmove_clock = in.halfmove_clock;
+
+    update_occupancy();
+    compute_full_hash();
+    return true;
+}
+
 void Board::compute_full_hash()
 {
     zobrist_key = 0;
@@ -114,8 +114,111 @@ bool Board::is_move_legal(const Move move)
     return legal;
 }
 
+template <Color Us>
+void Board::compute_check_info(CheckInfo &ci) const
+{
+    constexpr Color them = (Color)!Us;
+    const int ksq = king_sq[them];
+    const U64 occupied = occupancies[NO_COLOR];
+
+    ci.king_sq = ksq;
+    ci.check_sq[PAWN] = (Us == WHITE) ? MoveGen::PawnAttacksBlack[ksq] : MoveGen::PawnAttacksWhite[ksq];
+    ci.check_sq[KNIGHT] = MoveGen::KnightAttacks[ksq];
+    ci.check_sq[BISHOP] = MoveGen::generate_bishop_moves(ksq, occupied);
+    ci.check_sq[ROOK] = MoveGen::generate_rook_moves(ksq, occupied);
+    ci.check_sq[QUEEN] = ci.check_sq[BISHOP] | ci.check_sq[ROOK];
+    ci.check_sq[KING] = 0ULL;
+
+    // Nos sliders alignés avec le roi adverse (à travers un seul bloqueur qui nous appartient)
+    const U64 queens = get_piece_bitboard<Us, QUEEN>();
+    U64 snipers = (MoveGen::generate_bishop_moves(ksq, 0ULL) & (get_piece_bitboard<Us, BISHOP>() | queens)) |
+                  (MoveGen::generate_rook_moves(ksq, 0ULL) & (get_piece_bitboard<Us, ROOK>() | queens));
+
+    ci.dc_blockers = 0ULL;
+    while (snipers)
+    {
+        const int sq = cpu::pop_lsb(snipers);
+        const U64 between = MoveGen::BetweenMasks[ksq][sq] & occupied;
+        if (between && !(between & (between - 1)) && (between & occupancies[Us]))
+            ci.dc_blockers |= between;
+    }
+}
+
+template <Color Us>
+bool Board::gives_check(const Move move, const CheckInfo &ci) const
+{
+    const int from_sq = move.get_from_sq();
+    const int to_sq = move.get_to_sq();
+    const Piece from_piece = move.get_from_piece();
+    const uint32_t flags = move.get_flags();
+
+    const U64 from_mask = 1ULL << from_sq;
+    const U64 to_mask = 1ULL << to_sq;
+    const U64 ksq_mask = 1ULL << ci.king_sq;
+
+    // 1. Échec direct
+    if (flags != Move::Flags::PROMOTION_MASK && (ci.check_sq[from_piece] & to_mask))
+        return true;
+
+    // 2. Échec à la découverte (la pièce quitte la ligne roi - slider)
+    if ((ci.dc_blockers & from_mask) && !move.is_castling() &&
+        !(MoveGen::BetweenMasks[ci.king_sq][to_sq] & from_mask) &&
+        !(MoveGen::BetweenMasks[from_sq][ci.king_sq] & to_mask))
+        return true;
+
+    if (!flags) [[likely]]
+        return false;
+
+    // 3. Cas spéciaux : l'occupation change au-delà de from / to
+    const U64 queens = get_piece_bitboard<Us, QUEEN>();
+    switch (flags)
+    {
+    case Move::Flags::PROMOTION_MASK:
+    {
+        const U64 occupied = occupancies[NO_COLOR] ^ from_mask;
+        switch (move.get_promo_piece())
+        {
+        case KNIGHT:
+            return MoveGen::KnightAttacks[to_sq] & ksq_mask;
+        case BISHOP:
+            return MoveGen::generate_bishop_moves(to_sq, occupied) & ksq_mask;
+        case ROOK:
+            return MoveGen::generate_rook_moves(to_sq, occupied) & ksq_mask;
+        default:
+            return (MoveGen::generate_bishop_moves(to_sq, occupied) | MoveGen::generate_rook_moves(to_sq, occupied)) & ksq_mask;
+        }
+    }
+    case Move::Flags::EN_PASSANT_CAP:
+    {
+        const int cap_sq = (Us == WHITE) ? to_sq - 8 : to_sq + 8;
+        const U64 occupied = (occupancies[NO_COLOR] ^ from_mask ^ (1ULL << cap_sq)) | to_mask;
+        return (MoveGen::generate_bishop_moves(ci.king_sq, occupied) & (get_piece_bitboard<Us, BISHOP>() | queens)) |
+               (MoveGen::generate_rook_moves(ci.king_sq, occupied) & (get_piece_bitboard<Us, ROOK>() | queens));
+    }
+    case Move::Flags::KING_CASTLE:
+    case Move::Flags::QUEEN_CASTLE:
+    {
+        const bool is_ks = (flags == Move::Flags::KING_CASTLE);
+        const int r_f = is_ks ? (Us == WHITE ? 7 : 63) : (Us == WHITE ? 0 : 56);
+        const int r_t = is_ks ? (Us == WHITE ? 5 : 61) : (Us == WHITE ? 3 : 59);
+        const U64 occupied = (occupancies[NO_COLOR] ^ from_mask ^ (1ULL << r_f)) | to_mask | (1ULL << r_t);
+        const U64 rooks = (get_piece_bitboard<Us, ROOK>() ^ (1ULL << r_f)) | (1ULL << r_t);
+        return (MoveGen::generate_bishop_moves(ci.king_sq, occupied) & (get_piece_bitboard<Us, BISHOP>() | queens)) |
+               (MoveGen::generate_rook_moves(ci.king_sq, occupied) & (rooks | queens));
+    }
+    default:
+        return false;
+    }
+}
+
 template bool Board::is_attacked<WHITE>(int sq) const;
 template bool Board::is_attacked<BLACK>(int sq) const;
 
 template bool Board::is_move_legal<WHITE>(const Move move);
-template bool Board::is_move_legal<BLACK>(const Move move);
\ No newline at end of file
+template bool Board::is_move_legal<BLACK>(const Move move);
+
+template void Board::compute_check_info<WHITE>(CheckInfo &ci) const;
+template void Board::compute_check_info<BLACK>(CheckInfo &ci) const;
+
+template bool Board::gives_check<WHITE>(const Move move, const CheckInfo &ci) const;
+template bool Board::gives_check<BLACK>(const Move move, const CheckInfo &ci) const;
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "core/board/cuckoo.hpp"
+
+#include <utility>
+
+#include "common/fatal.hpp"
+#include "common/logger.hpp"
+#include "core/board/zobrist.hpp"
+#include "core/move/generator/move_generator.hpp"
+
+namespace Cuckoo
+{
+    std::array<U64, Size> keys;
+    std::array<Move, Size> moves;
+}
+
+static U64 empty_board_attacks(Piece p, int sq)
+{
+    switch (p)
+    {
+    case KNIGHT:
+        return MoveGen::KnightAttacks[sq];
+    case BISHOP:
+        return MoveGen::generate_bishop_moves(sq, 0ULL);
+    case ROOK:
+        return MoveGen::generate_rook_moves(sq, 0ULL);
+    case QUEEN:
+        return MoveGen::generate_bishop_moves(sq, 0ULL) | MoveGen::generate_rook_moves(sq, 0ULL);
+    case KING:
+        return MoveGen::KingAttacks[sq];
+    default:
+        return 0ULL;
+    }
+}
+
+void Cuckoo::init()
+{
+    keys.fill(0ULL);
+    moves.fill(Move(0u));
+
+    int count = 0;
+    for (int c = WHITE; c <= BLACK; ++c)
+    {
+        for (int p = KNIGHT; p <= KING; ++p)
+        {
+            const int zobrist_index = c * constants::PieceTypeCount + p;
+            for (int s1 = 0; s1 < constants::BoardSize; ++s1)
+            {
+                for (int s2 = s1 + 1; s2 < constants::BoardSize; ++s2)
+                {
+                    if (!(empty_board_attacks(static_cast<Piece>(p), s1) & (1ULL << s2)))
+                        continue;
+
+                    Move move(s1, s2, static_cast<Piece>(p));
+                    U64 key = zobrist_table[zobrist_index][s1] ^ zobrist_table[zobrist_index][s2] ^ zobrist_side_to_move;
+
+                    // Insertion cuckoo : on déloge l'occupant vers son autre case jusqu'à trouver une place vide
+                    int i = h1(key);
+                    while (true)
+                    {
+                        std::swap(keys[i], key);
+                        std::swap(moves[i], move);
+                        if (move.get_value() == 0)
+                            break;
+                        i = (i == h1(key)) ? h2(key) : h1(key);
+                    }
+                    ++count;
+                }
+            }
+        }
+    }
+
+    if (count != 3668)
+        FATAL("Cuckoo table initialization failed");
+
+    logs::debug << "Cuckoo table initialized (" << count << " reversible moves)." << std::endl;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <array>
+
+#include "common/mask.hpp"
+#include "core/move/move.hpp"
+
+// Cuckoo table of reversible moves (Marcel van Kervinck's upcoming-repetition detection) :
+// every key is zobrist(piece, from) ^ zobrist(piece, to) ^ zobrist_side_to_move,
+// so a match between the current key and an older one means a single reversible move joins them.
+namespace Cuckoo
+{
+    constexpr int Size = 8192;
+
+    extern std::array<U64, Size> keys;
+    extern std::array<Move, Size> moves;
+
+    inline int h1(U64 key) { return static_cast<int>(key & (Size - 1)); }
+    inline int h2(U64 key) { return static_cast<int>((key >> 16) & (Size - 1)); }
+
+    // Needs the zobrist keys and the attack tables
+    void init();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/constants.hpp"
+#include "common/mask.hpp"
+
+// Fixed-size (32 bytes) position record for training data and batch analysis.
+// Pieces are listed in occupancy order (LSB first), one nibble each : color << 3 | piece.
+// Board::pack / Board::unpack convert without going through a FEN string.
+struct PackedPosition
+{
+    static constexpr std::int16_t NoScore = INT16_MIN;
+
+    // Résultat du point de vue des blancs
+    enum Result : std::uint8_t
+    {
+        BlackWin = 0,
+        Draw = 1,
+        WhiteWin = 2,
+        Unknown = 3
+    };
+
+    U64 occupancy;
+    std::uint8_t pieces[16];       // Nibble bas = pièce de rang pair dans l'occupation
+    std::int16_t score = NoScore;  // Centipions, point de vue des blancs
+    std::uint8_t result = Unknown;
+    std::uint8_t stm_castling;     // bit 7 : trait aux noirs, bits 0-3 : droits de roque
+    std::uint8_t en_passant_sq;    // constants::EnPassantSqNone si aucune
+    std::uint8_t halfmove_clock;   // Saturé à 255
+    std::uint16_t ply = 0;         // Demi-coups depuis le début de la partie, 0 si inconnu
+
+    static constexpr Result result_from_white_score(double r)
+    {
+        return r > 0.75 ? WhiteWin : (r < 0.25 ? BlackWin : Draw);
+    }
+
+    double white_score() const
+    {
+        return result == WhiteWin ? 1.0 : (result == BlackWin ? 0.0 : 0.5);
+    }
+};
+
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition must stay 32 bytes");
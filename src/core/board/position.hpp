@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/constants.hpp"
+#include "common/mask.hpp"
+
+// Compact snapshot of a Board used by the copy-make search mode (one per ply).
+// Pieces are stored by type + by color (8 bitboards instead of 12 + 3),
+// Board::restore_position rebuilds the per-color bitboards from them.
+struct Position
+{
+    U64 by_type[constants::PieceTypeCount];
+    U64 by_color[2];
+    U64 zobrist_key;
+    int last_irreversible_index;
+    std::uint16_t halfmove_clock;
+    std::uint8_t castling_rights;
+    std::uint8_t en_passant_sq;
+    std::uint8_t side_to_move;
+    std::uint8_t king_sq[2];
+    std::uint8_t mailbox[constants::BoardSize];
+};
+
+static_assert(sizeof(Position) <= 160, "Position must stay compact");
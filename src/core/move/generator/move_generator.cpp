@@ -1,6 +1,7 @@
 #include "move_generator.hpp"
 
 #include "common/logger.hpp"
+#include "core/board/cuckoo.hpp"
 namespace MoveGen
 {
     alignas(64) std::array<U64, constants::BoardSize> KnightAttacks;
@@ -13,6 +14,7 @@ namespace MoveGen
     alignas(64) std::array<U64, constants::BoardSize> PawnPushBlack;
     alignas(64) std::array<U64, constants::BoardSize> PawnPush2White;
     alignas(64) std::array<U64, constants::BoardSize> PawnPush2Black;
+    alignas(64) std::array<std::array<U64, constants::BoardSize>, constants::BoardSize> BetweenMasks;
 
 #ifdef __BMI2__
     alignas(64) std::array<MagicPEXT, constants::BoardSize> RookMagics;
@@ -186,6 +188,21 @@ void MoveGen::initialize_bitboard_tables()
     MoveGen::initialize_bishop_masks();
     MoveGen::initialize_pawn_masks();
 
+    for (int a = 0; a < constants::BoardSize; ++a)
+    {
+        for (int b = 0; b < constants::BoardSize; ++b)
+        {
+            const U64 a_mask = core::mask::sq_mask(a);
+            const U64 b_mask = core::mask::sq_mask(b);
+            U64 between = 0ULL;
+            if (generate_sliding_attack(a, 0ULL, true) & b_mask)
+                between = generate_sliding_attack(a, b_mask, true) & generate_sliding_attack(b, a_mask, true);
+            else if (generate_sliding_attack(a, 0ULL, false) & b_mask)
+                between = generate_sliding_attack(a, b_mask, false) & generate_sliding_attack(b, a_mask, false);
+            BetweenMasks[a][b] = between;
+        }
+    }
+
     logs::debug << "Bitboard tables initialized." << std::endl;
 }
 void MoveGen::generate_pawn_moves(Board &board, const Color color, MoveList &list)
@@ -710,6 +727,7 @@ static bool perform_initial_data_loading()
 #endif
 
     init_zobrist();
+    Cuckoo::init();
 
     logs::debug << "--- All U64 tables loaded successfully ! ---" << std::endl;
     return true;
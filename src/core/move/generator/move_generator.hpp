@@ -26,6 +26,8 @@ namespace MoveGen
     alignas(64) extern std::array<U64, constants::BoardSize> PawnPushBlack;
     alignas(64) extern std::array<U64, constants::BoardSize> PawnPush2White;
     alignas(64) extern std::array<U64, constants::BoardSize> PawnPush2Black;
+    // Cases strictement entre deux cases alignées (0 sinon)
+    alignas(64) extern std::array<std::array<U64, constants::BoardSize>, constants::BoardSize> BetweenMasks;
 
 #ifdef __BMI2__
     struct MagicPEXT
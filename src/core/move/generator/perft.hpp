@@ -0,0 +1,61 @@
+#pragma once
+
+#include "core/board/board.hpp"
+#include "core/board/position.hpp"
+#include "core/move/generator/move_generator.hpp"
+
+namespace MoveGen
+{
+    // Perft with make / unmake (bulk counting on the last ply)
+    template <Color Us>
+    U64 perft(Board &board, int depth)
+    {
+        MoveList list;
+        generate_legal_moves<Us>(board, list);
+        if (depth <= 1)
+            return list.count;
+
+        U64 nodes = 0;
+        for (int i = 0; i < list.count; ++i)
+        {
+            board.play<Us>(list[i]);
+            nodes += perft<!Us>(board, depth - 1);
+            board.unplay<Us>(list[i]);
+        }
+        return nodes;
+    }
+
+    // Perft with copy-make : `stack` must hold at least `depth` positions
+    template <Color Us>
+    U64 perft_copy_make(Board &board, int depth, Position *stack)
+    {
+        MoveList list;
+        generate_legal_moves<Us>(board, list);
+        if (depth <= 1)
+            return list.count;
+
+        U64 nodes = 0;
+        board.save_position(*stack);
+        for (int i = 0; i < list.count; ++i)
+        {
+            board.play<Us>(list[i]);
+            nodes += perft_copy_make<!Us>(board, depth - 1, stack + 1);
+            board.restore_position(*stack);
+        }
+        return nodes;
+    }
+
+    inline U64 perft(Board &board, int depth)
+    {
+        if (board.get_side_to_move() == WHITE)
+            return perft<WHITE>(board, depth);
+        return perft<BLACK>(board, depth);
+    }
+
+    inline U64 perft_copy_make(Board &board, int depth, Position *stack)
+    {
+        if (board.get_side_to_move() == WHITE)
+            return perft_copy_make<WHITE>(board, depth, stack);
+        return perft_copy_make<BLACK>(board, depth, stack);
+    }
+}
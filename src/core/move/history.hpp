@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cassert>
+#include <cstring>
+#include <mutex>
+#include <vector>
 
 #include "common/constants.hpp"
 #include "common/mask.hpp"
@@ -18,17 +21,35 @@ struct alignas(16) UndoInfo
 
 struct History
 {
+    static constexpr size_t KeyFilterSize = 1024;
+
     UndoInfo list[constants::MaxHistorySize];
     size_t count = 0;
 
+    // Compteurs des clés présentes, indexés par les bits bas : un zéro garantit qu'aucune entrée n'a cette clé
+    uint8_t key_filter[KeyFilterSize] = {};
+
+    static inline size_t filter_index(U64 key)
+    {
+        return key & (KeyFilterSize - 1);
+    }
+
     inline void push_back(const UndoInfo &u)
     {
+        ++key_filter[filter_index(u.zobrist_key)];
         list[count++] = u;
     }
 
     inline void pop_back()
     {
         --count;
+        --key_filter[filter_index(list[count].zobrist_key)];
+    }
+
+    // false : la clé n'apparaît certainement pas dans l'historique
+    inline bool may_contain(U64 key) const
+    {
+        return key_filter[filter_index(key)] != 0;
     }
 
     inline const UndoInfo &back() const
@@ -65,10 +86,77 @@ struct History
     inline void clear()
     {
         count = 0;
+        std::memset(key_filter, 0, sizeof(key_filter));
     }
 
     inline bool empty() const
     {
         return count == 0;
     }
+
+    // Copies only the entries [start, other.count), indices are kept as is
+    inline void copy_tail_from(const History &other, size_t start)
+    {
+        assert(start <= other.count);
+        std::memcpy(&list[start], &other.list[start], (other.count - start) * sizeof(UndoInfo));
+        count = other.count;
+
+        // Seules les entrées copiées sont comptées, is_repetition ne descend jamais sous start
+        std::memset(key_filter, 0, sizeof(key_filter));
+        for (size_t i = start; i < count; ++i)
+            ++key_filter[filter_index(list[i].zobrist_key)];
+    }
+};
+
+// Recycles History blocks (~32 Ko each) instead of new / delete on every Board copy.
+// Blocks are allocated with plain `new History` (no zeroing), so they can still be deleted directly.
+class HistoryArena
+{
+    static constexpr size_t MaxPooled = 64;
+
+    struct FreeList
+    {
+        std::mutex mutex;
+        std::vector<History *> blocks;
+    };
+
+    static FreeList &free_list()
+    {
+        // Never destroyed : Boards may still be released during static destruction
+        static FreeList *list = new FreeList();
+        return *list;
+    }
+
+public:
+    static History *acquire()
+    {
+        FreeList &fl = free_list();
+        {
+            std::lock_guard<std::mutex> lock(fl.mutex);
+            if (!fl.blocks.empty())
+            {
+                History *h = fl.blocks.back();
+                fl.blocks.pop_back();
+                h->clear();
+                return h;
+            }
+        }
+        return new History;
+    }
+
+    static void release(History *h)
+    {
+        if (!h)
+            return;
+        FreeList &fl = free_list();
+        {
+            std::lock_guard<std::mutex> lock(fl.mutex);
+            if (fl.blocks.size() < MaxPooled)
+            {
+                fl.blocks.push_back(h);
+                return;
+            }
+        }
+        delete h;
+    }
 };
\ No newline at end of file
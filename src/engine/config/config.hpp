@@ -1,7 +1,8 @@
 #pragma once
 
+// Build SPSA : une copie par thread (voir search_params.hpp)
 #ifdef SPSA_TUNING
-#define PARAM_SPECIFIER inline
+#define PARAM_SPECIFIER inline thread_local
 #else
 #define PARAM_SPECIFIER constexpr
 #endif
@@ -151,10 +151,10 @@ namespace engine_constants::eval
         -17, -7, -2, 7, 6, 4, -9, -5};
 
     // Table de correspondance pour le milieu de jeu
-    static CONST_GUARD TUNABLE_TYPE *mg_tables[] = {
+    [[maybe_unused]] static CONST_GUARD TUNABLE_TYPE *mg_tables[] = {
         mg_pawn_table, mg_knight_table, mg_bishop_table, mg_rook_table, mg_queen_table, mg_king_table};
 
-    static CONST_GUARD TUNABLE_TYPE *eg_tables[] = {
+    [[maybe_unused]] static CONST_GUARD TUNABLE_TYPE *eg_tables[] = {
         eg_pawn_table, eg_knight_table, eg_bishop_table, eg_rook_table, eg_queen_table, eg_king_table};
 
     static const int pawnPhase = 0;
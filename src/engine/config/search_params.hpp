@@ -0,0 +1,119 @@
+#pragma once
+
+#ifdef SPSA_TUNING
+
+// Registre des paramètres de recherche réglables (build SPSA).
+// Les paramètres sont thread_local : chaque thread joue avec ses propres valeurs, ce qui permet
+// au tuner SPSA de faire jouer en parallèle des vecteurs perturbés différents dans le même processus.
+// Les threads de recherche d'un EngineManager reprennent les valeurs du thread qui lance la recherche.
+// CHESS26_SEARCH_PARAMS est la seule liste : le tuner SPSA et les options UCI en sont générés.
+// X(variable, nom, min, max) : bornes de l'option UCI (centièmes pour les réels) ; NoMin / NoMax : toute la plage du type.
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include "engine/config/config.hpp"
+
+#define CHESS26_SEARCH_PARAMS(X)                                                                    \
+    X(aspiration::EnableDepth, "aspiration_enable_depth", 1, 63)                                    \
+    X(aspiration::MidDepth, "aspiration_mid_depth", 1, 63)                                          \
+    X(aspiration::HighDepth, "aspiration_high_depth", 1, 63)                                        \
+    X(aspiration::SmallDelta, "aspiration_small_delta", 1, 1000)                                    \
+    X(aspiration::MidDelta, "aspiration_mid_delta", 1, 1000)                                        \
+    X(aspiration::HighDelta, "aspiration_high_delta", 1, 2000)                                      \
+    X(aspiration::WidenMinDelta, "aspiration_widen_min_delta", 1, 1000)                             \
+    X(aspiration::WidenMaxDelta, "aspiration_widen_max_delta", 50, 10000)                           \
+    X(aspiration::MaxIterations, "aspiration_max_iterations", 1, 20)                                \
+    X(aspiration::MateWindowMargin, "aspiration_mate_window_margin", 1, 1000)                       \
+    X(razoring::MaxDepth, "razoring_max_depth", NoMin, NoMax)                                       \
+    X(razoring::MarginDepthFactor, "razoring_depth_factor", NoMin, NoMax)                           \
+    X(razoring::MarginConst, "razoring_margin_const", NoMin, NoMax)                                 \
+    X(reverse_futility_pruning::MaxDepth, "rfp_max_depth", NoMin, NoMax)                            \
+    X(reverse_futility_pruning::MarginDepthFactor, "rfp_marg_d_fact", NoMin, NoMax)                 \
+    X(reverse_futility_pruning::MarginConst, "rfp_marg_const", NoMin, NoMax)                        \
+    X(iterative_deepening::MaxDepth, "itd_max_depth", NoMin, NoMax)                                 \
+    X(iterative_deepening::NewDepthIncr, "itd_new_depth_inc", NoMin, NoMax)                         \
+    X(null_move_pruning::MinDepth, "nmp_min_depth", NoMin, NoMax)                                   \
+    X(null_move_pruning::RConst, "nmp_r_const", NoMin, NoMax)                                       \
+    X(null_move_pruning::RDiv, "nmp_r_div", NoMin, NoMax)                                           \
+    X(futility_pruning::MaxDepth, "fp_max_depth", NoMin, NoMax)                                     \
+    X(futility_pruning::MarginConst, "fp_margin_const", NoMin, NoMax)                               \
+    X(futility_pruning::MarginDepthFactor, "fp_margin_d_fact", NoMin, NoMax)                        \
+    X(singular::MinDepth, "singular_min_depth", NoMin, NoMax)                                       \
+    X(null_move_reduction::MaxDepth, "nmr_max_depth", NoMin, NoMax)                                 \
+    X(null_move_reduction::MaxMovesConst, "nmr_max_moves_const", NoMin, NoMax)                      \
+    X(null_move_reduction::MaxMovesDepthSqFactor, "nmr_max_moves_depth_sq_factor", NoMin, NoMax)    \
+    X(late_move_reduction::MinDepth, "lmr_min_depth", NoMin, NoMax)                                 \
+    X(late_move_reduction::MinMovesSearched, "lmr_min_moves_searched", NoMin, NoMax)                \
+    X(late_move_reduction::MaxDepthReduction, "lmr_max_depth_reduction", NoMin, NoMax)              \
+    X(late_move_reduction::TableInitConst, "lmr_table_init_const", NoMin, NoMax)                    \
+    X(late_move_reduction::TableInitDiv, "lmr_table_init_div", NoMin, NoMax)                        \
+    X(see_pruning::MaxDepth, "see_pruning_max_depth", NoMin, NoMax)                                 \
+    X(see_pruning::ThresholdDepthFactor, "threshold_depth_factor", NoMin, NoMax)
+
+namespace search_params
+{
+    constexpr long long NoMin = std::numeric_limits<long long>::lowest();
+    constexpr long long NoMax = std::numeric_limits<long long>::max();
+
+    // Accès aux valeurs du thread courant
+    struct Param
+    {
+        std::string_view name;
+        bool real;
+        double (*get)();
+        void (*set)(double);
+    };
+
+#define CHESS26_PARAM_ENTRY(var, label, ...)                                                  \
+    Param{label,                                                                              \
+          std::is_floating_point_v<std::remove_cvref_t<decltype(engine_constants::search::var)>>, \
+          []() -> double { return engine_constants::search::var; },                           \
+          [](double v)                                                                        \
+          {                                                                                   \
+              using T = std::remove_cvref_t<decltype(engine_constants::search::var)>;         \
+              if constexpr (std::is_floating_point_v<T>)                                      \
+                  engine_constants::search::var = static_cast<T>(v);                          \
+              else                                                                            \
+                  engine_constants::search::var = static_cast<T>(std::lround(v));             \
+          }},
+
+    inline const Param table[] = {CHESS26_SEARCH_PARAMS(CHESS26_PARAM_ENTRY)};
+
+#undef CHESS26_PARAM_ENTRY
+
+    constexpr std::size_t Count = sizeof(table) / sizeof(table[0]);
+    using Values = std::array<double, Count>;
+
+    inline const Param *find(std::string_view name)
+    {
+        for (const Param &p : table)
+            if (p.name == name)
+                return &p;
+        return nullptr;
+    }
+
+    inline std::size_t index_of(const Param *p)
+    {
+        return static_cast<std::size_t>(p - table);
+    }
+
+    inline Values capture()
+    {
+        Values v{};
+        for (std::size_t i = 0; i < Count; ++i)
+            v[i] = table[i].get();
+        return v;
+    }
+
+    inline void apply(const Values &v)
+    {
+        for (std::size_t i = 0; i < Count; ++i)
+            table[i].set(v[i]);
+    }
+}
+
+#endif
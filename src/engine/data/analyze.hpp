@@ -0,0 +1,317 @@
+#pragma once
+
+// Analyse par lots d'un fichier EPD : chaque thread prend la position suivante de la file et la
+// recherche avec son propre EngineManager (TT partitionnée : hash_mb répartis entre les threads,
+// conservée d'une position à l'autre). Les résultats sont écrits dès qu'ils sont prêts, une ligne par
+// position (JSON ou CSV) ; le champ index (ligne du fichier, à partir de 1) permet de les remettre dans l'ordre.
+//
+// Ligne EPD : <placement> <trait> <roques> <ep> [demi-coups coups] [opcodes ;]
+// Opcodes reconnus : acd <profondeur>; acn <nœuds>; id "<nom>"; les autres sont ignorés.
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "common/logger.hpp"
+#include "engine/engine_manager.hpp"
+
+namespace analysis
+{
+    enum class Format
+    {
+        Json,
+        Csv
+    };
+
+    struct Config
+    {
+        std::string in_path;
+        std::string out_path; // Vide : sortie UCI (logs::uci)
+        Format format = Format::Json;
+        int depth = 0;       // Limites par défaut, remplacées par acd / acn ; aucune : DefaultDepth
+        long long nodes = 0;
+        unsigned threads = 1;
+        size_t hash_mb = 64; // Total, réparti entre les threads
+
+        static constexpr int DefaultDepth = 10;
+    };
+
+    struct Job
+    {
+        size_t index = 0; // Ligne du fichier
+        std::string fen;
+        std::string id;
+        int depth = 0;
+        long long nodes = 0;
+    };
+
+    struct Stats
+    {
+        std::atomic<long long> positions{0};
+        std::atomic<long long> nodes{0};
+        long long rejected = 0; // Lignes illisibles
+    };
+
+    // Ligne vide ou commentaire, éventuellement indenté : ignorée sans être comptée comme rejetée
+    inline bool is_blank_or_comment(std::string_view line)
+    {
+        const size_t first = line.find_first_not_of(" \t\r");
+        return first == std::string_view::npos || line[first] == '#';
+    }
+
+    // Ligne EPD vers position à analyser ; nullopt pour une ligne vide, un commentaire ou une position invalide
+    inline std::optional<Job> parse_epd_line(std::string_view line, const Config &config)
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (is_blank_or_comment(line))
+            return std::nullopt;
+        line.remove_prefix(line.find_first_not_of(" \t"));
+
+        Job job;
+        job.depth = config.depth;
+        job.nodes = config.nodes;
+
+        // 4 champs FEN, puis éventuellement les compteurs de coups
+        std::istringstream is{std::string(line)};
+        std::string field;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (!(is >> field))
+                return std::nullopt;
+            job.fen += (i ? " " : "") + field;
+        }
+
+        auto parse_ll = [](std::string_view s, long long &out)
+        {
+            auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+            return ec == std::errc() && ptr == s.data() + s.size();
+        };
+
+        std::string rest;
+        std::getline(is, rest);
+        std::istringstream ops(rest);
+        long long counter;
+        for (int i = 0; i < 2; ++i)
+        {
+            const auto pos = ops.tellg();
+            if (!(ops >> field) || !parse_ll(field, counter) || counter < 0)
+            {
+                ops.clear();
+                ops.seekg(pos);
+                break;
+            }
+            job.fen += " " + field;
+        }
+
+        // Opcodes séparés par ';'
+        std::string op;
+        while (std::getline(ops, op, ';'))
+        {
+            std::istringstream os(op);
+            std::string name, value;
+            if (!(os >> name))
+                continue;
+            std::getline(os >> std::ws, value);
+            long long n;
+            if (name == "acd" && parse_ll(value, n) && n > 0)
+                job.depth = static_cast<int>(std::min<long long>(n, engine_constants::search::MaxDepth - 1));
+            else if (name == "acn" && parse_ll(value, n) && n > 0)
+                job.nodes = n;
+            else if (name == "id")
+            {
+                if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+                    value = value.substr(1, value.size() - 2);
+                job.id = value;
+            }
+        }
+
+        if (job.depth == 0 && job.nodes == 0)
+            job.depth = Config::DefaultDepth;
+
+        Board probe;
+        if (!probe.load_fen(job.fen))
+            return std::nullopt;
+        return job;
+    }
+
+    inline std::string json_escape(std::string_view s)
+    {
+        std::string out;
+        for (const char c : s)
+        {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20)
+                out += c;
+        }
+        return out;
+    }
+
+    inline std::string csv_quote(std::string_view s)
+    {
+        std::string out = "\"";
+        for (const char c : s)
+        {
+            if (c == '"')
+                out += '"';
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    // Coups jusqu'au mat, signé du point de vue du trait ; 0 si le score n'est pas un mat
+    inline int mate_in(int score)
+    {
+        constexpr int bound = engine_constants::eval::MateScore - engine_constants::search::MaxDepth;
+        if (score >= bound)
+            return (engine_constants::eval::MateScore - score + 1) / 2;
+        if (score <= -bound)
+            return -((engine_constants::eval::MateScore + score + 1) / 2);
+        return 0;
+    }
+
+    inline std::string format_result(const Config &config, const Job &job, const EngineManager::BenchResult &r)
+    {
+        std::string pv = r.pv;
+        while (!pv.empty() && pv.back() == ' ')
+            pv.pop_back();
+        const std::string best = r.best_move.get_value() ? r.best_move.to_uci() : "";
+        const int mate = mate_in(r.score_cp);
+
+        std::ostringstream out;
+        if (config.format == Format::Csv)
+        {
+            out << job.index << "," << csv_quote(job.id) << "," << csv_quote(job.fen) << "," << r.depth << "," << r.nodes << ","
+                << r.elapsed_ms << "," << best << "," << r.score_cp << ",";
+            if (mate)
+                out << mate;
+            out << "," << pv;
+        }
+        else
+        {
+            out << "{\"index\":" << job.index << ",\"id\":\"" << json_escape(job.id) << "\",\"fen\":\"" << job.fen
+                << "\",\"depth\":" << r.depth << ",\"nodes\":" << r.nodes << ",\"time_ms\":" << r.elapsed_ms
+                << ",\"bestmove\":\"" << best << "\",\"score_cp\":" << r.score_cp << ",\"mate\":";
+            if (mate)
+                out << mate;
+            else
+                out << "null";
+            out << ",\"pv\":\"" << pv << "\"}";
+        }
+        return out.str();
+    }
+
+    inline const char *csv_header()
+    {
+        return "index,id,fen,depth,nodes,time_ms,bestmove,score_cp,mate,pv";
+    }
+
+    class Analyzer
+    {
+        const Config config;
+        Stats stats;
+        std::vector<Job> jobs;
+        std::atomic<size_t> next_job{0};
+        std::mutex out_mutex;
+        std::ofstream file; // Ouvert si out_path est donné, sinon logs::uci
+
+        void write_line(const std::string &line)
+        {
+            if (file.is_open())
+                file << line << '\n';
+            else
+                logs::uci << line << std::endl;
+        }
+
+        void worker_loop(size_t hash_mb)
+        {
+            VBoard root;
+            EngineManager manager(root, hash_mb);
+            VBoard position;
+            for (size_t i; (i = next_job.fetch_add(1, std::memory_order_relaxed)) < jobs.size();)
+            {
+                const Job &job = jobs[i];
+                position.load_fen(job.fen);
+                const int max_depth = job.depth > 0 ? job.depth : engine_constants::search::MaxDepth - 1;
+                const EngineManager::BenchResult r = manager.search_nodes(position, job.nodes, max_depth, true);
+                stats.nodes.fetch_add(r.nodes, std::memory_order_relaxed);
+                stats.positions.fetch_add(1, std::memory_order_relaxed);
+
+                const std::string line = format_result(config, job, r);
+                std::lock_guard<std::mutex> lock(out_mutex);
+                write_line(line);
+            }
+        }
+
+    public:
+        explicit Analyzer(const Config &c) : config(c) {}
+
+        const Stats &get_stats() const { return stats; }
+
+        bool run()
+        {
+            std::ifstream in(config.in_path);
+            if (!in)
+            {
+                logs::uci << "info string analyze cannot open " << config.in_path << std::endl;
+                return false;
+            }
+            std::string line;
+            for (size_t index = 1; std::getline(in, line); ++index)
+            {
+                std::optional<Job> job = parse_epd_line(line, config);
+                if (job)
+                {
+                    job->index = index;
+                    jobs.push_back(std::move(*job));
+                }
+                else if (!is_blank_or_comment(line))
+                    ++stats.rejected;
+            }
+
+            if (!config.out_path.empty())
+            {
+                file.open(config.out_path, std::ios::trunc);
+                if (!file)
+                {
+                    logs::uci << "info string analyze cannot open " << config.out_path << std::endl;
+                    return false;
+                }
+            }
+            if (config.format == Format::Csv)
+                write_line(csv_header());
+
+            const unsigned threads = std::max(1u, std::min<unsigned>(config.threads, static_cast<unsigned>(std::max<size_t>(1, jobs.size()))));
+            const size_t hash_mb = std::max<size_t>(1, config.hash_mb / threads);
+            const auto start = std::chrono::steady_clock::now();
+            {
+                std::vector<std::jthread> pool;
+                for (unsigned t = 1; t < threads; ++t)
+                    pool.emplace_back([this, hash_mb]()
+                                      { worker_loop(hash_mb); });
+                worker_loop(hash_mb);
+            }
+            if (file.is_open())
+                file.close();
+
+            const double s = std::max(1e-3, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            logs::uci << "info string analyze positions " << stats.positions.load()
+                      << " rejected " << stats.rejected
+                      << " threads " << threads
+                      << " pos/s " << stats.positions.load() / s
+                      << " nps " << static_cast<long long>(stats.nodes.load() / s) << std::endl;
+            return true;
+        }
+    };
+}
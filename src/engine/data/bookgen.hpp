@@ -0,0 +1,201 @@
+#pragma once
+
+// Génération d'un livre d'ouverture par le moteur, couche par couche depuis une position racine.
+// Chaque position est analysée coup par coup (recherche à profondeur fixe de chaque position fille) ;
+// les coups à moins de margin_cp du meilleur entrent au livre et leurs positions forment la couche suivante.
+// Le fichier reste au format Polyglot (lisible par Book::probe) ; le champ learn porte le score et la
+// profondeur de chaque coup. Relancer sur le même fichier ne recherche que les positions absentes ou
+// analysées moins profondément ; le livre est réécrit à la fin de chaque couche.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/logger.hpp"
+#include "core/move/generator/move_generator.hpp"
+#include "engine/engine_manager.hpp"
+#include "engine/eval/book.hpp"
+
+namespace bookgen
+{
+    struct Config
+    {
+        std::string out_path = "book.bin";
+        int plies = 8;      // Profondeur de l'arbre, en demi-coups depuis la racine
+        int depth = 12;     // Profondeur de recherche de chaque coup candidat (position fille : depth - 1)
+        int max_moves = 3;  // Coups retenus par position
+        int margin_cp = 30; // Écart maximal au meilleur coup
+        unsigned threads = 1;
+        size_t hash_mb = 16; // TT de chaque thread
+    };
+
+    // learn Polyglot : score du coup pour le trait (16 bits bas, signé) et profondeur (8 bits suivants)
+    inline std::uint32_t pack_learn(int score, int depth)
+    {
+        const auto s = static_cast<std::uint16_t>(static_cast<std::int16_t>(std::clamp(score, -32000, 32000)));
+        return s | (static_cast<std::uint32_t>(std::clamp(depth, 0, 255)) << 16);
+    }
+    inline int learn_score(std::uint32_t learn) { return static_cast<std::int16_t>(learn & 0xFFFF); }
+    inline int learn_depth(std::uint32_t learn) { return static_cast<int>((learn >> 16) & 0xFF); }
+
+    struct Stats
+    {
+        std::atomic<long long> positions{0}; // Positions recherchées
+        std::atomic<long long> skipped{0};   // Déjà au livre à la profondeur demandée
+        std::atomic<long long> nodes{0};
+        long long entries = 0;
+    };
+
+    class Generator
+    {
+        const Config config;
+        Stats stats;
+        std::unordered_map<std::uint64_t, std::vector<Book::Record>> book;
+        std::mutex book_mutex;
+
+        // Entrées de la position : chaque coup légal est évalué par une recherche de sa position fille
+        std::vector<Book::Record> analyse(Board &position, EngineManager &manager)
+        {
+            struct Scored
+            {
+                Move move;
+                int score;
+            };
+            std::vector<Scored> scored;
+
+            MoveList list;
+            MoveGen::generate_legal_moves(position, list);
+            VBoard child;
+            for (int i = 0; i < list.count; ++i)
+            {
+                child = position;
+                child.play(list[i]);
+                const EngineManager::BenchResult r = manager.run_benchmark_fixed_depth(child, config.depth - 1);
+                stats.nodes.fetch_add(r.nodes, std::memory_order_relaxed);
+                scored.push_back({list[i], -r.score_cp});
+            }
+
+            std::stable_sort(scored.begin(), scored.end(), [](const Scored &a, const Scored &b)
+                             { return a.score > b.score; });
+
+            std::vector<Book::Record> records;
+            const std::uint64_t key = position.polyglot_key();
+            for (const Scored &s : scored)
+            {
+                const int loss = scored[0].score - s.score;
+                if (static_cast<int>(records.size()) >= config.max_moves || loss > config.margin_cp)
+                    break;
+                const auto weight = static_cast<std::uint16_t>(std::min(config.margin_cp - loss + 1, 0xFFFF));
+                records.push_back({key, Book::encode(s.move), weight, pack_learn(s.score, config.depth)});
+            }
+            return records;
+        }
+
+        bool is_done(std::uint64_t key) const
+        {
+            const auto it = book.find(key);
+            return it != book.end() && !it->second.empty() && learn_depth(it->second.front().learn) >= config.depth;
+        }
+
+        bool save()
+        {
+            std::vector<Book::Record> records;
+            for (const auto &[key, entries] : book)
+                records.insert(records.end(), entries.begin(), entries.end());
+            stats.entries = static_cast<long long>(records.size());
+            return Book::write_records(config.out_path, std::move(records));
+        }
+
+    public:
+        explicit Generator(const Config &c) : config(c) {}
+
+        const Stats &get_stats() const { return stats; }
+
+        bool run(const Board &root)
+        {
+            std::vector<Book::Record> existing;
+            if (Book::read_records(config.out_path, existing))
+                for (const Book::Record &r : existing)
+                    book[r.key].push_back(r);
+
+            const auto start = std::chrono::steady_clock::now();
+            std::unordered_set<std::uint64_t> seen{root.polyglot_key()};
+            std::vector<Board> layer{root};
+
+            for (int ply = 0; ply < config.plies && !layer.empty(); ++ply)
+            {
+                // 1. Positions de la couche à (re)chercher
+                std::vector<Board *> todo;
+                for (Board &position : layer)
+                {
+                    if (is_done(position.polyglot_key()))
+                        stats.skipped.fetch_add(1, std::memory_order_relaxed);
+                    else
+                        todo.push_back(&position);
+                }
+
+                // 2. Une position par thread à la fois, chaque thread avec sa propre TT
+                std::atomic<size_t> next{0};
+                auto worker = [&]()
+                {
+                    VBoard scratch;
+                    EngineManager manager(scratch, config.hash_mb);
+                    for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < todo.size();)
+                    {
+                        std::vector<Book::Record> records = analyse(*todo[i], manager);
+                        stats.positions.fetch_add(1, std::memory_order_relaxed);
+                        std::lock_guard<std::mutex> lock(book_mutex);
+                        book[todo[i]->polyglot_key()] = std::move(records);
+                    }
+                };
+                {
+                    std::vector<std::jthread> threads;
+                    for (unsigned t = 1; t < std::max(1u, config.threads); ++t)
+                        threads.emplace_back(worker);
+                    worker();
+                }
+
+                if (!save())
+                {
+                    logs::uci << "info string bookgen cannot write " << config.out_path << std::endl;
+                    return false;
+                }
+
+                // 3. Couche suivante : positions atteintes par les coups du livre, sans doublon
+                std::vector<Board> next_layer;
+                for (Board &position : layer)
+                {
+                    const auto it = book.find(position.polyglot_key());
+                    if (it == book.end())
+                        continue;
+                    for (const Book::Record &r : it->second)
+                    {
+                        const Move m = Book::decode(r.move, position);
+                        if (m.get_value() == 0 || !position.is_move_pseudo_legal(m) || !position.is_move_legal(m))
+                            continue;
+                        Board child = position;
+                        child.play(m);
+                        if (seen.insert(child.polyglot_key()).second)
+                            next_layer.push_back(std::move(child));
+                    }
+                }
+                layer = std::move(next_layer);
+
+                const double s = std::max(1e-3, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+                logs::uci << "info string bookgen ply " << ply + 1 << "/" << config.plies
+                          << " searched " << stats.positions.load()
+                          << " skipped " << stats.skipped.load()
+                          << " entries " << stats.entries
+                          << " nps " << static_cast<long long>(stats.nodes.load() / s) << std::endl;
+            }
+            return true;
+        }
+    };
+}
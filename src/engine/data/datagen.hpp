@@ -0,0 +1,208 @@
+#pragma once
+
+// Génération de données d'entraînement par parties en self-play à nombre de nœuds fixé.
+// Chaque thread joue ses parties de bout en bout avec son propre EngineManager (TT vidée à chaque
+// partie) : aucune synchronisation pendant une partie, les positions sont écrites au format
+// PackedPosition une fois le résultat connu.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/logger.hpp"
+#include "core/board/packed_position.hpp"
+#include "core/move/generator/move_generator.hpp"
+#include "engine/data/packed_io.hpp"
+#include "engine/data/selfplay.hpp"
+#include "engine/engine_manager.hpp"
+#include "engine/eval/pos_eval.hpp"
+#include "engine/utils/random.hpp"
+
+namespace datagen
+{
+    // Règles de partie (selfplay::Rules) : ouverture aléatoire de random_plies coups non enregistrée,
+    // adjudication plus tardive que le tuner SPSA
+    struct Config : selfplay::Rules
+    {
+        Config()
+        {
+            max_plies = 400;
+            win_cp = 2000;
+        }
+
+        std::string out_path = "datagen.bin";
+        long long games = 1000;
+        long long nodes = 5000; // Nœuds par coup
+        unsigned threads = 1;
+        std::uint64_t seed = 0;
+        size_t hash_mb = 8;       // TT de chaque partie
+        int max_opening_cp = 800; // Ouvertures trop déséquilibrées écartées
+    };
+
+    struct Stats
+    {
+        std::atomic<long long> games{0};
+        std::atomic<long long> positions{0};
+        std::atomic<long long> plies{0};
+        std::atomic<long long> nodes{0};
+        std::atomic<long long> results[3] = {0, 0, 0}; // Parties écrites seulement, indexé par PackedPosition::Result
+        std::atomic<long long> discarded{0};           // Parties jouées sans aucune position retenue
+    };
+
+    class Generator
+    {
+        const Config config;
+        Stats stats;
+        std::atomic<long long> next_game{0};
+        std::mutex out_mutex;
+        packed::PackedWriter writer;
+
+        // Tire la partie index : ouverture aléatoire déterministe puis self-play jusqu'au résultat.
+        // Retourne false si l'ouverture est écartée (sans coup légal ou trop déséquilibrée).
+        bool play_game(long long index, int attempt, EngineManager &manager, TranspositionTable &qtt, std::vector<PackedPosition> &out)
+        {
+            out.clear();
+            std::uint64_t rng = config.seed ^ engine::random::splitmix64(static_cast<std::uint64_t>(index) * 1024 + attempt);
+
+            VBoard board;
+            board.load_fen(constants::FenInitPos);
+            if (!selfplay::random_opening(board, config.random_plies, rng))
+                return false;
+
+            manager.clear();
+            auto search = [&](const VBoard &position, Color)
+            {
+                const EngineManager::BenchResult r = manager.search_nodes(position, config.nodes);
+                stats.nodes.fetch_add(r.nodes, std::memory_order_relaxed);
+                stats.plies.fetch_add(1, std::memory_order_relaxed);
+                return r;
+            };
+            auto record = [&](const selfplay::Ply &p)
+            {
+                if (p.ply == config.random_plies && std::abs(p.white_score) > config.max_opening_cp)
+                    return false;
+
+                // Positions calmes uniquement : hors échec, meilleur coup tranquille, quiescence = éval statique
+                const Move best = p.result.best_move;
+                const bool mate_score = std::abs(p.result.score_cp) >= engine_constants::eval::MateScore - engine_constants::search::MaxDepth;
+                if (!p.in_check && !mate_score && !best.is_capture() && !best.is_promotion())
+                {
+                    const Color us = p.board.get_side_to_move();
+                    const int static_eval = (us == WHITE) ? Eval::eval_relative<WHITE>(p.board, -engine_constants::eval::Inf, engine_constants::eval::Inf)
+                                                          : Eval::eval_relative<BLACK>(p.board, -engine_constants::eval::Inf, engine_constants::eval::Inf);
+                    if (manager.quiescence_score(p.board, qtt) == static_eval)
+                    {
+                        PackedPosition &packed = out.emplace_back();
+                        p.board.pack(packed);
+                        packed.score = static_cast<std::int16_t>(std::clamp(p.white_score, -32000, 32000));
+                        packed.ply = static_cast<std::uint16_t>(p.ply);
+                    }
+                }
+                return true;
+            };
+
+            const selfplay::Result played = selfplay::play(board, config.random_plies, config, search, record);
+            if (played == selfplay::Aborted)
+                return false;
+            const PackedPosition::Result result = played == selfplay::WhiteWin   ? PackedPosition::WhiteWin
+                                                  : played == selfplay::BlackWin ? PackedPosition::BlackWin
+                                                                                 : PackedPosition::Draw;
+            for (PackedPosition &p : out)
+                p.result = result;
+            return true;
+        }
+
+        void worker_loop()
+        {
+            VBoard root;
+            EngineManager manager(root, config.hash_mb);
+            TranspositionTable qtt;
+            qtt.resize(1);
+            std::vector<PackedPosition> positions;
+
+            for (long long index; (index = next_game.fetch_add(1, std::memory_order_relaxed)) < config.games;)
+            {
+                bool played = false;
+                for (int attempt = 0; attempt < 64 && !(played = play_game(index, attempt, manager, qtt, positions)); ++attempt)
+                    positions.clear();
+                if (positions.empty())
+                {
+                    if (played)
+                        stats.discarded.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(out_mutex);
+                    writer.write(positions);
+                }
+                stats.games.fetch_add(1, std::memory_order_relaxed);
+                stats.results[positions.front().result].fetch_add(1, std::memory_order_relaxed);
+                stats.positions.fetch_add(static_cast<long long>(positions.size()), std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        explicit Generator(const Config &c) : config(c) {}
+
+        const Stats &get_stats() const { return stats; }
+
+        bool run()
+        {
+            if (!writer.open(config.out_path, true))
+            {
+                logs::uci << "info string datagen cannot open " << config.out_path << std::endl;
+                return false;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            auto report = [&]()
+            {
+                const double s = std::max(1e-3, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+                const long long positions = stats.positions.load();
+                logs::uci << "info string datagen games " << stats.games.load()
+                          << " positions " << positions
+                          << " pos/s " << static_cast<long long>(positions / s)
+                          << " nps " << static_cast<long long>(stats.nodes.load() / s)
+                          << " w/d/l " << stats.results[PackedPosition::WhiteWin].load()
+                          << "/" << stats.results[PackedPosition::Draw].load()
+                          << "/" << stats.results[PackedPosition::BlackWin].load()
+                          << " discarded " << stats.discarded.load() << std::endl;
+            };
+
+            std::vector<std::jthread> threads;
+            for (unsigned t = 0; t < std::max(1u, config.threads); ++t)
+                threads.emplace_back([this]()
+                                     { worker_loop(); });
+
+            std::atomic<bool> done{false};
+            std::jthread progress([&]()
+                                  {
+                auto last = std::chrono::steady_clock::now();
+                while (!done.load())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    if (std::chrono::steady_clock::now() - last >= std::chrono::seconds(10))
+                    {
+                        report();
+                        last = std::chrono::steady_clock::now();
+                    }
+                } });
+
+            for (auto &th : threads)
+                th.join();
+            done.store(true);
+            progress.join();
+
+            writer.close();
+            report();
+            return true;
+        }
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// Lignes EPD étiquetées (format quiet-labeled : résultat de la partie en opcode c9)
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+struct LabeledFen
+{
+    std::string_view fen; // Vue dans le fichier : placement, trait, roques, en passant
+    double result = 0.5;
+};
+
+// <placement> <trait> <roques> <ep> c9 "1-0";
+inline std::optional<LabeledFen> parse_quiet_labeled_line(std::string_view line)
+{
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+
+    std::size_t pos = 0;
+    for (int field = 0; field < 4; ++field)
+    {
+        pos = line.find(' ', pos);
+        if (pos == std::string_view::npos)
+            return std::nullopt;
+        ++pos;
+    }
+    const std::string_view fen = line.substr(0, pos - 1);
+
+    std::string_view rest = line.substr(pos);
+    if (!rest.starts_with("c9 "))
+        return std::nullopt;
+    rest.remove_prefix(3);
+    if (!rest.empty() && rest.back() == ';')
+        rest.remove_suffix(1);
+
+    if (rest == "\"1-0\"")
+        return LabeledFen{fen, 1.0};
+    if (rest == "\"1/2-1/2\"")
+        return LabeledFen{fen, 0.5};
+    if (rest == "\"0-1\"")
+        return LabeledFen{fen, 0.0};
+    return std::nullopt;
+}
+
+// Fin de la ligne contenant text[pos] (position après le '\n'), text.size() si c'est la dernière
+inline std::size_t next_line_start(std::string_view text, std::size_t pos)
+{
+    if (pos >= text.size())
+        return text.size();
+    const std::size_t nl = text.find('\n', pos);
+    return nl == std::string_view::npos ? text.size() : nl + 1;
+}
+
+// Découpe text[begin, end) en parts morceaux de tailles voisines, alignés sur les lignes
+inline std::vector<std::size_t> split_lines(std::string_view text, std::size_t begin, std::size_t end, unsigned parts)
+{
+    std::vector<std::size_t> bounds{begin};
+    for (unsigned t = 1; t < parts; ++t)
+    {
+        const std::size_t target = begin + (end - begin) * t / parts;
+        bounds.push_back(std::clamp(next_line_start(text, target == begin ? begin : target - 1), bounds.back(), end));
+    }
+    bounds.push_back(end);
+    return bounds;
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+// Fichiers de positions binaires (.bin) : une suite de PackedPosition de 32 octets, sans en-tête.
+// Lecture sans copie par mmap, écriture en bloc, et conversion depuis un EPD étiqueté.
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/mapped_file.hpp"
+#include "core/board/board.hpp"
+#include "core/board/packed_position.hpp"
+#include "engine/data/epd.hpp"
+
+namespace packed
+{
+    inline bool is_packed_path(const std::string &path)
+    {
+        return std::filesystem::path(path).extension() == ".bin";
+    }
+
+    // Vue en lecture seule d'un fichier .bin ; les octets en trop d'un fichier tronqué sont ignorés
+    class PackedFile
+    {
+        file::MappedFile file;
+
+    public:
+        bool open(const std::string &path) { return file.open(path); }
+
+        std::span<const PackedPosition> positions() const
+        {
+            return {reinterpret_cast<const PackedPosition *>(file.data()), file.size() / sizeof(PackedPosition)};
+        }
+    };
+
+    // Écriture tamponnée, pour les générateurs qui produisent les positions au fil de l'eau
+    class PackedWriter
+    {
+        std::FILE *out = nullptr;
+        std::vector<PackedPosition> buffer;
+
+    public:
+        PackedWriter() = default;
+        PackedWriter(const PackedWriter &) = delete;
+        PackedWriter &operator=(const PackedWriter &) = delete;
+        ~PackedWriter() { close(); }
+
+        bool open(const std::string &path, bool append = false)
+        {
+            close();
+            out = std::fopen(path.c_str(), append ? "ab" : "wb");
+            buffer.reserve(4096);
+            return out != nullptr;
+        }
+
+        void write(const PackedPosition &p)
+        {
+            buffer.push_back(p);
+            if (buffer.size() == buffer.capacity())
+                flush();
+        }
+
+        void write(std::span<const PackedPosition> positions)
+        {
+            flush();
+            if (out && !positions.empty())
+                std::fwrite(positions.data(), sizeof(PackedPosition), positions.size(), out);
+        }
+
+        void flush()
+        {
+            if (out && !buffer.empty())
+                std::fwrite(buffer.data(), sizeof(PackedPosition), buffer.size(), out);
+            buffer.clear();
+        }
+
+        void close()
+        {
+            if (!out)
+                return;
+            flush();
+            std::fclose(out);
+            out = nullptr;
+        }
+    };
+
+    struct ConvertStats
+    {
+        std::size_t lines = 0;
+        std::size_t written = 0;
+        std::size_t rejected = 0;
+    };
+
+    // Analyse text[begin, end) : une position par ligne EPD étiquetée valide
+    inline ConvertStats pack_epd_lines(std::string_view text, std::size_t begin, std::size_t end, std::vector<PackedPosition> &out)
+    {
+        ConvertStats stats;
+        Board board;
+        while (begin < end)
+        {
+            const std::size_t next = std::min(end, next_line_start(text, begin));
+            const std::string_view line = text.substr(begin, next - begin - (text[next - 1] == '\n' ? 1 : 0));
+            begin = next;
+            if (line.empty())
+                continue;
+
+            ++stats.lines;
+            const auto sample = parse_quiet_labeled_line(line);
+            if (!sample.has_value() || !board.load_fen(sample->fen))
+            {
+                ++stats.rejected;
+                continue;
+            }
+
+            PackedPosition &p = out.emplace_back();
+            board.pack(p);
+            p.result = PackedPosition::result_from_white_score(sample->result);
+            ++stats.written;
+        }
+        return stats;
+    }
+
+    // EPD -> .bin, par morceaux analysés en parallèle et écrits dans l'ordre du fichier
+    inline bool convert_epd(const std::string &in_path, const std::string &out_path, unsigned threads, ConvertStats &stats)
+    {
+        file::MappedFile in;
+        if (!in.open(in_path))
+            return false;
+        PackedWriter writer;
+        if (!writer.open(out_path))
+            return false;
+
+        constexpr std::size_t chunk_bytes = std::size_t(64) << 20;
+        threads = std::max(1u, threads);
+        const std::string_view text = in.view();
+        std::vector<std::vector<PackedPosition>> parts(threads);
+        std::vector<ConvertStats> part_stats(threads);
+
+        for (std::size_t begin = 0; begin < text.size();)
+        {
+            const std::size_t end = next_line_start(text, std::min(text.size(), begin + chunk_bytes) - 1);
+            const std::vector<std::size_t> bounds = split_lines(text, begin, end, threads);
+
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                parts[t].clear();
+                workers.emplace_back([&, t]()
+                                     { part_stats[t] = pack_epd_lines(text, bounds[t], bounds[t + 1], parts[t]); });
+            }
+            for (auto &w : workers)
+                w.join();
+
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                writer.write(parts[t]);
+                stats.lines += part_stats[t].lines;
+                stats.written += part_stats[t].written;
+                stats.rejected += part_stats[t].rejected;
+            }
+            begin = end;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+// Boucle de partie en self-play partagée par datagen et le tuner SPSA : ouverture aléatoire
+// déterministe, recherche à nombre de nœuds fixé par coup, fin de partie et adjudication.
+// L'appelant fournit la recherche (quel moteur, quels paramètres) et reçoit chaque coup cherché.
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "core/move/generator/move_generator.hpp"
+#include "engine/engine_manager.hpp"
+#include "engine/utils/random.hpp"
+
+namespace selfplay
+{
+    struct Rules
+    {
+        int random_plies = 8;  // Ouverture aléatoire
+        int max_plies = 300;   // Au-delà : nulle
+        int win_cp = 1500;     // Adjudication du gain : |score| >= win_cp pendant win_plies demi-coups
+        int win_plies = 6;
+        int draw_cp = 10; // Adjudication de la nulle après draw_min_ply : |score| <= draw_cp pendant draw_plies demi-coups
+        int draw_plies = 12;
+        int draw_min_ply = 80;
+    };
+
+    // Du point de vue des blancs ; Aborted : partie abandonnée par l'appelant
+    enum Result
+    {
+        BlackWin = -1,
+        Draw = 0,
+        WhiteWin = 1,
+        Aborted = 2
+    };
+
+    // Joue plies coups tirés de rng sur board (moves les reçoit si non nul).
+    // false si une position sans coup légal est atteinte, y compris après le dernier coup.
+    inline bool random_opening(VBoard &board, int plies, std::uint64_t rng, std::vector<Move> *moves = nullptr)
+    {
+        MoveList list;
+        for (int p = 0; p < plies; ++p)
+        {
+            list.count = 0;
+            MoveGen::generate_legal_moves(board, list);
+            if (list.count == 0)
+                return false;
+            rng = engine::random::splitmix64(rng);
+            const Move m = list[static_cast<int>(rng % static_cast<std::uint64_t>(list.count))];
+            board.play(m);
+            if (moves)
+                moves->push_back(m);
+        }
+        list.count = 0;
+        MoveGen::generate_legal_moves(board, list);
+        return list.count > 0;
+    }
+
+    // Coup cherché, transmis à l'appelant avant d'être joué
+    struct Ply
+    {
+        const VBoard &board;
+        int ply;
+        bool in_check;
+        const EngineManager::BenchResult &result;
+        int white_score;
+    };
+
+    // Joue depuis board (au demi-coup first_ply) jusqu'au résultat.
+    // search(board, camp) -> BenchResult ; on_ply(const Ply &) -> false pour abandonner la partie.
+    // on_ply n'est appelé que pour les coups effectivement joués (pas au coup qui déclenche l'adjudication).
+    template <typename Search, typename OnPly>
+    Result play(VBoard &board, int first_ply, const Rules &rules, Search &&search, OnPly &&on_ply)
+    {
+        int win_streak = 0, loss_streak = 0, draw_streak = 0;
+        MoveList list;
+        for (int ply = first_ply;; ++ply)
+        {
+            list.count = 0;
+            MoveGen::generate_legal_moves(board, list);
+            const Color us = board.get_side_to_move();
+            const bool in_check = board.is_king_attacked(us);
+            if (list.count == 0)
+                return in_check ? (us == WHITE ? BlackWin : WhiteWin) : Draw;
+            if (ply >= rules.max_plies || board.is_repetition() || board.get_halfmove_clock() >= 100)
+                return Draw;
+
+            const EngineManager::BenchResult r = search(board, us);
+            if (r.best_move.get_value() == 0)
+                return Draw;
+
+            // Adjudication : gain ou nulle confirmés par plusieurs coups consécutifs
+            const int white_score = (us == WHITE) ? r.score_cp : -r.score_cp;
+            win_streak = (white_score >= rules.win_cp) ? win_streak + 1 : 0;
+            loss_streak = (white_score <= -rules.win_cp) ? loss_streak + 1 : 0;
+            draw_streak = (ply >= rules.draw_min_ply && std::abs(white_score) <= rules.draw_cp) ? draw_streak + 1 : 0;
+            if (win_streak >= rules.win_plies)
+                return WhiteWin;
+            if (loss_streak >= rules.win_plies)
+                return BlackWin;
+            if (draw_streak >= rules.draw_plies)
+                return Draw;
+
+            if (!on_ply(Ply{board, ply, in_check, r, white_score}))
+                return Aborted;
+            board.play(r.best_move);
+        }
+    }
+}
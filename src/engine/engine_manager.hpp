@@ -5,6 +5,7 @@
 #include <thread>
 #include <cmath>
 #include <limits>
+#include <string>
 
 #if defined(__has_include)
 #  if __has_include(<scope>)
@@ -27,6 +28,7 @@
 #include "core/move/generator/move_generator.hpp"
 
 #include "engine/config/config.hpp"
+#include "engine/config/search_params.hpp"
 #include "engine/tt/transp_table.hpp"
 #include "engine/search/worker.hpp"
 #include "engine/eval/tablebase.hpp"
@@ -45,6 +47,10 @@ class EngineManager
     TranspositionTable tt;
     TableBase tb;
     double lmr_table[64][64];
+#ifdef SPSA_TUNING
+    // Paramètres du thread qui a lancé la recherche, repris par chaque thread de recherche
+    search_params::Values search_values;
+#endif
 
     std::jthread search_thread;
     alignas(64) std::atomic<bool> stop_search{false};
@@ -53,6 +59,13 @@ class EngineManager
     alignas(64) std::atomic<long long> total_nodes{0};
     alignas(64) std::atomic<bool> is_infinite{false};
     alignas(64) std::atomic<bool> ponder_enabled{false};
+    std::atomic<long long> node_limit{0};
+    std::atomic<int> depth_limit{0}; // 0 : pas de limite (go depth, bench multi-thread)
+    std::atomic<long long> search_elapsed_ms{1}; // Durée de la dernière recherche start_workers
+    std::atomic<bool> uci_output{true};          // false : start_workers sans info ni bestmove (search_depth)
+    SearchStats collected_stats;                 // Cumul des workers depuis reset_search_stats (SEARCH_STATS)
+    std::string trace_path;                      // Vide : pas de trace (SEARCH_TRACE)
+    size_t trace_mb = 64;                        // Par thread
 
     std::chrono::time_point<std::chrono::steady_clock> start_time;
     std::atomic<int> time_limit{0};
@@ -70,15 +83,61 @@ public:
         long long nodes = 0;
         long long elapsed_ms = 1;
         long long nps = 0;
+        int depth = 0;  // Dernière itération complète (search_nodes)
+        std::string pv; // search_nodes avec with_pv
     };
 
+    inline int get_depth_limit() const
+    {
+        return depth_limit.load(std::memory_order_relaxed);
+    }
+
+    inline bool reports_uci() const
+    {
+        return uci_output.load(std::memory_order_relaxed);
+    }
+
+    // Lus entre deux recherches seulement ; les compteurs de la table des pions y sont recopiés à ce moment
+    inline SearchStats get_search_stats() const
+    {
+        SearchStats stats = collected_stats;
+        const PawnTable &pawns = Eval::get_pawn_table();
+        stats.pawn_hits = pawns.hits;
+        stats.pawn_probes = pawns.hits + pawns.misses;
+        return stats;
+    }
+
+    inline void reset_search_stats()
+    {
+        collected_stats = SearchStats{};
+        Eval::reset_pawn_stats();
+    }
+
+    // Trace de l'arbre (build SEARCH_TRACE) : chaque recherche start_workers réécrit path, un tampon de mb Mio par thread.
+    // Chemin vide : pas de trace.
+    void set_trace(const std::string &path, size_t mb)
+    {
+        trace_path = path;
+        trace_mb = std::max<size_t>(1, mb);
+    }
+
+    inline const std::string &get_trace_path() const
+    {
+        return trace_path;
+    }
+
+    inline int get_threads() const
+    {
+        return num_threads_config;
+    }
+
     inline Move get_root_best_move() const
     {
         return root_best_move.load(std::memory_order_relaxed);
     }
-    EngineManager(VBoard &b) : main_board(b)
+    EngineManager(VBoard &b, size_t hash_mb = 512) : main_board(b)
     {
-        tt.resize(512);
+        tt.resize(hash_mb);
         init_lmr_table();
         root_best_move = 0;
 
@@ -102,7 +161,7 @@ public:
         root_best_move.store(0);
     }
 
-    void start_search(int time_ms = 20000, bool ponder = false, bool infinite = false, bool ponder_enabled = false)
+    void start_search(int time_ms = 20000, bool ponder = false, bool infinite = false, bool ponder_enabled = false, int max_depth = 0)
     {
         stop();
         if (search_thread.joinable())
@@ -121,6 +180,11 @@ public:
         root_best_move.store(0);
 
         time_limit.store(time_ms, std::memory_order_relaxed);
+        depth_limit.store(std::max(0, max_depth), std::memory_order_relaxed);
+#ifdef SPSA_TUNING
+        search_values = search_params::capture();
+        init_lmr_table();
+#endif
         start_time = std::chrono::steady_clock::now();
         search_thread = std::jthread([this]()
                                      { this->start_workers(); });
@@ -131,6 +195,10 @@ public:
         if (stop_search.load(std::memory_order_relaxed))
             return true;
 
+        const long long limit = node_limit.load(std::memory_order_relaxed);
+        if (limit != 0 && total_nodes.load(std::memory_order_relaxed) >= limit)
+            return true;
+
         if (!is_pondering.load() && !is_infinite.load())
         {
             auto now = std::chrono::steady_clock::now();
@@ -167,6 +235,7 @@ public:
 
         // Flush final local node counter to keep statistics accurate.
         total_nodes.fetch_add(worker.local_nodes, std::memory_order_relaxed);
+        collected_stats.add(worker.stats);
 
         return score;
     }
@@ -206,6 +275,7 @@ public:
         }
 
         total_nodes.fetch_add(worker.local_nodes, std::memory_order_relaxed);
+        collected_stats.add(worker.stats);
 
         const long long elapsed = std::max<long long>(1,
                                                       std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -252,6 +322,7 @@ public:
         }
 
         total_nodes.fetch_add(worker.local_nodes, std::memory_order_relaxed);
+        collected_stats.add(worker.stats);
 
         const long long elapsed = std::max<long long>(1,
                                                       std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -268,6 +339,98 @@ public:
         return r;
     }
 
+    // Recherche à nombre de nœuds fixé, sans sortie UCI (génération de données, analyse par lots).
+    // Le compteur est publié tous les 1024 nœuds : le dépassement reste inférieur à 1024 nœuds.
+    // nodes <= 0 : pas de limite de nœuds, la recherche s'arrête après max_depth.
+    BenchResult search_nodes(const VBoard &position, long long nodes, int max_depth = engine_constants::search::MaxDepth - 1, bool with_pv = false)
+    {
+        stop();
+        if (search_thread.joinable())
+            search_thread.join();
+
+        stop_search.store(false, std::memory_order_relaxed);
+        stop_requested.store(false, std::memory_order_relaxed);
+        is_pondering.store(false, std::memory_order_relaxed);
+        is_infinite.store(true, std::memory_order_relaxed);
+        total_nodes.store(0, std::memory_order_relaxed);
+        node_limit.store(std::max(0LL, nodes), std::memory_order_relaxed);
+        tt.next_generation();
+
+        start_time = std::chrono::steady_clock::now();
+        SearchWorker worker(*this, position, tt, tb, stop_search, total_nodes, start_time, time_limit, lmr_table, 0);
+        worker.node_check_mask = 1023;
+
+        int score = 0;
+        int completed = 0;
+        const int last_depth = std::clamp(max_depth, 1, engine_constants::search::MaxDepth - 1);
+        for (int d = 1; d <= last_depth; ++d)
+        {
+            worker.age_history();
+            const int s = worker.negamax_with_aspiration(d, score);
+            if (stop_search.load(std::memory_order_relaxed) && d > 1)
+                break;
+            score = s;
+            completed = d;
+            if (worker.best_root_move.get_value() == 0)
+                worker.best_root_move = worker.out_move;
+            if (should_stop())
+                break;
+        }
+
+        total_nodes.fetch_add(worker.local_nodes, std::memory_order_relaxed);
+        collected_stats.add(worker.stats);
+        node_limit.store(0, std::memory_order_relaxed);
+        is_infinite.store(false, std::memory_order_relaxed);
+
+        const long long elapsed = std::max<long long>(1,
+                                                      std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                          std::chrono::steady_clock::now() - start_time)
+                                                          .count());
+        BenchResult r;
+        r.best_move = worker.best_root_move;
+        r.score_cp = score;
+        r.nodes = total_nodes.load(std::memory_order_relaxed);
+        r.elapsed_ms = elapsed;
+        r.nps = r.nodes * 1000 / elapsed;
+        r.depth = completed;
+        if (with_pv)
+            r.pv = worker.get_pv_line_with_root(r.best_move, completed);
+        return r;
+    }
+
+    // Recherche réelle (start_workers, tous les threads configurés) de main_board jusqu'à depth, bloquante.
+    // Même chemin qu'un go depth, sans sortie UCI (ni info ni bestmove).
+    BenchResult search_depth(int depth)
+    {
+        uci_output.store(false, std::memory_order_relaxed);
+        start_search(std::numeric_limits<int>::max() / 2, false, true, false, std::clamp(depth, 1, engine_constants::search::MaxDepth - 1));
+        wait();
+        uci_output.store(true, std::memory_order_relaxed);
+        depth_limit.store(0, std::memory_order_relaxed);
+        is_infinite.store(false, std::memory_order_relaxed);
+
+        BenchResult r;
+        r.best_move = root_best_move.load(std::memory_order_relaxed);
+        r.nodes = total_nodes.load(std::memory_order_relaxed);
+        r.elapsed_ms = search_elapsed_ms.load(std::memory_order_relaxed);
+        r.nps = r.nodes * 1000 / r.elapsed_ms;
+        r.depth = depth;
+        return r;
+    }
+
+    // Score de quiescence du point de vue du trait, fenêtre pleine.
+    // qtt ne doit contenir que des entrées de quiescence : une entrée de recherche fausserait la comparaison avec l'éval statique.
+    int quiescence_score(const VBoard &position, TranspositionTable &qtt)
+    {
+        std::atomic<bool> no_stop{false};
+        std::atomic<long long> nodes{0};
+        const int no_limit = std::numeric_limits<int>::max() / 2;
+        SearchWorker worker(*this, position, qtt, tb, no_stop, nodes, start_time, no_limit, lmr_table, 1);
+        constexpr int inf = engine_constants::eval::Inf;
+        return position.get_side_to_move() == WHITE ? worker.qsearch<WHITE>(-inf, inf, 0)
+                                                    : worker.qsearch<BLACK>(-inf, inf, 0);
+    }
+
     void convert_ponder_to_real()
     {
         if (stop_search.load(std::memory_order_relaxed))
@@ -318,7 +481,7 @@ public:
         logs::debug << "info string Threads set to " << num_threads_config << std::endl;
     }
 
-private:
+    // Table calculée avec les paramètres LMR du thread courant ; à recalculer s'ils changent
     void init_lmr_table()
     {
         for (int d = 1; d < 64; ++d)
@@ -326,8 +489,19 @@ private:
                 lmr_table[d][m] = engine_constants::search::late_move_reduction::TableInitConst + std::log(d) * std::log(m) / engine_constants::search::late_move_reduction::TableInitDiv;
     }
 
+private:
+    // Sortie UCI de start_workers, coupée pour les recherches silencieuses
+    void uci_line(const std::string &line) const
+    {
+        if (reports_uci())
+            logs::uci << line << std::endl;
+    }
+
     void start_workers()
     {
+#ifdef SPSA_TUNING
+        search_params::apply(search_values);
+#endif
 
         const int num_threads = num_threads_config;
         Move best_move;
@@ -340,11 +514,33 @@ private:
         for (int t = 0; t < num_threads; ++t)
             workers.emplace_back(*this, main_board, tt, tb, stop_search, total_nodes, start_time, time_limit, lmr_table, t);
 
+#ifdef SEARCH_TRACE
+        std::vector<search_trace::Tracer> tracers;
+        if (!trace_path.empty())
+        {
+            // Construits en place : une copie ne garderait pas la réserve du tampon
+            tracers.reserve(num_threads);
+            for (int t = 0; t < num_threads; ++t)
+                tracers.emplace_back(trace_mb * 1024 * 1024 / sizeof(search_trace::Record));
+            for (int t = 0; t < num_threads; ++t)
+                workers[t].tracer = &tracers[t];
+        }
+#endif
+
         std::vector<std::jthread> threads;
         threads.reserve(num_threads);
 
         for (auto &worker : workers)
+        {
+#ifdef SPSA_TUNING
+            threads.emplace_back([this, &worker]()
+                                 {
+                search_params::apply(search_values);
+                worker.iterative_deepening(); });
+#else
             threads.emplace_back(&SearchWorker::iterative_deepening, &worker);
+#endif
+        }
 
         /* for (int t = 0; t < num_threads; ++t)
         {
@@ -357,19 +553,35 @@ private:
         for (auto &th : threads)
             th.join();
 
+        // Reliquat des compteurs locaux (publiés tous les node_check_mask + 1 nœuds)
+        for (const SearchWorker &worker : workers)
+        {
+            total_nodes.fetch_add(worker.local_nodes, std::memory_order_relaxed);
+            collected_stats.add(worker.stats);
+        }
+        search_elapsed_ms.store(std::max<long long>(1, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                           std::chrono::steady_clock::now() - start_time)
+                                                           .count()),
+                                std::memory_order_relaxed);
+
+#ifdef SEARCH_TRACE
+        if (!tracers.empty() && !search_trace::write(trace_path, tracers, main_board.get_hash()))
+            logs::uci << "info string error: cannot write trace " << trace_path << std::endl;
+#endif
+
         best_move = workers[0].best_root_move;
 
         if (best_move.get_value() == 0) [[unlikely]]
         {
-            logs::uci << "PANICK MODE" << std::endl;
+            uci_line("PANICK MODE");
             // Panick mode : we try to find the best possible legal move
             // First attempt : transp table
             best_move = tt.get_move(main_board.get_hash());
             if (main_board.is_move_pseudo_legal(best_move) && main_board.is_move_legal(best_move))
             {
-                logs::uci << "Resolved : TT" << std::endl;
+                uci_line("Resolved : TT");
                 root_best_move.store(best_move, std::memory_order_relaxed);
-                logs::uci << "bestmove " << best_move.to_uci() << std::endl;
+                uci_line("bestmove " + best_move.to_uci());
                 return;
             }
             // Second attempt : we pick the best move from another thread
@@ -377,9 +589,9 @@ private:
             {
                 if (workers[w].best_root_move != 0)
                 {
-                    logs::uci << "Resolved : Worker " << w << std::endl;
+                    uci_line("Resolved : Worker " + std::to_string(w));
                     root_best_move.store(workers[w].best_root_move, std::memory_order_relaxed);
-                    logs::uci << "bestmove " << workers[w].best_root_move.to_uci() << std::endl;
+                    uci_line("bestmove " + workers[w].best_root_move.to_uci());
                     return;
                 }
             }
@@ -387,8 +599,12 @@ private:
             // Third attempt : we pick the most promising move
             MoveList list;
             MoveGen::generate_legal_moves(main_board, list);
+            CheckInfo check_info;
+            const bool white = main_board.get_side_to_move() == WHITE;
+            white ? main_board.compute_check_info<WHITE>(check_info) : main_board.compute_check_info<BLACK>(check_info);
             for (int i = 0; i < list.size(); ++i)
-                main_board.get_side_to_move() == WHITE ? list.scores[i] = workers[0].score_move<WHITE>(list.moves[i], 0, 0, 0) : workers[0].score_move<BLACK>(list.moves[i], 0, 0, 0);
+                list.scores[i] = white ? workers[0].score_move<WHITE>(list.moves[i], 0, 0, 0, check_info)
+                                       : workers[0].score_move<BLACK>(list.moves[i], 0, 0, 0, check_info);
 
             if (list.count > 0) [[likely]]
             {
@@ -399,7 +615,7 @@ private:
             {
                 // Vraiment aucun coup (Mat ou Pat)
                 // UCI requiert "bestmove (none)" dans certains cas, ou juste null
-                logs::uci << "bestmove (none)" << std::endl;
+                uci_line("bestmove (none)");
                 root_best_move.store(0, std::memory_order_relaxed);
                 return;
             }
@@ -423,10 +639,10 @@ private:
             Move second_move = tt.get_move(main_board.get_hash());
             if (main_board.is_move_pseudo_legal(second_move) && main_board.is_move_legal(second_move))
             {
-                logs::uci << "bestmove " << best_move.to_uci() << " ponder " << second_move.to_uci() << std::endl;
+                uci_line("bestmove " + best_move.to_uci() + " ponder " + second_move.to_uci());
                 return;
             }
         }
-        logs::uci << "bestmove " << best_move.to_uci() << std::endl;
+        uci_line("bestmove " + best_move.to_uci());
     }
 };
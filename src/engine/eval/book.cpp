@@ -1,51 +1,90 @@
 #include "engine/eval/book.hpp"
-#include "core/move/generator/move_generator.hpp"
 
 #include "common/logger.hpp"
+#include "engine/utils/random.hpp"
 
-#include <random>
-#include <fstream>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <fstream>
 
-std::vector<Book::Entry> Book::entries;
+file::MappedFile Book::mapping;
+std::span<const Book::Entry> Book::entries;
 
 void Book::init(const std::string &path)
 {
-    entries.clear();
-    std::ifstream file(path, std::ios::binary);
-
-    if (!file.is_open())
+    entries = {};
+    if (!mapping.open(path, file::Access::Random))
     {
         logs::debug << "info string book disabled (missing file): " << path << std::endl;
         return;
     }
 
-    file.seekg(0, std::ios::end);
-    size_t file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    if (file_size < sizeof(Entry))
+    // Un fichier tronqué perd seulement sa dernière entrée incomplète
+    const size_t num_entries = mapping.size() / sizeof(Entry);
+    if (num_entries == 0)
+    {
+        mapping.close();
         return;
+    }
+    entries = {reinterpret_cast<const Entry *>(mapping.data()), num_entries};
 
-    size_t num_entries = file_size / sizeof(Entry);
-    entries.resize(num_entries);
-    file.read(reinterpret_cast<char *>(entries.data()), file_size);
-    file.close();
+    logs::debug << ">>> SUCCES BOOK: " << num_entries << " coups projetés." << std::endl;
+}
+
+void Book::close()
+{
+    entries = {};
+    mapping.close();
+}
+
+bool Book::read_records(const std::string &path, std::vector<Record> &out)
+{
+    out.clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
 
-    // 1. Endianness conversion
-    for (auto &e : entries)
+    Entry e;
+    while (in.read(reinterpret_cast<char *>(&e), sizeof(Entry)))
     {
-        e.key = swap_endian_64(e.key);
-        e.move = swap_endian_16(e.move);
-        e.weight = swap_endian_16(e.weight);
-        e.learn = swap_endian_32(e.learn);
+        uint32_t learn = e.learn;
+        if constexpr (std::endian::native == std::endian::little)
+            learn = swap_endian_32(learn);
+        out.push_back({key_of(e), move_of(e), weight_of(e), learn});
     }
+    return true;
+}
+
+bool Book::write_records(const std::string &path, std::vector<Record> records)
+{
+    std::sort(records.begin(), records.end(), [](const Record &a, const Record &b)
+              { return a.key != b.key ? a.key < b.key : a.weight > b.weight; });
 
-    // 2. Dichotimie sort
-    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
-              { return a.key < b.key; });
+    std::vector<Entry> data(records.size());
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const Record &r = records[i];
+        if constexpr (std::endian::native == std::endian::little)
+            data[i] = {swap_endian_64(r.key), swap_endian_16(r.move), swap_endian_16(r.weight), swap_endian_32(r.learn)};
+        else
+            data[i] = {r.key, r.move, r.weight, r.learn};
+    }
 
-    logs::debug << ">>> SUCCES BOOK: " << num_entries << " coups chargés." << std::endl;
+    // Un lecteur (ou un livre projeté) garde l'ancien fichier jusqu'au renommage
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        out.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(Entry)));
+        if (!out)
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
 }
 
 uint16_t Book::swap_endian_16(uint16_t val) { return (val << 8) | (val >> 8); }
@@ -61,109 +100,110 @@ uint64_t Book::swap_endian_64(uint64_t val)
     return (val << 32) | (val >> 32);
 }
 
-Move Book::probe(Board &board)
+uint64_t Book::key_of(const Entry &e)
+{
+    if constexpr (std::endian::native == std::endian::little)
+        return swap_endian_64(e.key);
+    return e.key;
+}
+uint16_t Book::move_of(const Entry &e)
+{
+    if constexpr (std::endian::native == std::endian::little)
+        return swap_endian_16(e.move);
+    return e.move;
+}
+uint16_t Book::weight_of(const Entry &e)
+{
+    if constexpr (std::endian::native == std::endian::little)
+        return swap_endian_16(e.weight);
+    return e.weight;
+}
+
+Move Book::decode(uint16_t poly_move, const Board &board)
+{
+    // Bits 0-5 : arrivée, 6-11 : départ, 12-14 : promotion
+    static constexpr Piece promo_pieces[8] = {NO_PIECE, KNIGHT, BISHOP, ROOK, QUEEN, NO_PIECE, NO_PIECE, NO_PIECE};
+    const int from = (poly_move >> 6) & 0x3F;
+    int to = poly_move & 0x3F;
+
+    // Roque Polyglot : le roi « prend » sa propre tour (e1h1, e1a1) ; le moteur attend g1 / c1
+    if (board.get_p(from) == KING && board.get_p(to) == ROOK && board.get_c(from) == board.get_c(to))
+        to = (to > from) ? from + 2 : from - 2;
+
+    const auto m = Board::move_from_squares(from, to, promo_pieces[(poly_move >> 12) & 0x7], board);
+    return m ? *m : Move();
+}
+
+uint16_t Book::encode(Move move)
+{
+    const int from = move.get_from_sq();
+    int to = move.get_to_sq();
+    if (move.is_castling())
+        to = (to > from) ? to + 1 : to - 2;
+    const int promo = move.is_promotion() ? static_cast<int>(move.get_promo_piece()) : 0; // KNIGHT=1 ... QUEEN=4
+    return static_cast<uint16_t>((promo << 12) | (from << 6) | to);
+}
+
+Move Book::probe(Board &board, std::uint64_t &rng)
 {
     if (entries.empty())
         return Move();
 
-    uint64_t key = board.polyglot_key();
+    const uint64_t key = board.polyglot_key();
 
     // 1. Recherche binaire
     auto it = std::lower_bound(entries.begin(), entries.end(), key,
                                [](const Entry &e, uint64_t k)
-                               { return e.key < k; });
+                               { return key_of(e) < k; });
 
     // Si pas trouvé
-    if (it == entries.end() || it->key != key)
+    if (it == entries.end() || key_of(*it) != key)
         return Move();
 
-    // 2. Récupérer les coups RAW (uint16_t) candidats
-    std::vector<std::pair<uint16_t, int>> candidates;
+    // 2. Coups candidats, dans un tampon de taille fixe
+    struct Candidate
+    {
+        uint16_t move;
+        uint16_t weight;
+    };
+    std::array<Candidate, MaxCandidates> candidates;
+    int count = 0;
     int total_weight = 0;
 
-    for (; it != entries.end() && it->key == key; ++it)
+    for (; it != entries.end() && key_of(*it) == key && count < MaxCandidates; ++it)
     {
-        if (it->weight > 0)
+        const uint16_t weight = weight_of(*it);
+        if (weight > 0)
         {
-            candidates.push_back({it->move, it->weight});
-            total_weight += it->weight;
+            candidates[count++] = {move_of(*it), weight};
+            total_weight += weight;
         }
     }
 
-    if (candidates.empty())
+    if (count == 0)
         return Move();
 
     // 3. Sélection pondérée
-    static std::mt19937 gen(std::random_device{}());
-    std::uniform_int_distribution<int> dist(0, total_weight - 1);
-    int pick = dist(gen);
-    int current = 0;
-    uint16_t selected_poly_move = 0;
-
-    for (const auto &pair : candidates)
+    rng = engine::random::splitmix64(rng);
+    int pick = static_cast<int>(rng % static_cast<uint64_t>(total_weight));
+    int selected = count - 1;
+    for (int i = 0; i < count; ++i)
     {
-        current += pair.second;
-        if (pick < current)
+        if (pick < candidates[i].weight)
         {
-            selected_poly_move = pair.first;
+            selected = i;
             break;
         }
+        pick -= candidates[i].weight;
     }
-    // Fallback
-    if (selected_poly_move == 0)
-        selected_poly_move = candidates.back().first;
 
-    // =========================================================
-    // 4. MATCHING AVEC LE GÉNÉRATEUR DU MOTEUR
-    // =========================================================
-
-    // Décodage Polyglot
-    int target_to = (selected_poly_move >> 0) & 0x3F;   // <--- Bits 0-5 = TO
-    int target_from = (selected_poly_move >> 6) & 0x3F; // <--- Bits 6-11 = FROM
-    int promo_code = (selected_poly_move >> 12) & 0x7;
-
-    Piece target_promo = NO_PIECE;
-    switch (promo_code)
-    {
-    case 1:
-        target_promo = KNIGHT;
-        break;
-    case 2:
-        target_promo = BISHOP;
-        break;
-    case 3:
-        target_promo = ROOK;
-        break;
-    case 4:
-        target_promo = QUEEN;
-        break;
-    }
-
-    MoveList moves;
-    MoveGen::generate_legal_moves(board, moves);
-
-    for (const auto &m : moves)
+    // 4. Décodage direct ; une collision de clé peut donner un coup illégal
+    const Move m = decode(candidates[selected].move, board);
+    if (m.get_value() == 0 || !board.is_move_pseudo_legal(m) || !board.is_move_legal(m))
     {
-        if (m.get_from_sq() == target_from && m.get_to_sq() == target_to)
-        {
-
-            if (target_promo != NO_PIECE)
-            {
-                if (m.is_promotion() && m.get_promo_piece() == target_promo)
-                {
-                    logs::debug << "info string DEBUG: Book Move Matches Engine Move: " << m.to_uci() << std::endl;
-                    return m;
-                }
-            }
-            else
-            {
-                logs::debug << "info string DEBUG: Book Move Matches Engine Move: " << m.to_uci() << std::endl;
-                return m;
-            }
-        }
+        logs::debug << "info string DEBUG: Book move " << candidates[selected].move << " is not legal here" << std::endl;
+        return Move();
     }
-    logs::debug << "DEBUG: Book Move (" << target_from << "->" << target_to
-                << ") not found in engine !";
-
-    return Move(); // Coup vide
-}
\ No newline at end of file
+    logs::debug << "info string DEBUG: Book move " << m.to_uci() << std::endl;
+    return m;
+}
@@ -1,19 +1,57 @@
 #pragma once
 #include <cctype>
+#include <cstdint>
+#include <span>
+#include <string>
 #include <vector>
 
+#include "common/mapped_file.hpp"
 #include "core/move/move.hpp"
 #include "core/board/board.hpp"
 
+// Livre Polyglot projeté en mémoire en lecture seule : aucune copie ni tri au démarrage.
+// Les entrées restent en big-endian et sont triées par clé (format Polyglot) ; la recherche
+// dichotomique se fait en place. Les pages sont partagées entre les processus du même hôte.
 class Book
 {
 public:
-    // Charge tout le fichier en mémoire au démarrage.
+    // Projette le fichier ; livre désactivé s'il est absent ou vide.
     // A appeler dans le main() !
     static void init(const std::string &path);
 
-    // Recherche instantanée en mémoire
-    static Move probe(Board &board);
+    // Recherche dichotomique directement dans le fichier projeté, puis tirage pondéré par le poids.
+    // rng : état du générateur, propre à l'appelant (pas d'état partagé entre threads).
+    // Retourne un coup légal, ou un coup nul.
+    static Move probe(Board &board, std::uint64_t &rng);
+
+    // Coup Polyglot vers coup interne par lecture du mailbox, sans génération de coups (non vérifié)
+    static Move decode(uint16_t poly_move, const Board &board);
+
+    // Coup interne vers coup Polyglot (roque : le roi vers sa tour)
+    static uint16_t encode(Move move);
+
+    // Au-delà, les entrées d'une même position sont ignorées (plus que de coups légaux possibles)
+    static constexpr int MaxCandidates = 256;
+
+    static std::size_t size() { return entries.size(); }
+
+    // Désactive le livre
+    static void close();
+
+    // Entrée dans l'ordre de la machine, pour écrire un livre (bookgen)
+    struct Record
+    {
+        uint64_t key;
+        uint16_t move;
+        uint16_t weight;
+        uint32_t learn;
+    };
+
+    // Lit toutes les entrées d'un fichier Polyglot ; false si le fichier est absent
+    static bool read_records(const std::string &path, std::vector<Record> &out);
+
+    // Trie par clé puis poids décroissant et écrit au format Polyglot (fichier temporaire puis renommage)
+    static bool write_records(const std::string &path, std::vector<Record> records);
 
 private:
 // Structure alignée sur 1 octet pour correspondre au binaire
@@ -27,13 +65,17 @@ private:
     };
 #pragma pack(pop)
 
-    // Stockage de tout le livre en RAM
-    static std::vector<Entry> entries;
+    static file::MappedFile mapping;
+    // Vue sur les entrées du fichier, telles qu'écrites sur le disque (big-endian)
+    static std::span<const Entry> entries;
 
     // Utilitaires endianness
     static uint16_t swap_endian_16(uint16_t val);
     static uint32_t swap_endian_32(uint32_t val);
     static uint64_t swap_endian_64(uint64_t val);
 
-    static Move convert_poly_move_to_internal(uint16_t poly_move, const Board &board);
+    // Champs big-endian du fichier vers l'ordre de la machine
+    static uint64_t key_of(const Entry &e);
+    static uint16_t move_of(const Entry &e);
+    static uint16_t weight_of(const Entry &e);
 };
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "engine/eval/eval_params.hpp"
+
+#include "engine/config/eval.hpp"
+#include "engine/eval/pos_eval.hpp"
+#include "engine/utils/random.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    template <typename T>
+    std::int16_t to_param(const T &x)
+    {
+        return static_cast<std::int16_t>(std::lround(static_cast<double>(x)));
+    }
+
+    Eval::ParamSet make_defaults()
+    {
+        using namespace engine_constants::eval;
+        using namespace Eval::Layout;
+
+        Eval::ParamSet p;
+        p[DoubledMg] = to_param(doubledFilesMgMalus);
+        p[DoubledEg] = to_param(doubledFilesEgMalus);
+        p[IsolatedMg] = to_param(isolatedFilesMgMalus);
+        p[IsolatedEg] = to_param(isolatedFilesEgMalus);
+        p[OpenFile] = to_param(openFileMalus);
+        p[SemiOpenFile] = to_param(semiOpenFileMalus);
+        p[HeavyOpen] = to_param(heavyEnemiesOpenFileMalus);
+        p[HeavySemiOpen] = to_param(heavyEnemiesSemiOpenFileMalus);
+        p[BishopPairMg] = to_param(bishopPairMgBonus);
+        p[BishopPairEg] = to_param(bishopPairEgBonus);
+        p[KingDistCenter] = to_param(kingDistFromCenterBonus);
+        p[KingCloseness] = to_param(closeKingBonus);
+        for (int k = 0; k < 8; ++k)
+        {
+            p[PassedMg + k] = to_param(passed_bonus_mg[k]);
+            p[PassedEg + k] = to_param(passed_bonus_eg[k]);
+        }
+        for (int k = 0; k < 9; ++k)
+            p[KnightMob + k] = to_param(knight_mob[k]);
+        for (int k = 0; k < 14; ++k)
+            p[BishopMob + k] = to_param(bishop_mob[k]);
+        for (int k = 0; k < 15; ++k)
+            p[RookMob + k] = to_param(rook_mob[k]);
+        for (int k = 0; k < 28; ++k)
+            p[QueenMob + k] = to_param(queen_mob[k]);
+        for (int piece = 0; piece < constants::PieceTypeCount; ++piece)
+        {
+            p[Material + piece] = to_param(pieces_score[piece]);
+            for (int sq = 0; sq < constants::BoardSize; ++sq)
+            {
+                p[MgPst + piece * constants::BoardSize + sq] = to_param(mg_tables[piece][sq]);
+                p[EgPst + piece * constants::BoardSize + sq] = to_param(eg_tables[piece][sq]);
+            }
+        }
+        return p;
+    }
+
+    const Eval::ParamSet defaults = make_defaults();
+}
+
+Eval::ParamSet Eval::active_params = defaults;
+
+const Eval::ParamSet &Eval::default_params()
+{
+    return defaults;
+}
+
+const Eval::ParamSet &Eval::current_params()
+{
+    return active_params;
+}
+
+void Eval::set_params(const ParamSet &p)
+{
+    active_params = p;
+    clear_pawn_table();
+}
+
+std::uint64_t Eval::params_hash(const ParamSet &p)
+{
+    return engine::random::hash_bytes(p.v, sizeof(p.v));
+}
+
+void Eval::reset_params()
+{
+    set_params(defaults);
+}
+
+bool Eval::read_params(const std::string &path, ParamSet &out)
+{
+    std::FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+
+    std::uint32_t header[3] = {};
+    ParamSet p;
+    char extra;
+    const bool ok = std::fread(header, sizeof(header), 1, f) == 1 &&
+                    header[0] == ParamSet::Magic && header[1] == ParamSet::Version &&
+                    header[2] == static_cast<std::uint32_t>(Layout::Count) &&
+                    std::fread(p.v, sizeof(std::int16_t), Layout::Count, f) == static_cast<std::size_t>(Layout::Count) &&
+                    std::fread(&extra, 1, 1, f) == 0;
+    std::fclose(f);
+    if (ok)
+        out = p;
+    return ok;
+}
+
+bool Eval::save_params(const std::string &path, const ParamSet &p)
+{
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+
+    const std::uint32_t header[3] = {ParamSet::Magic, ParamSet::Version, static_cast<std::uint32_t>(Layout::Count)};
+    const bool ok = std::fwrite(header, sizeof(header), 1, f) == 1 &&
+                    std::fwrite(p.v, sizeof(std::int16_t), Layout::Count, f) == static_cast<std::size_t>(Layout::Count);
+    return std::fclose(f) == 0 && ok;
+}
+
+bool Eval::load_params(const std::string &path)
+{
+    ParamSet p;
+    if (!read_params(path, p))
+        return false;
+    set_params(p);
+    return true;
+}
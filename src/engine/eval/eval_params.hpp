@@ -0,0 +1,77 @@
+#pragma once
+
+// Paramètres de l'éval classique sous forme d'un tableau plat d'int16, rechargeable à chaud.
+// L'éval lit tout via Eval::params() : un tableau global à adresse fixe, aligné sur une ligne de cache.
+// Les valeurs par défaut viennent de engine/config/eval.hpp ; un fichier binaire (.bin) peut les
+// remplacer au démarrage (--params) ou par setoption name EvalParams, sans recompiler.
+//
+// Format : magic "C26P", version, nombre de paramètres (uint32 little-endian), puis Count int16.
+
+#include <cstdint>
+#include <string>
+
+#include "common/constants.hpp"
+
+namespace Eval
+{
+    // Disposition du tableau de paramètres (partagée avec le tuner Texel)
+    namespace Layout
+    {
+        constexpr int DoubledMg = 0;
+        constexpr int DoubledEg = 1;
+        constexpr int IsolatedMg = 2;
+        constexpr int IsolatedEg = 3;
+        constexpr int OpenFile = 4;
+        constexpr int SemiOpenFile = 5;
+        constexpr int HeavyOpen = 6;
+        constexpr int HeavySemiOpen = 7;
+        constexpr int BishopPairMg = 8;
+        constexpr int BishopPairEg = 9;
+        constexpr int KingDistCenter = 10;
+        constexpr int KingCloseness = 11;
+        constexpr int PassedMg = 12;
+        constexpr int PassedEg = PassedMg + 8;
+        constexpr int KnightMob = PassedEg + 8;
+        constexpr int BishopMob = KnightMob + 9;
+        constexpr int RookMob = BishopMob + 14;
+        constexpr int QueenMob = RookMob + 15;
+        constexpr int Material = QueenMob + 28;
+        constexpr int MgPst = Material + constants::PieceTypeCount;
+        constexpr int EgPst = MgPst + constants::PieceTypeCount * constants::BoardSize;
+        constexpr int Count = EgPst + constants::PieceTypeCount * constants::BoardSize;
+    }
+
+    struct alignas(64) ParamSet
+    {
+        static constexpr std::uint32_t Magic = 0x50363243; // "C26P"
+        static constexpr std::uint32_t Version = 1;
+        static constexpr int Padded = (Layout::Count + 31) & ~31;
+
+        std::int16_t v[Padded] = {};
+
+        std::int16_t &operator[](int i) { return v[i]; }
+        std::int16_t operator[](int i) const { return v[i]; }
+    };
+
+    // Jeu actif ; ne change qu'entre deux recherches (set_params copie dedans, l'adresse ne bouge pas)
+    extern ParamSet active_params;
+
+    inline const std::int16_t *params() { return active_params.v; }
+
+    // Valeurs compilées de engine/config/eval.hpp
+    const ParamSet &default_params();
+    const ParamSet &current_params();
+
+    // Remplace le jeu actif (vide la table de pions). Les EvalState existants doivent être recalculés
+    // et la TT vidée par l'appelant (scores calculés avec l'ancien jeu).
+    void set_params(const ParamSet &p);
+    void reset_params();
+
+    std::uint64_t params_hash(const ParamSet &p);
+
+    bool read_params(const std::string &path, ParamSet &out);
+    bool save_params(const std::string &path, const ParamSet &p);
+
+    // Lit et active ; le jeu actif est inchangé en cas d'échec
+    bool load_params(const std::string &path);
+}
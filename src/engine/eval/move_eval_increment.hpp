@@ -6,6 +6,7 @@
 #include "core/piece/piece.hpp"
 #include "core/move/move.hpp"
 #include "engine/config/eval.hpp"
+#include "engine/eval/eval_params.hpp"
 #include "core/board/zobrist.hpp"
 
 struct EvalState
@@ -156,12 +157,13 @@ private:
         int mirror = (c == WHITE) ? sq : sq ^ 56;
 
         // Utilisation des tables respectives MG et EG
-        int pst_mg = engine_constants::eval::mg_tables[p][mirror];
-        int pst_eg = engine_constants::eval::eg_tables[p][mirror];
+        const std::int16_t *P = Eval::params();
+        int pst_mg = P[Eval::Layout::MgPst + p * constants::BoardSize + mirror];
+        int pst_eg = P[Eval::Layout::EgPst + p * constants::BoardSize + mirror];
 
         mg_pst[c] += pst_mg;
         eg_pst[c] += pst_eg;
-        pieces_val[c] += engine_constants::eval::pieces_score[p];
+        pieces_val[c] += P[Eval::Layout::Material + p];
 
         if (p == PAWN)
             pawn_key ^= zobrist_table[PAWN + (c == BLACK ? 6 : 0)][sq];
@@ -171,12 +173,13 @@ private:
     {
         int mirror = (c == WHITE) ? sq : sq ^ 56;
 
-        int pst_mg = engine_constants::eval::mg_tables[p][mirror];
-        int pst_eg = engine_constants::eval::eg_tables[p][mirror];
+        const std::int16_t *P = Eval::params();
+        int pst_mg = P[Eval::Layout::MgPst + p * constants::BoardSize + mirror];
+        int pst_eg = P[Eval::Layout::EgPst + p * constants::BoardSize + mirror];
 
         mg_pst[c] -= pst_mg;
         eg_pst[c] -= pst_eg;
-        pieces_val[c] -= engine_constants::eval::pieces_score[p];
+        pieces_val[c] -= P[Eval::Layout::Material + p];
 
         if (p == PAWN)
             pawn_key ^= zobrist_table[PAWN + (c == BLACK ? 6 : 0)][sq];
@@ -0,0 +1,388 @@
+#include "engine/eval/nnue.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+#if defined(__AVX512BW__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "common/cpu.hpp"
+#include "common/logger.hpp"
+#include "core/board/board.hpp"
+#include "engine/config/config.hpp"
+#include "engine/utils/random.hpp"
+
+NNUE::Network NNUE::network;
+bool NNUE::loaded = false;
+std::uint64_t NNUE::network_hash = 0;
+bool NNUE::bucketed = false;
+
+// =============================== Noyaux SIMD ===============================
+// update_rows : dst[i] = src[i] + somme des lignes ajoutées - somme des lignes retirées (dst peut être src)
+// dot_crelu   : somme de clamp(acc[i], 0, QA) * w[i] en int32
+
+static_assert(NNUE::HiddenSize % 32 == 0, "HiddenSize must be a multiple of the widest SIMD register");
+
+static inline void update_rows(int16_t *dst, const int16_t *src, const int16_t *const *adds, int n_add, const int16_t *const *subs, int n_sub)
+{
+#if defined(__AVX512BW__)
+    for (int i = 0; i < NNUE::HiddenSize; i += 32)
+    {
+        __m512i v = _mm512_load_si512(src + i);
+        for (int a = 0; a < n_add; ++a)
+            v = _mm512_add_epi16(v, _mm512_load_si512(adds[a] + i));
+        for (int s = 0; s < n_sub; ++s)
+            v = _mm512_sub_epi16(v, _mm512_load_si512(subs[s] + i));
+        _mm512_store_si512(dst + i, v);
+    }
+#elif defined(__AVX2__)
+    for (int i = 0; i < NNUE::HiddenSize; i += 16)
+    {
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i *>(src + i));
+        for (int a = 0; a < n_add; ++a)
+            v = _mm256_add_epi16(v, _mm256_load_si256(reinterpret_cast<const __m256i *>(adds[a] + i)));
+        for (int s = 0; s < n_sub; ++s)
+            v = _mm256_sub_epi16(v, _mm256_load_si256(reinterpret_cast<const __m256i *>(subs[s] + i)));
+        _mm256_store_si256(reinterpret_cast<__m256i *>(dst + i), v);
+    }
+#elif defined(__ARM_NEON)
+    for (int i = 0; i < NNUE::HiddenSize; i += 8)
+    {
+        int16x8_t v = vld1q_s16(src + i);
+        for (int a = 0; a < n_add; ++a)
+            v = vaddq_s16(v, vld1q_s16(adds[a] + i));
+        for (int s = 0; s < n_sub; ++s)
+            v = vsubq_s16(v, vld1q_s16(subs[s] + i));
+        vst1q_s16(dst + i, v);
+    }
+#else
+    for (int i = 0; i < NNUE::HiddenSize; ++i)
+    {
+        int16_t v = src[i];
+        for (int a = 0; a < n_add; ++a)
+            v = static_cast<int16_t>(v + adds[a][i]);
+        for (int s = 0; s < n_sub; ++s)
+            v = static_cast<int16_t>(v - subs[s][i]);
+        dst[i] = v;
+    }
+#endif
+}
+
+static inline int dot_crelu(const int16_t *acc, const int16_t *weights)
+{
+#if defined(__AVX512BW__)
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i qa = _mm512_set1_epi16(NNUE::QA);
+    __m512i sum = _mm512_setzero_si512();
+    for (int i = 0; i < NNUE::HiddenSize; i += 32)
+    {
+        const __m512i x = _mm512_min_epi16(_mm512_max_epi16(_mm512_load_si512(acc + i), zero), qa);
+        sum = _mm512_add_epi32(sum, _mm512_madd_epi16(x, _mm512_load_si512(weights + i)));
+    }
+    alignas(64) int32_t lanes[16];
+    _mm512_store_si512(lanes, sum);
+    int total = 0;
+    for (int i = 0; i < 16; ++i)
+        total += lanes[i];
+    return total;
+#elif defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i qa = _mm256_set1_epi16(NNUE::QA);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < NNUE::HiddenSize; i += 16)
+    {
+        const __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i *>(acc + i));
+        const __m256i x = _mm256_min_epi16(_mm256_max_epi16(v, zero), qa);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(x, _mm256_load_si256(reinterpret_cast<const __m256i *>(weights + i))));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+#elif defined(__ARM_NEON)
+    const int16x8_t zero = vdupq_n_s16(0);
+    const int16x8_t qa = vdupq_n_s16(NNUE::QA);
+    int32x4_t sum = vdupq_n_s32(0);
+    for (int i = 0; i < NNUE::HiddenSize; i += 8)
+    {
+        const int16x8_t x = vminq_s16(vmaxq_s16(vld1q_s16(acc + i), zero), qa);
+        const int16x8_t w = vld1q_s16(weights + i);
+        sum = vmlal_s16(sum, vget_low_s16(x), vget_low_s16(w));
+        sum = vmlal_high_s16(sum, x, w);
+    }
+    return vaddvq_s32(sum);
+#else
+    int sum = 0;
+    for (int i = 0; i < NNUE::HiddenSize; ++i)
+        sum += std::clamp<int>(acc[i], 0, NNUE::QA) * weights[i];
+    return sum;
+#endif
+}
+
+// =============================== Chargement ===============================
+
+bool NNUE::load(const std::string &path)
+{
+    // Lecture dans un réseau temporaire : un fichier invalide laisse le réseau courant en place
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        logs::error << "info string NNUE: cannot open " << path << std::endl;
+        return false;
+    }
+
+    file.seekg(0, std::ios::end);
+    const size_t size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    // bullet complète le fichier à un multiple de 64 octets
+    auto matches = [size](size_t expected)
+    { return size >= expected && size < expected + 64; };
+
+    int buckets;
+    if (matches(FileSize))
+        buckets = 1;
+    else if (matches(BucketedFileSize))
+        buckets = KingBucketCount;
+    else
+    {
+        logs::error << "info string NNUE: " << path << " has " << size << " bytes, expected " << FileSize
+                    << " (768 -> " << HiddenSize << " x2 -> 1) or " << BucketedFileSize
+                    << " (" << KingBucketCount << " king buckets)" << std::endl;
+        return false;
+    }
+
+    auto candidate = std::make_unique<Network>();
+    file.read(reinterpret_cast<char *>(candidate->feature_weights), sizeof(int16_t) * buckets * InputSize * HiddenSize);
+    file.read(reinterpret_cast<char *>(candidate->feature_bias), sizeof(candidate->feature_bias));
+    file.read(reinterpret_cast<char *>(candidate->output_weights), sizeof(candidate->output_weights));
+    file.read(reinterpret_cast<char *>(&candidate->output_bias), sizeof(candidate->output_bias));
+    if (!file)
+    {
+        logs::error << "info string NNUE: read error on " << path << std::endl;
+        return false;
+    }
+
+    network = *candidate;
+    network_hash = engine::random::hash_bytes(candidate.get(), sizeof(Network));
+    bucketed = (buckets > 1);
+    loaded = true;
+    logs::debug << "info string NNUE loaded: " << path << (bucketed ? " (king buckets)" : "") << std::endl;
+    return true;
+}
+
+void NNUE::unload()
+{
+    loaded = false;
+}
+
+// =============================== Accumulateurs ===============================
+
+static inline const int16_t *feature_row(Color perspective, int king_sq, Color c, Piece p, int sq)
+{
+    return NNUE::network.feature_weights + NNUE::feature_index(perspective, king_sq, c, p, sq) * NNUE::HiddenSize;
+}
+
+void NNUE::refresh(Accumulator &acc, const Board &board)
+{
+    for (int persp = WHITE; persp <= BLACK; ++persp)
+    {
+        int16_t *values = acc.values[persp];
+        const int king_sq = board.king_sq[persp];
+        std::memcpy(values, network.feature_bias, sizeof(network.feature_bias));
+
+        for (int c = WHITE; c <= BLACK; ++c)
+        {
+            for (int p = PAWN; p <= KING; ++p)
+            {
+                U64 bb = board.get_piece_bitboard(static_cast<Color>(c), static_cast<Piece>(p));
+                while (bb)
+                {
+                    const int16_t *row = feature_row(static_cast<Color>(persp), king_sq, static_cast<Color>(c), static_cast<Piece>(p), cpu::pop_lsb(bb));
+                    update_rows(values, values, &row, 1, nullptr, 0);
+                }
+            }
+        }
+    }
+}
+
+static inline NNUE::FeatureDelta move_delta(const Move &m, Color us)
+{
+    NNUE::FeatureDelta d{};
+    auto add = [&d](Color c, Piece p, int sq)
+    {
+        d.add_c[d.n_add] = c;
+        d.add_p[d.n_add] = p;
+        d.add_sq[d.n_add++] = sq;
+    };
+    auto sub = [&d](Color c, Piece p, int sq)
+    {
+        d.sub_c[d.n_sub] = c;
+        d.sub_p[d.n_sub] = p;
+        d.sub_sq[d.n_sub++] = sq;
+    };
+
+    const Color them = (Color)!us;
+    const int from_sq = m.get_from_sq();
+    const int to_sq = m.get_to_sq();
+    const uint32_t flags = m.get_flags();
+
+    sub(us, m.get_from_piece(), from_sq);
+    add(us, m.is_promotion() ? m.get_promo_piece() : m.get_from_piece(), to_sq);
+
+    if (flags == Move::Flags::EN_PASSANT_CAP)
+        sub(them, PAWN, (us == WHITE) ? to_sq - 8 : to_sq + 8);
+    else if (m.get_to_piece() != NO_PIECE)
+        sub(them, m.get_to_piece(), to_sq);
+    else if (flags == Move::Flags::KING_CASTLE)
+    {
+        sub(us, ROOK, (us == WHITE) ? Square::h1 : Square::h8);
+        add(us, ROOK, (us == WHITE) ? Square::f1 : Square::f8);
+    }
+    else if (flags == Move::Flags::QUEEN_CASTLE)
+    {
+        sub(us, ROOK, (us == WHITE) ? Square::a1 : Square::a8);
+        add(us, ROOK, (us == WHITE) ? Square::d1 : Square::d8);
+    }
+    return d;
+}
+
+void NNUE::AccumulatorStack::reset(const Board &board)
+{
+    finny.resize(2 * MaxBucketKeys);
+    for (FinnyEntry &f : finny)
+    {
+        std::memcpy(f.values, network.feature_bias, sizeof(network.feature_bias));
+        std::memset(f.pieces, 0, sizeof(f.pieces));
+    }
+
+    if (entries.empty())
+        entries.resize(2 * engine_constants::search::MaxDepth);
+    top = 0;
+    entries[0].king_sq[WHITE] = board.king_sq[WHITE];
+    entries[0].king_sq[BLACK] = board.king_sq[BLACK];
+    entries[0].computed[WHITE] = entries[0].computed[BLACK] = false;
+}
+
+void NNUE::AccumulatorStack::push(const Move &m, Color us, const Board &before)
+{
+    if (top < 0)
+        reset(before);
+    if (++top == static_cast<int>(entries.size()))
+        entries.resize(2 * entries.size());
+
+    Entry &e = entries[top];
+    const Entry &prev = entries[top - 1];
+    e.delta = move_delta(m, us);
+    e.king_sq[WHITE] = prev.king_sq[WHITE];
+    e.king_sq[BLACK] = prev.king_sq[BLACK];
+    if (m.get_from_piece() == KING)
+        e.king_sq[us] = m.get_to_sq();
+    e.computed[WHITE] = e.computed[BLACK] = false;
+}
+
+// Applique seulement la différence entre les pièces mémorisées pour ce bucket et la position
+void NNUE::AccumulatorStack::refresh_from_finny(Color perspective, const Board &board)
+{
+    Entry &e = entries[top];
+    const int king_sq = e.king_sq[perspective];
+    FinnyEntry &f = finny[perspective * MaxBucketKeys + bucket_key(perspective, king_sq)];
+
+    constexpr int Batch = 32;
+    const int16_t *adds[Batch], *subs[Batch];
+    int n_add = 0, n_sub = 0;
+    auto flush = [&]()
+    {
+        update_rows(f.values, f.values, adds, n_add, subs, n_sub);
+        n_add = n_sub = 0;
+    };
+
+    for (int c = WHITE; c <= BLACK; ++c)
+    {
+        for (int p = PAWN; p <= KING; ++p)
+        {
+            const U64 now = board.get_piece_bitboard(static_cast<Color>(c), static_cast<Piece>(p));
+            U64 added = now & ~f.pieces[c][p];
+            U64 removed = f.pieces[c][p] & ~now;
+            f.pieces[c][p] = now;
+
+            while (added)
+            {
+                adds[n_add++] = feature_row(perspective, king_sq, static_cast<Color>(c), static_cast<Piece>(p), cpu::pop_lsb(added));
+                if (n_add == Batch)
+                    flush();
+            }
+            while (removed)
+            {
+                subs[n_sub++] = feature_row(perspective, king_sq, static_cast<Color>(c), static_cast<Piece>(p), cpu::pop_lsb(removed));
+                if (n_sub == Batch)
+                    flush();
+            }
+        }
+    }
+    flush();
+
+    std::memcpy(e.acc.values[perspective], f.values, sizeof(f.values));
+    e.computed[perspective] = true;
+}
+
+void NNUE::AccumulatorStack::materialize(Color perspective, const Board &board)
+{
+    // Dernier ancêtre calculé, sans changement de bucket du roi en chemin
+    const int key = bucket_key(perspective, entries[top].king_sq[perspective]);
+    int base = top;
+    while (!entries[base].computed[perspective])
+    {
+        if (base == 0 || bucket_key(perspective, entries[base - 1].king_sq[perspective]) != key)
+        {
+            refresh_from_finny(perspective, board);
+            return;
+        }
+        --base;
+    }
+
+    for (int i = base + 1; i <= top; ++i)
+    {
+        Entry &e = entries[i];
+        const FeatureDelta &d = e.delta;
+        const int king_sq = e.king_sq[perspective];
+        const int16_t *adds[2], *subs[2];
+        for (int k = 0; k < d.n_add; ++k)
+            adds[k] = feature_row(perspective, king_sq, d.add_c[k], d.add_p[k], d.add_sq[k]);
+        for (int k = 0; k < d.n_sub; ++k)
+            subs[k] = feature_row(perspective, king_sq, d.sub_c[k], d.sub_p[k], d.sub_sq[k]);
+
+        update_rows(e.acc.values[perspective], entries[i - 1].acc.values[perspective], adds, d.n_add, subs, d.n_sub);
+        e.computed[perspective] = true;
+    }
+}
+
+const NNUE::Accumulator &NNUE::AccumulatorStack::current(const Board &board)
+{
+    if (top < 0)
+        reset(board);
+    for (int persp = WHITE; persp <= BLACK; ++persp)
+        if (!entries[top].computed[persp])
+            materialize(static_cast<Color>(persp), board);
+    return entries[top].acc;
+}
+
+// =============================== Inférence ===============================
+
+int NNUE::evaluate(const Accumulator &acc, Color side_to_move)
+{
+    int sum = dot_crelu(acc.values[side_to_move], network.output_weights) +
+              dot_crelu(acc.values[!side_to_move], network.output_weights + HiddenSize);
+
+    // sum est à l'échelle QA * QB, le biais de sortie aussi
+    const int score = static_cast<int>((static_cast<int64_t>(sum) + network.output_bias) * Scale / (QA * QB));
+
+    // Jamais dans la zone des scores de mat / tablebases
+    constexpr int Bound = engine_constants::eval::SyzygyScore - engine_constants::search::MaxDepth - 1;
+    return std::clamp(score, -Bound, Bound);
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+// NNUE evaluation : 768 -> HiddenSize (x2 perspectives) -> 1, activation CReLU.
+// File layout (bullet "simple" format, little endian int16) :
+//   feature_weights[buckets][768][HiddenSize], feature_bias[HiddenSize], output_weights[2 * HiddenSize], output_bias
+// buckets vaut 1 (réseau simple) ou KingBucketCount (entrées par case du roi, échiquier miroir
+// quand le roi est sur les colonnes e-h) ; le format est reconnu à la taille du fichier.
+// Accumulators live in VBoard (AccumulatorStack) : play / unplay only record the move,
+// the accumulator is materialized when the evaluation asks for it.
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/constants.hpp"
+#include "common/mask.hpp"
+#include "core/piece/color.hpp"
+#include "core/piece/piece.hpp"
+#include "core/move/move.hpp"
+
+class Board;
+
+namespace NNUE
+{
+    constexpr int InputSize = 768;
+    constexpr int HiddenSize = 256;
+
+    // Quantification : couche cachée x QA, sortie x QB, score final x Scale (centipions)
+    constexpr int QA = 255;
+    constexpr int QB = 64;
+    constexpr int Scale = 400;
+
+    // Buckets du roi, du point de vue de la perspective, après miroir (colonnes a-d seulement)
+    constexpr int KingBucketCount = 4;
+    constexpr std::array<int, constants::BoardSize> KingBucketLayout = {
+        0, 0, 1, 1, 1, 1, 0, 0,
+        2, 2, 2, 2, 2, 2, 2, 2,
+        3, 3, 3, 3, 3, 3, 3, 3,
+        3, 3, 3, 3, 3, 3, 3, 3,
+        3, 3, 3, 3, 3, 3, 3, 3,
+        3, 3, 3, 3, 3, 3, 3, 3,
+        3, 3, 3, 3, 3, 3, 3, 3,
+        3, 3, 3, 3, 3, 3, 3, 3};
+    // Une entrée de cache par (bucket, miroir)
+    constexpr int MaxBucketKeys = 2 * KingBucketCount;
+
+    constexpr size_t file_size(int buckets)
+    {
+        return sizeof(int16_t) * (buckets * InputSize * HiddenSize + HiddenSize + 2 * HiddenSize + 1);
+    }
+    constexpr size_t FileSize = file_size(1);
+    constexpr size_t BucketedFileSize = file_size(KingBucketCount);
+
+    struct alignas(64) Accumulator
+    {
+        int16_t values[2][HiddenSize]; // Indexé par perspective (WHITE, BLACK)
+    };
+
+    struct alignas(64) Network
+    {
+        int16_t feature_weights[KingBucketCount * InputSize * HiddenSize];
+        int16_t feature_bias[HiddenSize];
+        int16_t output_weights[2 * HiddenSize]; // [0, H) : camp au trait, [H, 2H) : adversaire
+        int16_t output_bias;
+    };
+
+    extern Network network;
+    extern bool loaded;
+    extern bool bucketed;
+    extern std::uint64_t network_hash; // Empreinte du réseau chargé
+
+    inline bool is_loaded() { return loaded; }
+    inline std::uint64_t fingerprint() { return loaded ? network_hash : 0; }
+    inline bool is_bucketed() { return bucketed; }
+
+    // false si le fichier est absent ou n'a pas une des tailles attendues ; le réseau déjà chargé reste alors actif
+    bool load(const std::string &path);
+    void unload();
+
+    inline int relative_sq(Color perspective, int sq)
+    {
+        return (perspective == WHITE) ? sq : sq ^ 56;
+    }
+
+    inline bool mirrored(Color perspective, int king_sq)
+    {
+        return bucketed && (relative_sq(perspective, king_sq) & 7) >= 4;
+    }
+
+    inline int king_bucket(Color perspective, int king_sq)
+    {
+        if (!bucketed)
+            return 0;
+        return KingBucketLayout[relative_sq(perspective, king_sq) ^ (mirrored(perspective, king_sq) ? 7 : 0)];
+    }
+
+    // Entrée du cache de rafraîchissement : change seulement quand le roi change de bucket ou de moitié
+    inline int bucket_key(Color perspective, int king_sq)
+    {
+        return 2 * king_bucket(perspective, king_sq) + (mirrored(perspective, king_sq) ? 1 : 0);
+    }
+
+    // Vue de la perspective : ses pièces d'abord, échiquier retourné pour les noirs
+    inline int feature_index(Color perspective, int king_sq, Color c, Piece p, int sq)
+    {
+        const int side = (c == perspective) ? 0 : 1;
+        const int flip = mirrored(perspective, king_sq) ? 7 : 0;
+        return king_bucket(perspective, king_sq) * InputSize + side * 384 + p * constants::BoardSize + (relative_sq(perspective, sq) ^ flip);
+    }
+
+    // Recalcul complet de référence
+    void refresh(Accumulator &acc, const Board &board);
+
+    // Pièces ajoutées / retirées par un coup (au plus 2 de chaque, pour le roque)
+    struct FeatureDelta
+    {
+        Color add_c[2], sub_c[2];
+        Piece add_p[2], sub_p[2];
+        uint8_t add_sq[2], sub_sq[2];
+        uint8_t n_add, n_sub;
+    };
+
+    // Pile d'accumulateurs d'un VBoard, une entrée par coup joué.
+    // push / pop ne calculent rien ; current() met à jour depuis le dernier ancêtre calculé
+    // (même bucket de roi), sinon repart de l'entrée du cache "finny" de la perspective
+    // en n'appliquant que la différence de pièces avec la position mémorisée.
+    class AccumulatorStack
+    {
+        struct Entry
+        {
+            Accumulator acc;
+            FeatureDelta delta;
+            uint8_t king_sq[2];
+            bool computed[2];
+        };
+
+        struct FinnyEntry
+        {
+            alignas(64) int16_t values[HiddenSize];
+            U64 pieces[2][constants::PieceTypeCount];
+        };
+
+        std::vector<Entry> entries;
+        std::vector<FinnyEntry> finny; // [perspective][bucket_key]
+        int top = -1;
+
+        void materialize(Color perspective, const Board &board);
+        void refresh_from_finny(Color perspective, const Board &board);
+
+    public:
+        // Nouvelle racine (cache vidé), à appeler après un changement de position ou de réseau
+        // Les buffers déjà alloués sont réutilisés
+        void reset(const Board &board);
+
+        // Pile à reprendre depuis la position au prochain push / current (reset différé, sans allocation)
+        inline void invalidate() { top = -1; }
+
+        // Enregistre le coup joué par us depuis before (le roi est lu dans le coup)
+        void push(const Move &m, Color us, const Board &before);
+
+        inline void pop() { --top; }
+
+        inline int height() const { return top; }
+        inline void truncate(int h) { top = h; }
+
+        // Accumulateur de la position courante, board doit être la position au sommet de la pile
+        // (une pile jamais initialisée est réinitialisée depuis board)
+        const Accumulator &current(const Board &board);
+    };
+
+    // Score du point de vue du camp au trait
+    int evaluate(const Accumulator &acc, Color side_to_move);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -50,6 +51,11 @@ public:
     {
         table[key & index_mask] = {key, (std::int16_t)mg, (std::int16_t)eg};
     }
+    void clear()
+    {
+        std::fill(table.begin(), table.end(), PawnEntry{0, 0, 0});
+    }
+
     void reset_stats()
     {
         hits = 0;
@@ -6,20 +6,36 @@
 #include "core/move/generator/move_generator.hpp"
 
 #include "engine/config/eval.hpp"
+#include "engine/eval/eval_params.hpp"
 #include "engine/eval/virtual_board.hpp"
 
 #include <bit>
 
 PawnTable pawn_table;
 
+void Eval::clear_pawn_table()
+{
+    pawn_table.clear();
+}
+
+const PawnTable &Eval::get_pawn_table()
+{
+    return pawn_table;
+}
+
+void Eval::reset_pawn_stats()
+{
+    pawn_table.reset_stats();
+}
+
 namespace Eval
 {
-    static const TUNABLE_TYPE *mobility_bonus_tables[] = {
-        nullptr, // PAWN (pas géré ici)
-        engine_constants::eval::knight_mob,
-        engine_constants::eval::bishop_mob,
-        engine_constants::eval::rook_mob,
-        engine_constants::eval::queen_mob};
+    static constexpr int mobility_bonus_offsets[] = {
+        0, // PAWN (pas géré ici)
+        Layout::KnightMob,
+        Layout::BishopMob,
+        Layout::RookMob,
+        Layout::QueenMob};
 }
 
 // Transforme un bitboard de pions en un masque où chaque bit
@@ -34,6 +50,7 @@ inline uint8_t get_pawn_files(U64 pawns)
 }
 int Eval::evaluate_castling_and_safety(Color us, const VBoard &board)
 {
+    const std::int16_t *P = params();
     const Color them = (Color)!us;
     const int king_sq = board.king_sq[us];
     const int king_file = king_sq & 7;
@@ -52,8 +69,8 @@ int Eval::evaluate_castling_and_safety(Color us, const VBoard &board)
     uint8_t semi_open = vicinity & ~our_files & enemy_files;
 
     // 3. Calcul du score de base par popcount (Instruction matérielle ultra-rapide)
-    int score = std::popcount(static_cast<uint8_t>(open)) * engine_constants::eval::openFileMalus;
-    score += std::popcount(static_cast<uint8_t>(semi_open)) * engine_constants::eval::semiOpenFileMalus;
+    int score = std::popcount(static_cast<uint8_t>(open)) * P[Layout::OpenFile];
+    score += std::popcount(static_cast<uint8_t>(semi_open)) * P[Layout::SemiOpenFile];
 
     // 4. Masques 64-bit : On traite uniquement les 3 colonnes du voisinage
     U64 open_files_bb = 0;
@@ -75,13 +92,14 @@ int Eval::evaluate_castling_and_safety(Color us, const VBoard &board)
     }
 
     // 5. Pénalité si des pièces lourdes adverses occupent ces couloirs
-    score += std::popcount(enemy_heavies & open_files_bb) * engine_constants::eval::heavyEnemiesOpenFileMalus;
-    score += std::popcount(enemy_heavies & semi_files_bb) * engine_constants::eval::heavyEnemiesSemiOpenFileMalus;
+    score += std::popcount(enemy_heavies & open_files_bb) * P[Layout::HeavyOpen];
+    score += std::popcount(enemy_heavies & semi_files_bb) * P[Layout::HeavySemiOpen];
 
     return score;
 }
 void Eval::evaluate_pawns(Color color, const VBoard &board, int &mg, int &eg)
 {
+    const std::int16_t *P = params();
     const U64 our_pawns = board.get_piece_bitboard(color, PAWN);
     const U64 enemy_pawns = board.get_piece_bitboard(!color, PAWN);
 
@@ -91,16 +109,16 @@ void Eval::evaluate_pawns(Color color, const VBoard &board, int &mg, int &eg)
                                     (our_pawns >> 32) | (our_pawns >> 40) | (our_pawns >> 48) | (our_pawns >> 56));
     // On compte le nombre de colonnes contenant des pions doublés
     int num_doubled_files = std::popcount(get_pawn_files(doubled_mask));
-    mg += num_doubled_files * engine_constants::eval::doubledFilesMgMalus;
-    eg += num_doubled_files * engine_constants::eval::doubledFilesEgMalus;
+    mg += num_doubled_files * P[Layout::DoubledMg];
+    eg += num_doubled_files * P[Layout::DoubledEg];
 
     // 2. DETECTION GLOBALE DES PIONS ISOLÉS (Zéro boucle)
     uint8_t f = get_pawn_files(our_pawns);
     // Une colonne est isolée si ses voisines (f << 1) et (f >> 1) sont vides
     uint8_t iso_files = f & ~((f << 1) | (f >> 1));
     int num_iso = std::popcount(iso_files);
-    mg += num_iso * engine_constants::eval::isolatedFilesMgMalus;
-    eg += num_iso * engine_constants::eval::isolatedFilesEgMalus;
+    mg += num_iso * P[Layout::IsolatedMg];
+    eg += num_iso * P[Layout::IsolatedEg];
 
     // 3. BOUCLE ALLÉGÉE (Uniquement pour les pions passés)
     U64 temp_pawns = our_pawns;
@@ -114,13 +132,14 @@ void Eval::evaluate_pawns(Color color, const VBoard &board, int &mg, int &eg)
             const int rank = sq >> 3;
             const int relative_rank = (color == WHITE) ? rank : (7 - rank);
 
-            mg += engine_constants::eval::passed_bonus_mg[relative_rank];
-            eg += engine_constants::eval::passed_bonus_eg[relative_rank];
+            mg += P[Layout::PassedMg + relative_rank];
+            eg += P[Layout::PassedEg + relative_rank];
         }
     }
 }
-int Eval::eval(const VBoard &board, int alpha, int beta)
+int Eval::hce_eval(const VBoard &board, int alpha, int beta)
 {
+    const std::int16_t *P = params();
     const EvalState &state = board.get_eval_state();
 
     // 1. Matériel + PST (Incrémental : GRATUIT)
@@ -168,15 +187,15 @@ int Eval::eval(const VBoard &board, int alpha, int beta)
 
         if (std::popcount(board.get_piece_bitboard(us, BISHOP)) >= 2)
         {
-            bonus_mg += engine_constants::eval::bishopPairMgBonus; // Bonus milieu de jeu
-            bonus_eg += engine_constants::eval::bishopPairEgBonus; // Bonus fin de partie (plus important car le plateau est ouvert)
+            bonus_mg += P[Layout::BishopPairMg]; // Bonus milieu de jeu
+            bonus_eg += P[Layout::BishopPairEg]; // Bonus fin de partie (plus important car le plateau est ouvert)
         }
 
         // Mobilité optimisée
         for (int piece = KNIGHT; piece <= QUEEN; ++piece)
         {
             U64 bb = board.get_piece_bitboard(us, piece);
-            const TUNABLE_TYPE *bonus_table = mobility_bonus_tables[piece];
+            const std::int16_t *bonus_table = P + mobility_bonus_offsets[piece];
 
             while (bb)
             {
@@ -232,7 +251,7 @@ int Eval::eval(const VBoard &board, int alpha, int beta)
 
         // On combine les deux :
         // + on pousse au bord, + on gagne. + on est proche, + on gagne.
-        int mop_up = (dist_from_center * engine_constants::eval::kingDistFromCenterBonus) + (engine_constants::eval::maxDistBetweenKings - dist_between_kings) * engine_constants::eval::closeKingBonus;
+        int mop_up = (dist_from_center * P[Layout::KingDistCenter]) + (engine_constants::eval::maxDistBetweenKings - dist_between_kings) * P[Layout::KingCloseness];
 
         // On applique le bonus selon le gagnant
         if (winner == WHITE)
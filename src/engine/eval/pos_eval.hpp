@@ -7,7 +7,10 @@
 #include "core/piece/piece.hpp"
 
 #include "engine/config/eval.hpp"
+#include "engine/eval/eval_params.hpp"
 #include "engine/eval/virtual_board.hpp"
+#include "engine/eval/nnue.hpp"
+#include "engine/eval/pawn_entry.hpp"
 
 #ifdef TEXEL_TUNING
 #include "engine/eval/tuning/eval_features.hpp"
@@ -75,7 +78,21 @@ namespace Eval
     int evaluate_castling_and_safety(Color color, const VBoard &board);
 
     void evaluate_pawns(Color color, const VBoard &board, int &mg, int &eg);
-    int eval(const VBoard &board, int alpha, int beta);
+
+    // Évaluation classique (HCE), toujours du point de vue des blancs
+    int hce_eval(const VBoard &board, int alpha, int beta);
+
+    // Réseau si un EvalFile est chargé, HCE sinon ; point de vue des blancs
+    inline int eval(const VBoard &board, int alpha, int beta)
+    {
+        if (NNUE::is_loaded())
+        {
+            const Color stm = board.get_side_to_move();
+            const int score = NNUE::evaluate(board.get_accumulator(), stm);
+            return (stm == WHITE) ? score : -score;
+        }
+        return hce_eval(board, alpha, beta);
+    }
 
     template <Color Us>
     inline int eval_relative(const VBoard &board, int alpha, int beta)
@@ -86,11 +103,24 @@ namespace Eval
 
     inline int get_piece_score(int piece)
     {
-        return engine_constants::eval::pieces_score[piece];
+        return params()[Layout::Material + piece];
+    }
+
+    // Identité de l'éval active (paramètres HCE et réseau chargé) : une HashFile n'est relue que sous la même
+    inline std::uint64_t fingerprint()
+    {
+        return params_hash(active_params) ^ NNUE::fingerprint();
     }
 
     void print_pawn_stats();
 
+    // Après un changement de paramètres : les entrées en cache ne sont plus valides
+    void clear_pawn_table();
+
+    // Table des pions partagée par les threads : hits / misses comptés depuis reset_pawn_stats
+    const PawnTable &get_pawn_table();
+    void reset_pawn_stats();
+
     inline int king_distance(int sq1, int sq2)
     {
         int dx = std::abs((sq1 & 7) - (sq2 & 7));
@@ -98,9 +128,14 @@ namespace Eval
         return std::max(dx, dy);
     }
 
+    // Éval rapide des décisions d'élagage (razoring, futility, ply max), du point de vue de Us :
+    // le réseau si un EvalFile est chargé (même échelle que les scores cherchés), sinon matériel + PST
     template <Color Us>
     int lazy_eval_relative(const VBoard &board)
     {
+        if (NNUE::is_loaded())
+            return NNUE::evaluate(board.get_accumulator(), Us);
+
         const EvalState &state = board.get_eval_state();
         const int mg_score = (state.mg_pst[WHITE] + state.pieces_val[WHITE]) -
                              (state.mg_pst[BLACK] + state.pieces_val[BLACK]);
@@ -32,7 +32,9 @@ class TableBase
         unsigned ep;
         unsigned dtz;
     };
-    std::mutex tb_mutex;
+    // Fathom a un état global : partagé par toutes les instances (un EngineManager par partie en datagen)
+    static inline std::mutex tb_mutex;
+    static inline int instances = 0;
 
     RootRawResult probe_root_impl(const Board &board)
     {
@@ -88,6 +90,9 @@ public:
 
     TableBase()
     {
+        std::lock_guard<std::mutex> lock(tb_mutex);
+        if (instances++ > 0)
+            return;
         const std::string tablebase_path = file::get_data_path("syzygy");
         if (!tb_init(tablebase_path.c_str()))
             logs::error << "TB init failed" << std::endl;
@@ -99,7 +104,9 @@ public:
 
     ~TableBase()
     {
-        tb_free();
+        std::lock_guard<std::mutex> lock(tb_mutex);
+        if (--instances == 0)
+            tb_free();
     }
 
     // This function should be called inside negamax
@@ -0,0 +1,275 @@
+#pragma once
+
+// Optimiseurs du tuner Texel et points de reprise binaires.
+// Les paramètres sont un vecteur plat (Texel::Layout), le gradient est la moyenne sur le lot.
+// SGD et Adam avancent par mini-lots ; L-BFGS travaille sur le jeu complet, avec recherche linéaire.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Texel
+{
+    enum class OptimizerKind : std::uint8_t
+    {
+        SGD,
+        Adam,
+        LBFGS
+    };
+
+    inline const char *to_string(OptimizerKind kind)
+    {
+        switch (kind)
+        {
+        case OptimizerKind::SGD:
+            return "sgd";
+        case OptimizerKind::Adam:
+            return "adam";
+        case OptimizerKind::LBFGS:
+            return "lbfgs";
+        }
+        return "?";
+    }
+
+    inline std::optional<OptimizerKind> parse_optimizer(std::string_view name)
+    {
+        if (name == "sgd")
+            return OptimizerKind::SGD;
+        if (name == "adam")
+            return OptimizerKind::Adam;
+        if (name == "lbfgs")
+            return OptimizerKind::LBFGS;
+        return std::nullopt;
+    }
+
+    // Pas par défaut, en centipions par pas (Adam) ou par unité de gradient moyen (SGD)
+    inline double default_learning_rate(OptimizerKind kind)
+    {
+        return kind == OptimizerKind::SGD ? 100.0 : 1.0;
+    }
+
+    inline double dot(const std::vector<double> &a, const std::vector<double> &b)
+    {
+        double s = 0.0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            s += a[i] * b[i];
+        return s;
+    }
+
+    struct Sgd
+    {
+        double lr = 100.0;
+
+        void step(std::vector<double> &x, const std::vector<double> &g) const
+        {
+            for (std::size_t i = 0; i < x.size(); ++i)
+                x[i] -= lr * g[i];
+        }
+    };
+
+    struct Adam
+    {
+        double lr = 1.0;
+        double beta1 = 0.9;
+        double beta2 = 0.999;
+        double eps = 1e-8;
+        std::vector<double> m, v;
+        std::uint64_t t = 0;
+
+        void step(std::vector<double> &x, const std::vector<double> &g)
+        {
+            if (m.size() != x.size())
+            {
+                m.assign(x.size(), 0.0);
+                v.assign(x.size(), 0.0);
+                t = 0;
+            }
+            ++t;
+            const double c1 = 1.0 - std::pow(beta1, static_cast<double>(t));
+            const double c2 = 1.0 - std::pow(beta2, static_cast<double>(t));
+            for (std::size_t i = 0; i < x.size(); ++i)
+            {
+                m[i] = beta1 * m[i] + (1.0 - beta1) * g[i];
+                v[i] = beta2 * v[i] + (1.0 - beta2) * g[i] * g[i];
+                x[i] -= lr * (m[i] / c1) / (std::sqrt(v[i] / c2) + eps);
+            }
+        }
+    };
+
+    // L-BFGS à mémoire limitée, direction par double boucle, pas d'Armijo par rebroussement.
+    // f(x, grad) retourne la perte moyenne et remplit son gradient.
+    class Lbfgs
+    {
+        struct Pair
+        {
+            std::vector<double> s, y;
+            double rho;
+        };
+        std::deque<Pair> history;
+
+    public:
+        int memory = 10;
+        int max_line_search = 30;
+
+        void reset() { history.clear(); }
+
+        // Un pas ; x, fx et gx sont mis à jour. false si aucun pas ne fait décroître la perte.
+        template <typename F>
+        bool iterate(std::vector<double> &x, double &fx, std::vector<double> &gx, F &&f)
+        {
+            const std::size_t n = x.size();
+            std::vector<double> d(gx);
+            std::vector<double> alpha(history.size());
+            for (std::size_t k = history.size(); k-- > 0;)
+            {
+                alpha[k] = history[k].rho * dot(history[k].s, d);
+                for (std::size_t i = 0; i < n; ++i)
+                    d[i] -= alpha[k] * history[k].y[i];
+            }
+            if (!history.empty())
+            {
+                const Pair &last = history.back();
+                const double gamma = dot(last.s, last.y) / dot(last.y, last.y);
+                for (double &di : d)
+                    di *= gamma;
+            }
+            for (std::size_t k = 0; k < history.size(); ++k)
+            {
+                const double beta = history[k].rho * dot(history[k].y, d);
+                for (std::size_t i = 0; i < n; ++i)
+                    d[i] += (alpha[k] - beta) * history[k].s[i];
+            }
+            for (double &di : d)
+                di = -di;
+
+            double slope = dot(gx, d);
+            if (slope >= 0.0)
+            {
+                // Courbure perdue : repart d'une descente de gradient
+                history.clear();
+                d = gx;
+                for (double &di : d)
+                    di = -di;
+                slope = dot(gx, d);
+            }
+
+            // Premier pas sans historique : déplacement d'un centipion dans la direction du gradient
+            double step = history.empty() ? 1.0 / std::max(1e-12, std::sqrt(dot(gx, gx))) : 1.0;
+            std::vector<double> x_new(n), g_new(n);
+            for (int ls = 0; ls < max_line_search; ++ls, step *= 0.5)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                    x_new[i] = x[i] + step * d[i];
+                const double f_new = f(x_new, g_new);
+                if (f_new <= fx + 1e-4 * step * slope)
+                {
+                    Pair p{std::vector<double>(n), std::vector<double>(n), 0.0};
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        p.s[i] = x_new[i] - x[i];
+                        p.y[i] = g_new[i] - gx[i];
+                    }
+                    const double sy = dot(p.s, p.y);
+                    if (sy > 1e-12)
+                    {
+                        p.rho = 1.0 / sy;
+                        history.push_back(std::move(p));
+                        if (static_cast<int>(history.size()) > memory)
+                            history.pop_front();
+                    }
+                    x.swap(x_new);
+                    gx.swap(g_new);
+                    fx = f_new;
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    // Point de reprise : paramètres courants et meilleurs, état d'Adam, progression de l'arrêt anticipé.
+    // L'historique de L-BFGS n'est pas sauvegardé : il se reconstruit en quelques itérations.
+    struct Checkpoint
+    {
+        static constexpr std::uint32_t Magic = 0x54363243; // "C26T"
+        static constexpr std::uint32_t Version = 1;
+
+        OptimizerKind optimizer = OptimizerKind::Adam;
+        std::uint32_t epoch = 0;
+        std::uint32_t epochs_since_best = 0;
+        double k = 1.0;
+        double learning_rate = 1.0;
+        double best_valid_loss = 0.0;
+        std::uint64_t adam_t = 0;
+        std::vector<double> params, best_params, adam_m, adam_v;
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        bool write_pod(std::FILE *f, const T &v) { return std::fwrite(&v, sizeof(T), 1, f) == 1; }
+        template <typename T>
+        bool read_pod(std::FILE *f, T &v) { return std::fread(&v, sizeof(T), 1, f) == 1; }
+
+        inline bool write_vec(std::FILE *f, const std::vector<double> &v)
+        {
+            const std::uint32_t n = static_cast<std::uint32_t>(v.size());
+            return write_pod(f, n) && (n == 0 || std::fwrite(v.data(), sizeof(double), n, f) == n);
+        }
+        inline bool read_vec(std::FILE *f, std::vector<double> &v, std::uint32_t max_size)
+        {
+            std::uint32_t n;
+            if (!read_pod(f, n) || n > max_size)
+                return false;
+            v.resize(n);
+            return n == 0 || std::fread(v.data(), sizeof(double), n, f) == n;
+        }
+    }
+
+    // Écrit dans un fichier temporaire puis renomme : un arrêt brutal laisse l'ancien point intact
+    inline bool save_checkpoint(const std::string &path, const Checkpoint &c)
+    {
+        const std::string tmp = path + ".tmp";
+        std::FILE *f = std::fopen(tmp.c_str(), "wb");
+        if (!f)
+            return false;
+        const std::uint8_t kind = static_cast<std::uint8_t>(c.optimizer);
+        const bool ok = detail::write_pod(f, Checkpoint::Magic) && detail::write_pod(f, Checkpoint::Version) &&
+                        detail::write_pod(f, kind) && detail::write_pod(f, c.epoch) &&
+                        detail::write_pod(f, c.epochs_since_best) && detail::write_pod(f, c.k) &&
+                        detail::write_pod(f, c.learning_rate) && detail::write_pod(f, c.best_valid_loss) &&
+                        detail::write_pod(f, c.adam_t) &&
+                        detail::write_vec(f, c.params) && detail::write_vec(f, c.best_params) &&
+                        detail::write_vec(f, c.adam_m) && detail::write_vec(f, c.adam_v);
+        if (std::fclose(f) != 0 || !ok)
+            return false;
+        return std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+    // expected_params : taille attendue du vecteur de paramètres (un point d'une autre version est refusé)
+    inline bool load_checkpoint(const std::string &path, std::size_t expected_params, Checkpoint &c)
+    {
+        std::FILE *f = std::fopen(path.c_str(), "rb");
+        if (!f)
+            return false;
+        std::uint32_t magic = 0, version = 0;
+        std::uint8_t kind = 0;
+        const std::uint32_t max = static_cast<std::uint32_t>(expected_params);
+        bool ok = detail::read_pod(f, magic) && magic == Checkpoint::Magic &&
+                  detail::read_pod(f, version) && version == Checkpoint::Version &&
+                  detail::read_pod(f, kind) && kind <= static_cast<std::uint8_t>(OptimizerKind::LBFGS) &&
+                  detail::read_pod(f, c.epoch) && detail::read_pod(f, c.epochs_since_best) &&
+                  detail::read_pod(f, c.k) && detail::read_pod(f, c.learning_rate) &&
+                  detail::read_pod(f, c.best_valid_loss) && detail::read_pod(f, c.adam_t) &&
+                  detail::read_vec(f, c.params, max) && detail::read_vec(f, c.best_params, max) &&
+                  detail::read_vec(f, c.adam_m, max) && detail::read_vec(f, c.adam_v, max);
+        std::fclose(f);
+        c.optimizer = static_cast<OptimizerKind>(kind);
+        return ok && c.params.size() == expected_params && c.best_params.size() == expected_params;
+    }
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#ifdef TEXEL_TUNING
+
+// Représentation creuse des features Texel : un vecteur plat de paramètres,
+// et par position seulement les couples (indice, coefficient) non nuls.
+// Le jeu de données est stocké en colonnes (SoA) : ~300 octets par position au lieu de ~7 Ko.
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "common/fatal.hpp"
+#include "engine/config/eval.hpp"
+#include "engine/eval/eval_params.hpp"
+#include "engine/eval/tuning/eval_features.hpp"
+
+namespace Texel
+{
+    // Phase dans laquelle un paramètre compte : milieu de partie, finale ou les deux (poids plein)
+    enum class Term : uint8_t
+    {
+        MG,
+        EG,
+        BOTH
+    };
+
+    // Disposition du vecteur de paramètres, dans l'ordre de EvalFeatures : celle du jeu de paramètres de l'éval
+    namespace Layout = ::Eval::Layout;
+
+    inline Term term_of(int i)
+    {
+        using namespace Layout;
+        if (i == DoubledEg || i == IsolatedEg || i == BishopPairEg || i == KingDistCenter || i == KingCloseness ||
+            (i >= PassedEg && i < KnightMob) || i >= EgPst)
+            return Term::EG;
+        if ((i >= KnightMob && i < MgPst))
+            return Term::BOTH;
+        return Term::MG;
+    }
+
+    // Paramètre tunable correspondant à un indice.
+    // static : les paramètres de eval.hpp sont propres à chaque unité de traduction
+    static inline TunableParam &param(int i)
+    {
+        using namespace engine_constants::eval;
+        using namespace Layout;
+
+        static const std::array<TunableParam *, Count> table = []
+        {
+            std::array<TunableParam *, Count> t{};
+            t[DoubledMg] = &doubledFilesMgMalus;
+            t[DoubledEg] = &doubledFilesEgMalus;
+            t[IsolatedMg] = &isolatedFilesMgMalus;
+            t[IsolatedEg] = &isolatedFilesEgMalus;
+            t[OpenFile] = &openFileMalus;
+            t[SemiOpenFile] = &semiOpenFileMalus;
+            t[HeavyOpen] = &heavyEnemiesOpenFileMalus;
+            t[HeavySemiOpen] = &heavyEnemiesSemiOpenFileMalus;
+            t[BishopPairMg] = &bishopPairMgBonus;
+            t[BishopPairEg] = &bishopPairEgBonus;
+            t[KingDistCenter] = &kingDistFromCenterBonus;
+            t[KingCloseness] = &closeKingBonus;
+            for (int k = 0; k < 8; ++k)
+            {
+                t[PassedMg + k] = &passed_bonus_mg[k];
+                t[PassedEg + k] = &passed_bonus_eg[k];
+            }
+            for (int k = 0; k < 9; ++k)
+                t[KnightMob + k] = &knight_mob[k];
+            for (int k = 0; k < 14; ++k)
+                t[BishopMob + k] = &bishop_mob[k];
+            for (int k = 0; k < 15; ++k)
+                t[RookMob + k] = &rook_mob[k];
+            for (int k = 0; k < 28; ++k)
+                t[QueenMob + k] = &queen_mob[k];
+            for (int p = 0; p < constants::PieceTypeCount; ++p)
+            {
+                t[Material + p] = &pieces_score[p];
+                for (int sq = 0; sq < constants::BoardSize; ++sq)
+                {
+                    t[MgPst + p * constants::BoardSize + sq] = &mg_tables[p][sq];
+                    t[EgPst + p * constants::BoardSize + sq] = &eg_tables[p][sq];
+                }
+            }
+            return t;
+        }();
+
+        return *table[i];
+    }
+
+    // Poids entrelacés (mg, eg) par paramètre : un paramètre BOTH compte dans les deux sommes,
+    // ce qui donne exactement (mg * phase + eg * (total - phase)) / total
+    static inline void gather_weights(std::vector<double> &w)
+    {
+        w.assign(2 * Layout::Count, 0.0);
+        for (int i = 0; i < Layout::Count; ++i)
+        {
+            const Term t = term_of(i);
+            const double v = param(i).value;
+            w[2 * i] = (t != Term::EG) ? v : 0.0;
+            w[2 * i + 1] = (t != Term::MG) ? v : 0.0;
+        }
+    }
+
+    // Gradient d'un paramètre à partir des sommes (mg, eg) accumulées par les noyaux
+    inline double param_gradient(const std::vector<double> &g, int i)
+    {
+        switch (term_of(i))
+        {
+        case Term::MG:
+            return g[2 * i];
+        case Term::EG:
+            return g[2 * i + 1];
+        default:
+            return g[2 * i] + g[2 * i + 1];
+        }
+    }
+
+    struct SparseDataset
+    {
+        std::vector<float> result;
+        std::vector<uint8_t> phase;
+        std::vector<uint32_t> offset{0}; // Entrées de la position i : [offset[i], offset[i + 1])
+        std::vector<uint16_t> index;
+        std::vector<int8_t> coeff;
+
+        std::size_t size() const { return result.size(); }
+
+        std::size_t bytes() const
+        {
+            return result.capacity() * sizeof(float) + phase.capacity() + offset.capacity() * sizeof(uint32_t) +
+                   index.capacity() * sizeof(uint16_t) + coeff.capacity();
+        }
+
+        void reserve(std::size_t samples, std::size_t entries_per_sample = 96)
+        {
+            result.reserve(samples);
+            phase.reserve(samples);
+            offset.reserve(samples + 1);
+            index.reserve(samples * entries_per_sample);
+            coeff.reserve(samples * entries_per_sample);
+        }
+
+        void add(const EvalFeatures &f, int sample_phase, double sample_result)
+        {
+            using namespace Layout;
+
+            auto put = [this](int i, double c)
+            {
+                if (c == 0.0)
+                    return;
+                if (c != std::trunc(c) || c < INT8_MIN || c > INT8_MAX)
+                    FATAL("Texel feature coefficient does not fit in int8");
+                index.push_back(static_cast<uint16_t>(i));
+                coeff.push_back(static_cast<int8_t>(c));
+            };
+
+            put(DoubledMg, f.doubled_files);
+            put(DoubledEg, f.doubled_files);
+            put(IsolatedMg, f.isolated_files);
+            put(IsolatedEg, f.isolated_files);
+            put(OpenFile, f.open_files_near_king);
+            put(SemiOpenFile, f.semi_open_files_near_king);
+            put(HeavyOpen, f.heavy_on_open);
+            put(HeavySemiOpen, f.heavy_on_semi_open);
+            put(BishopPairMg, f.bishop_pair_mg);
+            put(BishopPairEg, f.bishop_pair_eg);
+            put(KingDistCenter, f.king_dist_center);
+            put(KingCloseness, f.king_closeness);
+            for (int k = 0; k < 8; ++k)
+                put(PassedMg + k, f.passed_mg[k]);
+            for (int k = 0; k < 8; ++k)
+                put(PassedEg + k, f.passed_eg[k]);
+            for (int k = 0; k < 9; ++k)
+                put(KnightMob + k, f.knight_mob[k]);
+            for (int k = 0; k < 14; ++k)
+                put(BishopMob + k, f.bishop_mob[k]);
+            for (int k = 0; k < 15; ++k)
+                put(RookMob + k, f.rook_mob[k]);
+            for (int k = 0; k < 28; ++k)
+                put(QueenMob + k, f.queen_mob[k]);
+            for (int p = PAWN; p <= QUEEN; ++p)
+                put(Material + p, f.material[p]);
+            for (int p = 0; p < constants::PieceTypeCount; ++p)
+                for (int sq = 0; sq < constants::BoardSize; ++sq)
+                    put(MgPst + p * constants::BoardSize + sq, f.mg_pst[p][sq]);
+            for (int p = 0; p < constants::PieceTypeCount; ++p)
+                for (int sq = 0; sq < constants::BoardSize; ++sq)
+                    put(EgPst + p * constants::BoardSize + sq, f.eg_pst[p][sq]);
+
+            result.push_back(static_cast<float>(sample_result));
+            phase.push_back(static_cast<uint8_t>(sample_phase));
+            offset.push_back(static_cast<uint32_t>(index.size()));
+        }
+
+        // Vide le jeu en gardant la mémoire réservée (morceaux successifs d'un flux)
+        void clear()
+        {
+            result.clear();
+            phase.clear();
+            offset.assign(1, 0);
+            index.clear();
+            coeff.clear();
+        }
+
+        void append_sample(const SparseDataset &o, std::size_t i)
+        {
+            result.push_back(o.result[i]);
+            phase.push_back(o.phase[i]);
+            index.insert(index.end(), o.index.begin() + o.offset[i], o.index.begin() + o.offset[i + 1]);
+            coeff.insert(coeff.end(), o.coeff.begin() + o.offset[i], o.coeff.begin() + o.offset[i + 1]);
+            offset.push_back(static_cast<uint32_t>(index.size()));
+        }
+
+        // Ajoute les positions d'un autre jeu (construction en parallèle par morceaux)
+        void append(const SparseDataset &o)
+        {
+            const uint32_t base = static_cast<uint32_t>(index.size());
+            result.insert(result.end(), o.result.begin(), o.result.end());
+            phase.insert(phase.end(), o.phase.begin(), o.phase.end());
+            index.insert(index.end(), o.index.begin(), o.index.end());
+            coeff.insert(coeff.end(), o.coeff.begin(), o.coeff.end());
+            for (std::size_t i = 1; i < o.offset.size(); ++i)
+                offset.push_back(base + o.offset[i]);
+        }
+
+        // Permutation des positions (mélange entre époques)
+        void permute(const std::vector<uint32_t> &order)
+        {
+            SparseDataset out;
+            out.reserve(order.size(), order.empty() ? 0 : index.size() / size() + 1);
+            for (uint32_t i : order)
+                out.append_sample(*this, i);
+            *this = std::move(out);
+        }
+    };
+
+    // ================= Noyaux par lots =================
+    // 1. score_batch : produit scalaire creux (mg, eg) par position, puis interpolation de phase
+    // 2. error_batch : sigmoïde, erreur et dérivée sur des tableaux contigus (vectorisable)
+    // 3. gradient_batch : dispersion des dérivées sur les indices
+
+    inline void score_batch(const SparseDataset &d, std::size_t begin, std::size_t end, const double *w, double *out)
+    {
+        using engine_constants::eval::totalPhase;
+        for (std::size_t s = begin; s < end; ++s)
+        {
+            double mg = 0.0, eg = 0.0;
+            const uint16_t *idx = d.index.data() + d.offset[s];
+            const int8_t *c = d.coeff.data() + d.offset[s];
+            const uint32_t n = d.offset[s + 1] - d.offset[s];
+            for (uint32_t k = 0; k < n; ++k)
+            {
+                mg += c[k] * w[2 * idx[k]];
+                eg += c[k] * w[2 * idx[k] + 1];
+            }
+            out[s - begin] = (mg * d.phase[s] + eg * (totalPhase - d.phase[s])) / totalPhase;
+        }
+    }
+
+    // common[i] reçoit d(erreur²)/d(eval) ; retourne la somme des erreurs²
+    inline double error_batch(const float *result, const double *eval, std::size_t n, double k, double *common)
+    {
+        constexpr double Ln10Over400 = 2.302585092994046 / 400.0;
+        double loss = 0.0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double p = 1.0 / (1.0 + std::exp(-k * eval[i] * Ln10Over400));
+            const double error = p - result[i];
+            loss += error * error;
+            common[i] = 2.0 * error * Ln10Over400 * k * p * (1.0 - p);
+        }
+        return loss;
+    }
+
+    inline void gradient_batch(const SparseDataset &d, std::size_t begin, std::size_t end, const double *common, double *g)
+    {
+        using engine_constants::eval::totalPhase;
+        for (std::size_t s = begin; s < end; ++s)
+        {
+            const double c_mg = common[s - begin] * d.phase[s] / totalPhase;
+            const double c_eg = common[s - begin] * (totalPhase - d.phase[s]) / totalPhase;
+            const uint16_t *idx = d.index.data() + d.offset[s];
+            const int8_t *c = d.coeff.data() + d.offset[s];
+            const uint32_t n = d.offset[s + 1] - d.offset[s];
+            for (uint32_t k = 0; k < n; ++k)
+            {
+                g[2 * idx[k]] += c_mg * c[k];
+                g[2 * idx[k] + 1] += c_eg * c[k];
+            }
+        }
+    }
+}
+
+#endif
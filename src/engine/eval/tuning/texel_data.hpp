@@ -0,0 +1,179 @@
+#pragma once
+
+#ifdef TEXEL_TUNING
+
+// Lecture en flux des données d'entraînement Texel.
+// Le fichier (EPD, ou .bin de PackedPosition) est projeté en mémoire, découpé en morceaux terminés
+// sur une fin de ligne ou un enregistrement, chaque morceau est analysé en parallèle puis livré
+// en SparseDataset dans l'ordre du fichier.
+// La mémoire utilisée ne dépend que de la taille d'un morceau, pas de celle du fichier.
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "common/mapped_file.hpp"
+#include "engine/data/epd.hpp"
+#include "engine/data/packed_io.hpp"
+#include "engine/eval/pos_eval.hpp"
+#include "engine/eval/tuning/sparse_features.hpp"
+#include "engine/eval/virtual_board.hpp"
+
+class TexelDataReader
+{
+    file::MappedFile file;
+    bool packed_input = false;
+
+    // Fin du morceau commençant à begin : au moins target octets, arrêtée après une fin de ligne
+    // ou un enregistrement complet
+    std::size_t chunk_end(std::size_t begin, std::size_t target) const
+    {
+        const std::size_t end = std::min(file.size(), begin + std::max<std::size_t>(target, 1));
+        if (packed_input)
+        {
+            const std::size_t aligned = begin + (end - begin + sizeof(PackedPosition) - 1) / sizeof(PackedPosition) * sizeof(PackedPosition);
+            return std::min(file.size(), aligned);
+        }
+        return next_line_start(file.view(), end - 1);
+    }
+
+public:
+    // Profondeur d'analyse : lignes seules, positions chargées, ou features extraites (entraînement)
+    enum class Parse
+    {
+        Lines,
+        Boards,
+        Features
+    };
+
+    struct Stats
+    {
+        std::size_t lines = 0;
+        std::size_t samples = 0;
+        std::size_t rejected = 0;
+    };
+
+    bool open(const std::string &path)
+    {
+        packed_input = packed::is_packed_path(path);
+        return file.open(path);
+    }
+    std::size_t size_bytes() const { return file.size(); }
+    bool is_packed() const { return packed_input; }
+
+    // Analyse [begin, end) : une position par ligne valide, ajoutée à out
+    template <Parse Level = Parse::Features>
+    Stats parse_range(std::size_t begin, std::size_t end, Texel::SparseDataset &out) const
+    {
+        if (packed_input)
+            return parse_packed_range<Level>(begin, end, out);
+
+        Stats stats;
+        VBoard board;
+        std::string_view text(file.data() + begin, end - begin);
+
+        while (!text.empty())
+        {
+            const std::size_t nl = text.find('\n');
+            const std::string_view line = text.substr(0, nl);
+            text.remove_prefix(nl == std::string_view::npos ? text.size() : nl + 1);
+            if (line.empty())
+                continue;
+
+            ++stats.lines;
+            const auto sample = parse_quiet_labeled_line(line);
+            if (!sample.has_value() || (Level != Parse::Lines && !board.load_fen(sample->fen)))
+            {
+                ++stats.rejected;
+                continue;
+            }
+
+            ++stats.samples;
+            if constexpr (Level == Parse::Features)
+                out.add(Eval::extract_eval_features(board), board.get_eval_state().phase, sample->result);
+        }
+        return stats;
+    }
+
+    // Idem pour un .bin : un enregistrement par « ligne », sans résultat connu il est rejeté
+    template <Parse Level = Parse::Features>
+    Stats parse_packed_range(std::size_t begin, std::size_t end, Texel::SparseDataset &out) const
+    {
+        Stats stats;
+        VBoard board;
+        const auto *records = reinterpret_cast<const PackedPosition *>(file.data() + begin);
+        const std::size_t count = (end - begin) / sizeof(PackedPosition);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const PackedPosition &p = records[i];
+            ++stats.lines;
+            if (p.result == PackedPosition::Unknown || (Level != Parse::Lines && !board.unpack(p)))
+            {
+                ++stats.rejected;
+                continue;
+            }
+
+            ++stats.samples;
+            if constexpr (Level == Parse::Features)
+                out.add(Eval::extract_eval_features(board), board.get_eval_state().phase, p.white_score());
+        }
+        return stats;
+    }
+
+    // Parcourt le fichier par morceaux d'environ chunk_bytes, analysés par threads fils.
+    // fn(chunk, first_sample, bytes_done) reçoit les positions dans l'ordre du fichier ; chunk est réutilisé.
+    // Le parcours s'arrête si fn retourne false.
+    template <Parse Level = Parse::Features, typename F>
+    Stats for_each_chunk(std::size_t chunk_bytes, unsigned threads, F &&fn) const
+    {
+        threads = std::max(1u, threads);
+        std::vector<Texel::SparseDataset> parts(threads);
+        std::vector<Stats> part_stats(threads);
+        Texel::SparseDataset chunk;
+        Stats total;
+
+        for (std::size_t begin = 0; begin < file.size();)
+        {
+            const std::size_t end = chunk_end(begin, chunk_bytes);
+
+            // Sous-morceaux alignés sur les lignes ou les enregistrements, un par thread
+            std::vector<std::size_t> bounds{begin};
+            for (unsigned t = 1; t < threads; ++t)
+                bounds.push_back(std::clamp(chunk_end(begin, (end - begin) * t / threads), bounds.back(), end));
+            bounds.push_back(end);
+
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                parts[t].clear();
+                workers.emplace_back([&, t]()
+                                     { part_stats[t] = parse_range<Level>(bounds[t], bounds[t + 1], parts[t]); });
+            }
+            for (auto &w : workers)
+                w.join();
+
+            chunk.clear();
+            std::size_t chunk_samples = 0;
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                chunk.append(parts[t]);
+                chunk_samples += part_stats[t].samples;
+                total.lines += part_stats[t].lines;
+                total.rejected += part_stats[t].rejected;
+            }
+
+            const bool more = fn(chunk, total.samples, end);
+            total.samples += chunk_samples;
+            if (!more)
+                break;
+            begin = end;
+        }
+        return total;
+    }
+};
+
+#endif
@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <climits>
 #include <cmath>
 #include <fstream>
 #include <limits>
@@ -18,23 +20,15 @@
 #include "common/file.hpp"
 #include "common/logger.hpp"
 #include "common/fatal.hpp"
+#include "common/thread_pool.hpp"
 #include "engine/config/eval.hpp"
+#include "engine/eval/eval_params.hpp"
 #include "engine/eval/tuning/eval_features.hpp"
+#include "engine/eval/tuning/optimizers.hpp"
+#include "engine/eval/tuning/sparse_features.hpp"
+#include "engine/eval/tuning/texel_data.hpp"
 #include "engine/eval/virtual_board.hpp"
 
-struct TexelSample
-{
-    std::string fen;
-    double result = 0.5;
-};
-
-struct TexelTrainingSample
-{
-    double result = 0.5;
-    int phase = 0;
-    EvalFeatures features;
-};
-
 template <std::size_t N>
 void dump_array(std::ofstream &out, const char *name, const TunableParam (&arr)[N])
 {
@@ -63,183 +57,74 @@ void dump_pst(std::ofstream &out, const char *name, const TunableParam (&arr)[N]
     }
     out << "}\n\n";
 }
-struct TexelGradients
-{
-    double doubledFilesMgMalus = 0.0;
-    double doubledFilesEgMalus = 0.0;
-
-    double isolatedFilesMgMalus = 0.0;
-    double isolatedFilesEgMalus = 0.0;
-
-    double openFileMalus = 0.0;
-    double semiOpenFileMalus = 0.0;
-
-    double heavyEnemiesOpenFileMalus = 0.0;
-    double heavyEnemiesSemiOpenFileMalus = 0.0;
-
-    double bishopPairMgBonus = 0.0;
-    double bishopPairEgBonus = 0.0;
-
-    double kingDistFromCenterBonus = 0.0;
-    double closeKingBonus = 0.0;
-
-    std::array<double, 8> passed_bonus_mg{};
-    std::array<double, 8> passed_bonus_eg{};
-
-    std::array<double, 9> knight_mob{};
-    std::array<double, 14> bishop_mob{};
-    std::array<double, 15> rook_mob{};
-    std::array<double, 28> queen_mob{};
-
-    std::array<double, constants::PieceTypeCount> pieces_score{};
-
-    std::array<std::array<double, constants::BoardSize>, constants::PieceTypeCount> mg_pst{};
-    std::array<std::array<double, constants::BoardSize>, constants::PieceTypeCount> eg_pst{};
-};
-
-static std::optional<TexelSample> parse_quiet_labeled_line(const std::string &line)
-{
-    std::istringstream iss(line);
-
-    std::string board;
-    std::string stm;
-    std::string castling;
-    std::string ep;
-    std::string tag;
-    std::string result_token;
-
-    if (!(iss >> board >> stm >> castling >> ep >> tag >> result_token))
-        return std::nullopt;
-
-    if (tag != "c9")
-        return std::nullopt;
-
-    if (!result_token.empty() && result_token.back() == ';')
-        result_token.pop_back();
-
-    double result = 0.5;
-
-    if (result_token == "\"1-0\"")
-        result = 1.0;
-    else if (result_token == "\"1/2-1/2\"")
-        result = 0.5;
-    else if (result_token == "\"0-1\"")
-        result = 0.0;
-    else
-        return std::nullopt;
-
-    std::string fen = board + " " + stm + " " + castling + " " + ep + " 0 1";
-    return TexelSample{fen, result};
-}
-
 class TexelTuner
 {
-    static constexpr int lines_nb = 1428000;
-    static constexpr int percent = lines_nb / 100;
-    static constexpr double texelK = 1.2755;
-
-    static constexpr int epochs = 1000;
-    static constexpr std::size_t batch_size = 4096;
-
-    double learning_rate = 100.0;
-
-    double sigmoid(double s) const
-    {
-        return 1.0 / (1.0 + std::pow(10.0, -s / 400.0));
-    }
-
-    double sigmoid_derivative_from_p(double p) const
+public:
+    // Réglages d'une session, modifiables par la commande UCI texel
+    struct Settings
     {
-        return (std::log(10.0) * texelK / 400.0) * p * (1.0 - p);
-    }
+        Texel::OptimizerKind optimizer = Texel::OptimizerKind::Adam;
+        double learning_rate = 0.0; // 0 : pas par défaut de l'optimiseur
+        int epochs = 1000;
+        int patience = 10; // Époques sans amélioration de la validation avant l'arrêt, 0 : jamais
+        double k = 1.2755;
+        bool fit_k = true; // K ajusté sur les données avant l'entraînement
+        bool resume = false;
+        std::string checkpoint_path = file::get_data_path("tuning_output/texel_checkpoint.bin");
+    };
+
+private:
+    static constexpr std::size_t batch_size = 4096;
 
-    double score_sample(const TexelTrainingSample &s) const
+    Settings settings;
+    double k = 1.2755; // Échelle de la sigmoïde, éval en centipions -> probabilité de gain
+    Texel::Sgd sgd;
+    Texel::Adam adam;
+    Texel::Lbfgs lbfgs;
+
+    // Données : lues par morceaux de chunk_bytes ; gardées en mémoire si elles tiennent dans
+    // max_resident_bytes, relues à chaque époque sinon. Une position sur valid_every sert à la validation.
+    static constexpr std::size_t chunk_bytes = std::size_t(64) << 20;
+    static constexpr std::size_t valid_every = 5;
+    std::size_t max_resident_bytes = std::size_t(4) << 30;
+    std::string data_path;
+
+    // Lots contigus : scores, erreurs puis gradients (voir sparse_features.hpp)
+    struct BatchScratch
     {
-        using namespace engine_constants::eval;
-
-        const EvalFeatures &f = s.features;
+        std::vector<double> eval;
+        std::vector<double> common;
+        std::vector<double> grad; // (mg, eg) par paramètre
 
-        double mg = 0.0;
-        double eg = 0.0;
-
-        for (int i = PAWN; i <= QUEEN; ++i)
+        void resize(std::size_t n)
         {
-            mg += f.material[i] * pieces_score[i];
-            eg += f.material[i] * pieces_score[i];
+            eval.resize(n);
+            common.resize(n);
         }
+    };
 
-        mg += f.doubled_files * doubledFilesMgMalus;
-        eg += f.doubled_files * doubledFilesEgMalus;
-
-        mg += f.isolated_files * isolatedFilesMgMalus;
-        eg += f.isolated_files * isolatedFilesEgMalus;
-
-        mg += f.open_files_near_king * openFileMalus;
-        mg += f.semi_open_files_near_king * semiOpenFileMalus;
-        mg += f.heavy_on_open * heavyEnemiesOpenFileMalus;
-        mg += f.heavy_on_semi_open * heavyEnemiesSemiOpenFileMalus;
-
-        mg += f.bishop_pair_mg * bishopPairMgBonus;
-        eg += f.bishop_pair_eg * bishopPairEgBonus;
-
-        eg += f.king_dist_center * kingDistFromCenterBonus;
-        eg += f.king_closeness * closeKingBonus;
-
-        for (int i = 0; i < 8; ++i)
-        {
-            mg += f.passed_mg[i] * passed_bonus_mg[i];
-            eg += f.passed_eg[i] * passed_bonus_eg[i];
-        }
-
-        for (int i = 0; i < 9; ++i)
-        {
-            mg += f.knight_mob[i] * knight_mob[i];
-            eg += f.knight_mob[i] * knight_mob[i];
-        }
-
-        for (int i = 0; i < 14; ++i)
-        {
-            mg += f.bishop_mob[i] * bishop_mob[i];
-            eg += f.bishop_mob[i] * bishop_mob[i];
-        }
-
-        for (int i = 0; i < 15; ++i)
-        {
-            mg += f.rook_mob[i] * rook_mob[i];
-            eg += f.rook_mob[i] * rook_mob[i];
-        }
-
-        for (int i = 0; i < 28; ++i)
-        {
-            mg += f.queen_mob[i] * queen_mob[i];
-            eg += f.queen_mob[i] * queen_mob[i];
-        }
-
-        for (int piece = PAWN; piece <= KING; ++piece)
+    static void split_chunk(const Texel::SparseDataset &chunk, std::size_t first_sample, Texel::SparseDataset &train, Texel::SparseDataset &valid)
+    {
+        for (std::size_t i = 0; i < chunk.size(); ++i)
         {
-            for (int sq = 0; sq < constants::BoardSize; ++sq)
-            {
-                mg += f.mg_pst[piece][sq] * mg_tables[piece][sq];
-                eg += f.eg_pst[piece][sq] * eg_tables[piece][sq];
-            }
+            if ((first_sample + i) % valid_every == valid_every - 1)
+                valid.append_sample(chunk, i);
+            else
+                train.append_sample(chunk, i);
         }
-
-        return (mg * s.phase + eg * (totalPhase - s.phase)) / totalPhase;
     }
 
-    TexelTrainingSample make_training_sample(const TexelSample &sample) const
+    TexelDataReader open_data() const
     {
-        VBoard board;
-        board.load_fen(sample.fen);
-
-        const EvalState &state = board.get_eval_state();
-
-        EvalFeatures features = Eval::extract_eval_features(board);
+        TexelDataReader reader;
+        if (!reader.open(data_path))
+            FATAL("Cannot open tuning file " + data_path);
+        return reader;
+    }
 
-        return TexelTrainingSample{
-            sample.result,
-            state.phase,
-            features};
+    static void log_progress(const char *what, std::size_t bytes_done, std::size_t total_bytes)
+    {
+        logs::uci << "[INFO] " << what << " " << (total_bytes ? 100 * bytes_done / total_bytes : 100) << "% of dataset" << std::endl;
     }
 
     void save_params(const std::string &path, int epoch, double train_loss, double valid_loss)
@@ -308,406 +193,365 @@ class TexelTuner
         dump_pst(out, "eg_rook_table", eg_rook_table);
         dump_pst(out, "eg_queen_table", eg_queen_table);
         dump_pst(out, "eg_king_table", eg_king_table);
+
+        // Même jeu au format binaire, chargeable sans recompiler (setoption name EvalParams)
+        const std::string bin_path = std::filesystem::path(output_path).replace_extension(".bin").string();
+        if (!Eval::save_params(bin_path, to_param_set()))
+            logs::error << "[ERROR] Cannot write params file " << bin_path << std::endl;
     }
 
-    std::vector<TexelSample> load_raw_samples()
+    // Paramètres courants arrondis au format du jeu de l'éval
+    static Eval::ParamSet to_param_set()
     {
-        std::ifstream epd_file(file::get_data_path("tuning_epd/quiet-labeled.v7.epd"));
-
-        if (!epd_file.is_open())
-            FATAL("Cannot open tuning file");
-
-        std::vector<TexelSample> raw;
-        raw.reserve(lines_nb);
-
-        std::string line;
-        int parsed = 0;
-
-        while (std::getline(epd_file, line))
-        {
-            auto sample = parse_quiet_labeled_line(line);
-
-            if (!sample.has_value())
-            {
-                logs::error << "[ERROR] couldn't parse line" << std::endl;
-                continue;
-            }
-
-            raw.push_back(std::move(*sample));
-            ++parsed;
-
-            if (percent > 0 && parsed % percent == 0)
-            {
-                logs::uci << "[INFO] Loaded raw "
-                          << parsed / percent
-                          << "% of dataset"
-                          << std::endl;
-            }
-        }
-
-        return raw;
+        Eval::ParamSet p = Eval::default_params();
+        for (int i = 0; i < Texel::Layout::Count; ++i)
+            p[i] = static_cast<std::int16_t>(std::clamp<long>(std::lround(Texel::param(i).value), INT16_MIN, INT16_MAX));
+        return p;
     }
 
-    std::vector<TexelTrainingSample> build_training_samples_parallel(const std::vector<TexelSample> &raw)
+    static std::vector<double> get_params()
     {
-        std::vector<TexelTrainingSample> samples(raw.size());
-
-        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
-        const unsigned thread_count = std::min<unsigned>(hw, 8);
-
-        std::atomic<std::size_t> next{0};
-        std::atomic<int> done{0};
-
-        auto worker = [&]()
-        {
-            while (true)
-            {
-                const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
-
-                if (i >= raw.size())
-                    break;
-
-                samples[i] = make_training_sample(raw[i]);
+        std::vector<double> x(Texel::Layout::Count);
+        for (int i = 0; i < Texel::Layout::Count; ++i)
+            x[i] = Texel::param(i).value;
+        return x;
+    }
 
-                const int current_done = ++done;
-                if (percent > 0 && current_done % percent == 0)
-                {
-                    logs::uci << "[INFO] Processed features "
-                              << current_done / percent
-                              << "% of dataset"
-                              << std::endl;
-                }
-            }
-        };
+    static void set_params(const std::vector<double> &x)
+    {
+        for (int i = 0; i < Texel::Layout::Count; ++i)
+            Texel::param(i).value = x[i];
+    }
 
-        std::vector<std::thread> threads;
-        threads.reserve(thread_count);
+    // Gradient moyen par paramètre, à partir des gradients (mg, eg) sommés sur n positions
+    static std::vector<double> flatten_gradient(const std::vector<double> &g, std::size_t n)
+    {
+        std::vector<double> flat(Texel::Layout::Count);
+        const double inv = 1.0 / static_cast<double>(std::max<std::size_t>(1, n));
+        for (int i = 0; i < Texel::Layout::Count; ++i)
+            flat[i] = Texel::param_gradient(g, i) * inv;
+        return flat;
+    }
 
-        for (unsigned i = 0; i < thread_count; ++i)
-            threads.emplace_back(worker);
+    void apply_step(const std::vector<double> &flat)
+    {
+        std::vector<double> x = get_params();
+        if (settings.optimizer == Texel::OptimizerKind::SGD)
+            sgd.step(x, flat);
+        else
+            adam.step(x, flat);
+        set_params(x);
+    }
 
-        for (auto &t : threads)
-            t.join();
+    // Pool persistant, réutilisé par tous les mini-lots ; un worker par cœur
+    mutable ThreadPool pool;
 
-        return samples;
+    unsigned worker_count() const
+    {
+        return pool.size();
     }
 
-    static void add_gradients(TexelGradients &a, const TexelGradients &b)
+    // Blocs assez petits pour équilibrer la charge par vol, assez gros pour amortir l'ordonnancement
+    std::size_t grain_for(std::size_t n) const
     {
-        a.doubledFilesMgMalus += b.doubledFilesMgMalus;
-        a.doubledFilesEgMalus += b.doubledFilesEgMalus;
+        return std::clamp<std::size_t>(n / (4 * worker_count()), 64, kernel_batch);
+    }
 
-        a.isolatedFilesMgMalus += b.isolatedFilesMgMalus;
-        a.isolatedFilesEgMalus += b.isolatedFilesEgMalus;
+    static constexpr std::size_t kernel_batch = 1024;
 
-        a.openFileMalus += b.openFileMalus;
-        a.semiOpenFileMalus += b.semiOpenFileMalus;
+    // Somme des erreurs² sur [begin, end)
+    double compute_loss_parallel(const Texel::SparseDataset &d, std::size_t begin, std::size_t end) const
+    {
+        std::vector<double> w;
+        Texel::gather_weights(w);
+
+        std::vector<double> partial(worker_count(), 0.0);
+        pool.run(begin, end, grain_for(end - begin), [&](unsigned t, std::size_t b, std::size_t e)
+                 {
+            BatchScratch &s = worker_scratch[t];
+            s.resize(e - b);
+            Texel::score_batch(d, b, e, w.data(), s.eval.data());
+            partial[t] += Texel::error_batch(d.result.data() + b, s.eval.data(), e - b, k, s.common.data()); });
+
+        return std::accumulate(partial.begin(), partial.end(), 0.0);
+    }
 
-        a.heavyEnemiesOpenFileMalus += b.heavyEnemiesOpenFileMalus;
-        a.heavyEnemiesSemiOpenFileMalus += b.heavyEnemiesSemiOpenFileMalus;
+    std::vector<double> compute_batch_gradient_parallel(
+        const Texel::SparseDataset &d,
+        std::size_t begin,
+        std::size_t end,
+        double &batch_loss) const
+    {
+        std::vector<double> w;
+        Texel::gather_weights(w);
+
+        std::vector<double> partial_losses(worker_count(), 0.0);
+        for (BatchScratch &scratch : worker_scratch)
+            scratch.grad.assign(2 * Texel::Layout::Count, 0.0);
+
+        pool.run(begin, end, grain_for(end - begin), [&](unsigned t, std::size_t b, std::size_t e)
+                 {
+            BatchScratch &scratch = worker_scratch[t];
+            scratch.resize(e - b);
+            Texel::score_batch(d, b, e, w.data(), scratch.eval.data());
+            partial_losses[t] += Texel::error_batch(d.result.data() + b, scratch.eval.data(), e - b, k, scratch.common.data());
+            Texel::gradient_batch(d, b, e, scratch.common.data(), scratch.grad.data()); });
+
+        std::vector<double> total(2 * Texel::Layout::Count, 0.0);
+        for (const BatchScratch &scratch : worker_scratch)
+            for (std::size_t i = 0; i < scratch.grad.size(); ++i)
+                total[i] += scratch.grad[i];
 
-        a.bishopPairMgBonus += b.bishopPairMgBonus;
-        a.bishopPairEgBonus += b.bishopPairEgBonus;
+        batch_loss = std::accumulate(partial_losses.begin(), partial_losses.end(), 0.0);
+        return total;
+    }
 
-        a.kingDistFromCenterBonus += b.kingDistFromCenterBonus;
-        a.closeKingBonus += b.closeKingBonus;
+    // Tampons par worker conservés d'un appel à l'autre (pertes et gradients, jamais en même temps)
+    mutable std::vector<BatchScratch> worker_scratch;
 
-        for (int i = 0; i < 8; ++i)
+    // Premier passage : charge tout le jeu en mémoire, ou renonce dès que le budget est dépassé
+    bool load_resident(const TexelDataReader &reader, Texel::SparseDataset &train, Texel::SparseDataset &valid) const
+    {
+        bool resident = true;
+        const auto stats = reader.for_each_chunk(chunk_bytes, worker_count(), [&](const Texel::SparseDataset &chunk, std::size_t first, std::size_t done)
+                                                 {
+            split_chunk(chunk, first, train, valid);
+            log_progress("Loaded", done, reader.size_bytes());
+            resident = train.bytes() + valid.bytes() <= max_resident_bytes;
+            return resident; });
+
+        if (!resident)
         {
-            a.passed_bonus_mg[i] += b.passed_bonus_mg[i];
-            a.passed_bonus_eg[i] += b.passed_bonus_eg[i];
+            train = Texel::SparseDataset{};
+            valid = Texel::SparseDataset{};
+            logs::uci << "[INFO] Dataset larger than " << (max_resident_bytes >> 20) << " MiB, streaming it every epoch" << std::endl;
+            return false;
         }
 
-        for (int i = 0; i < 9; ++i)
-            a.knight_mob[i] += b.knight_mob[i];
-
-        for (int i = 0; i < 14; ++i)
-            a.bishop_mob[i] += b.bishop_mob[i];
-
-        for (int i = 0; i < 15; ++i)
-            a.rook_mob[i] += b.rook_mob[i];
-
-        for (int i = 0; i < 28; ++i)
-            a.queen_mob[i] += b.queen_mob[i];
-
-        for (int i = PAWN; i <= QUEEN; ++i)
-        {
-            a.pieces_score[i] += b.pieces_score[i];
-        }
+        if (stats.samples == 0)
+            FATAL("No training samples loaded");
 
-        for (int piece = PAWN; piece <= KING; ++piece)
-        {
-            for (int sq = 0; sq < constants::BoardSize; ++sq)
-            {
-                a.mg_pst[piece][sq] += b.mg_pst[piece][sq];
-                a.eg_pst[piece][sq] += b.eg_pst[piece][sq];
-            }
-        }
+        logs::uci << "[INFO] Dataset: " << stats.samples << " samples (" << stats.rejected << " rejected lines), "
+                  << (train.index.size() + valid.index.size()) / stats.samples << " features/sample, "
+                  << ((train.bytes() + valid.bytes()) >> 20) << " MiB" << std::endl;
+        return true;
     }
 
-    void accumulate_gradient_for_sample(const TexelTrainingSample &s, TexelGradients &g, double &loss) const
+    static std::vector<uint32_t> shuffled_order(std::size_t n, std::mt19937 &rng)
     {
-        const double eval = score_sample(s);
-        const double p = sigmoid(texelK * eval);
-        const double error = p - s.result;
-
-        loss += error * error;
-
-        const double common = 2.0 * error * sigmoid_derivative_from_p(p);
-
-        const double mg_scale = static_cast<double>(s.phase) / engine_constants::eval::totalPhase;
-        const double eg_scale = static_cast<double>(engine_constants::eval::totalPhase - s.phase) / engine_constants::eval::totalPhase;
-
-        const EvalFeatures &f = s.features;
-
-        g.doubledFilesMgMalus += common * f.doubled_files * mg_scale;
-        g.doubledFilesEgMalus += common * f.doubled_files * eg_scale;
-
-        g.isolatedFilesMgMalus += common * f.isolated_files * mg_scale;
-        g.isolatedFilesEgMalus += common * f.isolated_files * eg_scale;
-
-        g.openFileMalus += common * f.open_files_near_king * mg_scale;
-        g.semiOpenFileMalus += common * f.semi_open_files_near_king * mg_scale;
-
-        g.heavyEnemiesOpenFileMalus += common * f.heavy_on_open * mg_scale;
-        g.heavyEnemiesSemiOpenFileMalus += common * f.heavy_on_semi_open * mg_scale;
-
-        g.bishopPairMgBonus += common * f.bishop_pair_mg * mg_scale;
-        g.bishopPairEgBonus += common * f.bishop_pair_eg * eg_scale;
+        std::vector<uint32_t> order(n);
+        std::iota(order.begin(), order.end(), 0u);
+        std::shuffle(order.begin(), order.end(), rng);
+        return order;
+    }
 
-        g.kingDistFromCenterBonus += common * f.king_dist_center * eg_scale;
-        g.closeKingBonus += common * f.king_closeness * eg_scale;
+    // Mélange train puis une passe de mini-lots ; ajoute la somme des erreurs² et le nombre de positions vues
+    void train_pass(Texel::SparseDataset &train, std::mt19937 &rng, double &loss_sum, std::size_t &seen)
+    {
+        train.permute(shuffled_order(train.size(), rng));
 
-        for (int i = 0; i < 8; ++i)
+        for (std::size_t start = 0; start < train.size(); start += batch_size)
         {
-            g.passed_bonus_mg[i] += common * f.passed_mg[i] * mg_scale;
-            g.passed_bonus_eg[i] += common * f.passed_eg[i] * eg_scale;
-        }
-
-        const double mob_scale = mg_scale + eg_scale;
-
-        for (int i = 0; i < 9; ++i)
-            g.knight_mob[i] += common * f.knight_mob[i] * mob_scale;
-
-        for (int i = 0; i < 14; ++i)
-            g.bishop_mob[i] += common * f.bishop_mob[i] * mob_scale;
+            const std::size_t end = std::min(start + batch_size, train.size());
 
-        for (int i = 0; i < 15; ++i)
-            g.rook_mob[i] += common * f.rook_mob[i] * mob_scale;
+            double batch_loss = 0.0;
+            const std::vector<double> g = compute_batch_gradient_parallel(train, start, end, batch_loss);
+            apply_step(flatten_gradient(g, end - start));
 
-        for (int i = 0; i < 28; ++i)
-            g.queen_mob[i] += common * f.queen_mob[i] * mob_scale;
-
-        for (int i = PAWN; i <= QUEEN; ++i)
-        {
-            g.pieces_score[i] += common * f.material[i]; // mg_scale + eg_scale = 1
-        }
-        for (int piece = PAWN; piece <= KING; ++piece)
-        {
-            for (int sq = 0; sq < constants::BoardSize; ++sq)
-            {
-                g.mg_pst[piece][sq] += common * f.mg_pst[piece][sq] * mg_scale;
-                g.eg_pst[piece][sq] += common * f.eg_pst[piece][sq] * eg_scale;
-            }
+            loss_sum += batch_loss;
+            seen += end - start;
         }
     }
 
-    void apply_gradients(const TexelGradients &g, double scale)
+    // Perte moyenne et gradient moyen sur tout le jeu, aux paramètres courants (L-BFGS)
+    double full_batch(const Texel::SparseDataset &d, std::vector<double> &grad) const
     {
-        using namespace engine_constants::eval;
-
-        doubledFilesMgMalus.value -= scale * g.doubledFilesMgMalus;
-        doubledFilesEgMalus.value -= scale * g.doubledFilesEgMalus;
-
-        isolatedFilesMgMalus.value -= scale * g.isolatedFilesMgMalus;
-        isolatedFilesEgMalus.value -= scale * g.isolatedFilesEgMalus;
-
-        openFileMalus.value -= scale * g.openFileMalus;
-        semiOpenFileMalus.value -= scale * g.semiOpenFileMalus;
-
-        heavyEnemiesOpenFileMalus.value -= scale * g.heavyEnemiesOpenFileMalus;
-        heavyEnemiesSemiOpenFileMalus.value -= scale * g.heavyEnemiesSemiOpenFileMalus;
-
-        bishopPairMgBonus.value -= scale * g.bishopPairMgBonus;
-        bishopPairEgBonus.value -= scale * g.bishopPairEgBonus;
-
-        kingDistFromCenterBonus.value -= scale * g.kingDistFromCenterBonus;
-        closeKingBonus.value -= scale * g.closeKingBonus;
-
-        for (int i = 0; i < 8; ++i)
-        {
-            passed_bonus_mg[i].value -= scale * g.passed_bonus_mg[i];
-            passed_bonus_eg[i].value -= scale * g.passed_bonus_eg[i];
-        }
-
-        for (int i = 0; i < 9; ++i)
-            knight_mob[i].value -= scale * g.knight_mob[i];
-
-        for (int i = 0; i < 14; ++i)
-            bishop_mob[i].value -= scale * g.bishop_mob[i];
-
-        for (int i = 0; i < 15; ++i)
-            rook_mob[i].value -= scale * g.rook_mob[i];
-
-        for (int i = 0; i < 28; ++i)
-            queen_mob[i].value -= scale * g.queen_mob[i];
+        double loss = 0.0;
+        grad = flatten_gradient(compute_batch_gradient_parallel(d, 0, d.size(), loss), d.size());
+        return loss / static_cast<double>(std::max<std::size_t>(1, d.size()));
+    }
 
-        for (int i = PAWN; i <= QUEEN; ++i)
+    // K minimisant la perte à paramètres fixés (section dorée : la perte est unimodale en K)
+    double fit_k(const Texel::SparseDataset &d)
+    {
+        auto loss_at = [&](double kk)
         {
-            pieces_score[i].value -= scale * g.pieces_score[i];
-        }
-        for (int piece = PAWN; piece <= KING; ++piece)
+            k = kk;
+            return compute_loss_parallel(d, 0, d.size());
+        };
+        constexpr double ratio = 0.6180339887498949;
+        double a = 0.1, b = 4.0;
+        double c = b - ratio * (b - a), e = a + ratio * (b - a);
+        double fc = loss_at(c), fe = loss_at(e);
+        for (int it = 0; it < 40; ++it)
         {
-            for (int sq = 0; sq < constants::BoardSize; ++sq)
+            if (fc < fe)
             {
-                mg_tables[piece][sq].value -= scale * g.mg_pst[piece][sq];
-                eg_tables[piece][sq].value -= scale * g.eg_pst[piece][sq];
+                b = e;
+                e = c;
+                fe = fc;
+                c = b - ratio * (b - a);
+                fc = loss_at(c);
+            }
+            else
+            {
+                a = c;
+                c = e;
+                fc = fe;
+                e = a + ratio * (b - a);
+                fe = loss_at(e);
             }
         }
+        k = 0.5 * (a + b);
+        return k;
     }
 
-    double compute_loss_parallel(const std::vector<TexelTrainingSample> &samples, std::size_t begin, std::size_t end) const
+    // En flux, K est ajusté sur la partie entraînement du premier morceau
+    Texel::SparseDataset first_chunk_train(const TexelDataReader &reader) const
     {
-        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
-        const unsigned thread_count = std::min<unsigned>(hw, 8);
-
-        std::vector<double> partial(thread_count, 0.0);
-        std::vector<std::thread> threads;
-
-        const std::size_t n = end - begin;
-        const std::size_t chunk = (n + thread_count - 1) / thread_count;
-
-        for (unsigned t = 0; t < thread_count; ++t)
-        {
-            const std::size_t b = begin + t * chunk;
-            const std::size_t e = std::min(end, b + chunk);
-
-            threads.emplace_back([&, t, b, e]()
-                                 {
-                double local = 0.0;
-
-                for (std::size_t i = b; i < e; ++i)
-                {
-                    const double eval = score_sample(samples[i]);
-                    const double p = sigmoid(texelK * eval);
-                    const double d = samples[i].result - p;
-                    local += d * d;
-                }
-
-                partial[t] = local; });
-        }
-
-        for (auto &th : threads)
-            th.join();
-
-        const double sum = std::accumulate(partial.begin(), partial.end(), 0.0);
-        return sum / static_cast<double>(n);
+        Texel::SparseDataset train, valid;
+        reader.for_each_chunk(chunk_bytes, worker_count(), [&](const Texel::SparseDataset &chunk, std::size_t first, std::size_t)
+                              {
+            split_chunk(chunk, first, train, valid);
+            return false; });
+        return train;
     }
 
-    TexelGradients compute_batch_gradient_parallel(
-        const std::vector<TexelTrainingSample> &samples,
-        std::size_t begin,
-        std::size_t end,
-        double &batch_loss) const
+    Texel::Checkpoint make_checkpoint(int epoch, int since_best, double best_valid, const std::vector<double> &best) const
     {
-        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
-        const unsigned thread_count = std::min<unsigned>(hw, 8);
-
-        std::vector<TexelGradients> partial_gradients(thread_count);
-        std::vector<double> partial_losses(thread_count, 0.0);
-        std::vector<std::thread> threads;
-
-        const std::size_t n = end - begin;
-        const std::size_t chunk = (n + thread_count - 1) / thread_count;
-
-        for (unsigned t = 0; t < thread_count; ++t)
-        {
-            const std::size_t b = begin + t * chunk;
-            const std::size_t e = std::min(end, b + chunk);
-
-            threads.emplace_back([&, t, b, e]()
-                                 {
-                TexelGradients local_g{};
-                double local_loss = 0.0;
-
-                for (std::size_t i = b; i < e; ++i)
-                    accumulate_gradient_for_sample(samples[i], local_g, local_loss);
-
-                partial_gradients[t] = local_g;
-                partial_losses[t] = local_loss; });
-        }
-
-        for (auto &th : threads)
-            th.join();
-
-        TexelGradients total{};
-
-        for (unsigned t = 0; t < thread_count; ++t)
-            add_gradients(total, partial_gradients[t]);
-
-        batch_loss = std::accumulate(partial_losses.begin(), partial_losses.end(), 0.0);
-        return total;
+        Texel::Checkpoint c;
+        c.optimizer = settings.optimizer;
+        c.epoch = static_cast<std::uint32_t>(epoch);
+        c.epochs_since_best = static_cast<std::uint32_t>(since_best);
+        c.k = k;
+        c.learning_rate = settings.learning_rate;
+        c.best_valid_loss = best_valid;
+        c.adam_t = adam.t;
+        c.params = get_params();
+        c.best_params = best;
+        c.adam_m = adam.m;
+        c.adam_v = adam.v;
+        return c;
     }
 
     void train()
     {
-        logs::uci << "[INFO] Loading raw samples..." << std::endl;
-        std::vector<TexelSample> raw = load_raw_samples();
+        const TexelDataReader reader = open_data();
+        logs::uci << "[INFO] Reading " << data_path << " (" << (reader.size_bytes() >> 20) << " MiB)" << std::endl;
 
-        logs::uci << "[INFO] Building compact training samples..." << std::endl;
-        std::vector<TexelTrainingSample> samples = build_training_samples_parallel(raw);
+        Texel::SparseDataset train, valid;
+        const bool resident = load_resident(reader, train, valid);
 
-        raw.clear();
-        raw.shrink_to_fit();
+        int start_epoch = 0, since_best = 0;
+        double best_valid = std::numeric_limits<double>::infinity();
+        std::vector<double> best = get_params();
 
-        if (samples.empty())
-            FATAL("No training samples loaded");
+        Texel::Checkpoint cp;
+        if (settings.resume && Texel::load_checkpoint(settings.checkpoint_path, Texel::Layout::Count, cp))
+        {
+            set_params(cp.params);
+            best = cp.best_params;
+            k = cp.k;
+            start_epoch = static_cast<int>(cp.epoch);
+            since_best = static_cast<int>(cp.epochs_since_best);
+            best_valid = cp.best_valid_loss;
+            settings.optimizer = cp.optimizer;
+            settings.learning_rate = cp.learning_rate;
+            adam.t = cp.adam_t;
+            adam.m = cp.adam_m;
+            adam.v = cp.adam_v;
+            logs::uci << "[INFO] Resuming from " << settings.checkpoint_path << " at epoch " << start_epoch << std::endl;
+        }
+        else
+        {
+            if (settings.resume)
+                logs::uci << "[INFO] No usable checkpoint at " << settings.checkpoint_path << ", starting from scratch" << std::endl;
+            k = settings.k;
+            if (settings.fit_k)
+                fit_k(resident ? train : first_chunk_train(reader));
+        }
 
-        std::mt19937 rng(42);
-        std::shuffle(samples.begin(), samples.end(), rng);
+        // L-BFGS a besoin de la perte exacte sur tout le jeu à chaque évaluation
+        if (settings.optimizer == Texel::OptimizerKind::LBFGS && !resident)
+        {
+            logs::uci << "[INFO] lbfgs needs a resident dataset, using adam" << std::endl;
+            settings.optimizer = Texel::OptimizerKind::Adam;
+        }
+        if (settings.learning_rate <= 0.0)
+            settings.learning_rate = Texel::default_learning_rate(settings.optimizer);
+        sgd.lr = adam.lr = settings.learning_rate;
 
-        const std::size_t train_size = static_cast<std::size_t>(samples.size() * 0.8);
-        const std::size_t valid_begin = train_size;
-        const std::size_t valid_end = samples.size();
+        logs::uci << "[INFO] Optimizer " << Texel::to_string(settings.optimizer) << " | lr = " << settings.learning_rate
+                  << " | K = " << k << " | patience = " << settings.patience << std::endl;
 
-        logs::uci << "[INFO] Training samples: "
-                  << train_size
-                  << " | Validation samples: "
-                  << valid_end - valid_begin
-                  << std::endl;
+        if (const auto dir = std::filesystem::path(settings.checkpoint_path).parent_path(); !dir.empty())
+            std::filesystem::create_directories(dir);
 
-        const double initial_train_loss = compute_loss_parallel(samples, 0, train_size);
-        const double initial_valid_loss = compute_loss_parallel(samples, valid_begin, valid_end);
+        if (resident)
+        {
+            logs::uci << "[INFO] Training samples: "
+                      << train.size()
+                      << " | Validation samples: "
+                      << valid.size()
+                      << std::endl;
 
-        logs::uci << "[INFO] Initial train loss = "
-                  << initial_train_loss
-                  << " | Initial valid loss = "
-                  << initial_valid_loss
-                  << std::endl;
+            logs::uci << "[INFO] Initial train loss = "
+                      << compute_loss_parallel(train, 0, train.size()) / static_cast<double>(train.size())
+                      << " | Initial valid loss = "
+                      << compute_loss_parallel(valid, 0, valid.size()) / static_cast<double>(std::max<std::size_t>(1, valid.size()))
+                      << std::endl;
+        }
 
-        for (int epoch = 0; epoch < epochs; ++epoch)
+        for (int epoch = start_epoch; epoch < settings.epochs; ++epoch)
         {
-            std::shuffle(samples.begin(), samples.begin() + train_size, rng);
+            double train_loss_sum = 0.0, valid_loss_sum = 0.0;
+            std::size_t train_seen = 0, valid_seen = 0;
 
-            double epoch_loss_sum = 0.0;
-            std::size_t seen = 0;
+            // Graine par époque : une reprise rejoue le même ordre
+            std::mt19937 rng(42 + epoch);
 
-            for (std::size_t start = 0; start < train_size; start += batch_size)
+            if (settings.optimizer == Texel::OptimizerKind::LBFGS)
             {
-                const std::size_t end = std::min(start + batch_size, train_size);
-
-                double batch_loss = 0.0;
-                TexelGradients g = compute_batch_gradient_parallel(samples, start, end, batch_loss);
-
-                const double scale = learning_rate / static_cast<double>(end - start);
-                apply_gradients(g, scale);
-
-                epoch_loss_sum += batch_loss;
-                seen += end - start;
+                std::vector<double> x = get_params(), g;
+                double fx = full_batch(train, g);
+                const bool moved = lbfgs.iterate(x, fx, g, [&](const std::vector<double> &xn, std::vector<double> &gn)
+                                                 {
+                    set_params(xn);
+                    return full_batch(train, gn); });
+                set_params(x);
+                if (!moved)
+                {
+                    logs::uci << "[INFO] lbfgs line search failed, converged" << std::endl;
+                    break;
+                }
+                train_loss_sum = fx * static_cast<double>(train.size());
+                train_seen = train.size();
+                valid_loss_sum = compute_loss_parallel(valid, 0, valid.size());
+                valid_seen = valid.size();
+            }
+            else if (resident)
+            {
+                train_pass(train, rng, train_loss_sum, train_seen);
+                valid_loss_sum = compute_loss_parallel(valid, 0, valid.size());
+                valid_seen = valid.size();
+            }
+            else
+            {
+                // Flux : la validation de chaque morceau est mesurée avant d'entraîner sur ce morceau
+                reader.for_each_chunk(chunk_bytes, worker_count(), [&](const Texel::SparseDataset &chunk, std::size_t first, std::size_t)
+                                      {
+                    train.clear();
+                    valid.clear();
+                    split_chunk(chunk, first, train, valid);
+
+                    valid_loss_sum += compute_loss_parallel(valid, 0, valid.size());
+                    valid_seen += valid.size();
+                    train_pass(train, rng, train_loss_sum, train_seen);
+                    return true; });
             }
 
-            const double train_loss = epoch_loss_sum / static_cast<double>(seen);
-            const double valid_loss = compute_loss_parallel(samples, valid_begin, valid_end);
+            const double train_loss = train_loss_sum / static_cast<double>(std::max<std::size_t>(1, train_seen));
+            const double valid_loss = valid_seen ? valid_loss_sum / static_cast<double>(valid_seen) : train_loss;
 
             logs::uci << "[INFO] Epoch "
                       << epoch + 1
@@ -722,63 +566,110 @@ class TexelTuner
                 epoch + 1,
                 train_loss,
                 valid_loss);
+
+            if (valid_loss < best_valid - 1e-9)
+            {
+                best_valid = valid_loss;
+                best = get_params();
+                since_best = 0;
+                save_params(file::get_data_path("tuning_output/texel_params_best.txt"), epoch + 1, train_loss, valid_loss);
+            }
+            else
+                ++since_best;
+
+            if (!Texel::save_checkpoint(settings.checkpoint_path, make_checkpoint(epoch + 1, since_best, best_valid, best)))
+                logs::error << "[ERROR] Cannot write checkpoint " << settings.checkpoint_path << std::endl;
+
+            if (settings.patience > 0 && since_best >= settings.patience)
+            {
+                logs::uci << "[INFO] No validation improvement for " << since_best << " epochs, stopping" << std::endl;
+                break;
+            }
         }
+
+        set_params(best);
+        Eval::set_params(to_param_set());
+        logs::uci << "[INFO] Best valid loss = " << best_valid << " | K = " << k << std::endl;
     }
 
 public:
+    explicit TexelTuner(std::string path = file::get_data_path("tuning_epd/quiet-labeled.v7.epd"))
+        : data_path(std::move(path)), worker_scratch(pool.size())
+    {
+    }
+
+    Settings &get_settings() { return settings; }
+
+    // Au-delà, le jeu n'est plus gardé en mémoire mais relu à chaque époque
+    void set_max_resident_mib(std::size_t mib)
+    {
+        max_resident_bytes = mib << 20;
+    }
+
     void start_tuning()
     {
         train();
         logs::uci << "[INFO] Task done !" << std::endl;
     }
 
+    // Une seule passe en flux, mémoire constante quelle que soit la taille du fichier
     double compute_mean_abs_eval()
     {
-        logs::uci << "[INFO] Loading raw samples..." << std::endl;
-        std::vector<TexelSample> raw = load_raw_samples();
-
-        logs::uci << "[INFO] Building compact training samples..." << std::endl;
-        std::vector<TexelTrainingSample> samples = build_training_samples_parallel(raw);
-
-        raw.clear();
-        raw.shrink_to_fit();
-
-        if (samples.empty())
+        const TexelDataReader reader = open_data();
+
+        std::vector<double> w;
+        Texel::gather_weights(w);
+
+        double sum = 0.0;
+        const auto stats = reader.for_each_chunk(chunk_bytes, worker_count(), [&](const Texel::SparseDataset &chunk, std::size_t, std::size_t done)
+                                                 {
+            std::vector<double> partial(worker_count(), 0.0);
+            std::vector<std::vector<double>> eval(worker_count(), std::vector<double>(kernel_batch));
+            pool.run(0, chunk.size(), kernel_batch, [&](unsigned t, std::size_t b, std::size_t e)
+                     {
+                Texel::score_batch(chunk, b, e, w.data(), eval[t].data());
+                for (std::size_t i = 0; i < e - b; ++i)
+                    partial[t] += std::abs(eval[t][i]); });
+            sum += std::accumulate(partial.begin(), partial.end(), 0.0);
+            log_progress("Evaluated", done, reader.size_bytes());
+            return true; });
+
+        if (stats.samples == 0)
             FATAL("No training samples loaded");
 
-        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
-        const unsigned thread_count = std::min<unsigned>(hw, 8);
-
-        std::vector<double> partial(thread_count, 0.0);
-        std::vector<std::thread> threads;
+        const double mean = sum / static_cast<double>(stats.samples);
+        logs::uci << "[INFO] Mean absolute eval = " << mean << std::endl;
+        return mean;
+    }
 
-        const std::size_t n = samples.size();
-        const std::size_t chunk = (n + thread_count - 1) / thread_count;
+    // Débit du chargeur : lignes seules, positions chargées, puis features extraites
+    void benchmark_loader()
+    {
+        const TexelDataReader reader = open_data();
+        const double mib = static_cast<double>(reader.size_bytes()) / (1 << 20);
 
-        for (unsigned t = 0; t < thread_count; ++t)
+        auto run = [&]<TexelDataReader::Parse Level>(const char *name)
         {
-            const std::size_t b = t * chunk;
-            const std::size_t e = std::min(n, b + chunk);
-
-            threads.emplace_back([&, t, b, e]()
-                                 {
-            double local = 0.0;
-
-            for (std::size_t i = b; i < e; ++i)
-                local += std::abs(score_sample(samples[i]));
-
-            partial[t] = local; });
-        }
-
-        for (auto &th : threads)
-            th.join();
-
-        const double sum = std::accumulate(partial.begin(), partial.end(), 0.0);
-        const double mean = sum / static_cast<double>(n);
-
-        logs::uci << "[INFO] Mean absolute eval = " << mean << std::endl;
+            std::size_t peak = 0;
+            const auto start = std::chrono::steady_clock::now();
+            const auto stats = reader.for_each_chunk<Level>(chunk_bytes, worker_count(), [&](const Texel::SparseDataset &chunk, std::size_t, std::size_t)
+                                                            {
+                peak = std::max(peak, chunk.bytes());
+                return true; });
+            const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            logs::uci << "[INFO] loader " << name << ": " << stats.samples << " samples in " << s << " s, "
+                      << static_cast<long long>(stats.samples / std::max(s, 1e-9)) << " samples/s, "
+                      << mib / std::max(s, 1e-9) << " MiB/s";
+            if (Level == TexelDataReader::Parse::Features && stats.samples)
+                logs::uci << ", chunk " << (peak >> 20) << " MiB";
+            logs::uci << std::endl;
+        };
 
-        return mean;
+        logs::uci << "[INFO] loader benchmark on " << data_path << " (" << mib << " MiB, " << worker_count() << " threads)" << std::endl;
+        run.template operator()<TexelDataReader::Parse::Lines>("lines");
+        run.template operator()<TexelDataReader::Parse::Boards>("boards");
+        run.template operator()<TexelDataReader::Parse::Features>("features");
     }
 };
 
@@ -6,10 +6,12 @@
 #include "core/piece/color.hpp"
 #include "core/board/board.hpp"
 #include "engine/eval/move_eval_increment.hpp"
+#include "engine/eval/nnue.hpp"
 
 class VBoard : public Board
 {
     EvalState eval_state;
+    mutable NNUE::AccumulatorStack accumulators; // Alimentée seulement quand un réseau est chargé, calculée à la demande
 
 public:
     VBoard &operator=(const VBoard &other)
@@ -19,6 +21,7 @@ public:
             Board::operator=(other);
 
             eval_state = other.eval_state;
+            refresh_accumulator();
         };
 
         return *this;
@@ -30,6 +33,7 @@ public:
             Board::operator=(other);
 
             eval_state = EvalState(pieces_occ);
+            refresh_accumulator();
         };
 
         return *this;
@@ -38,16 +42,19 @@ public:
         : Board(other),
           eval_state(other.eval_state)
     {
+        refresh_accumulator();
     }
     VBoard(const Board &other)
         : Board(other),
           eval_state(other.get_all_bitboards())
     {
+        refresh_accumulator();
     }
 
     VBoard(VBoard &&other) noexcept
         : Board(std::move(other)),
-          eval_state(std::move(other.eval_state))
+          eval_state(std::move(other.eval_state)),
+          accumulators(std::move(other.accumulators))
     {
     }
 
@@ -57,6 +64,7 @@ public:
         {
             Board::operator=(std::move(other));
             eval_state = std::move(other.eval_state);
+            accumulators = std::move(other.accumulators);
         }
         return *this;
     }
@@ -69,13 +77,38 @@ public:
     {
         bool r = Board::load_fen(fen_string);
         eval_state = EvalState(get_all_bitboards());
+        refresh_accumulator();
         return r;
     }
 
+    bool unpack(const PackedPosition &in)
+    {
+        bool r = Board::unpack(in);
+        eval_state = EvalState(get_all_bitboards());
+        refresh_accumulator();
+        return r;
+    }
+
+    // Après un changement des paramètres de l'éval : PST et matériel incrémentaux recalculés
+    inline void refresh_eval_state()
+    {
+        eval_state = EvalState(get_all_bitboards());
+    }
+
+    // Nouvelle racine de la pile, par exemple après le chargement d'un réseau ou une copie.
+    // Différée au premier usage : une copie de VBoard n'alloue rien tant qu'on n'évalue pas avec le réseau,
+    // et une affectation réutilise les buffers de la destination
+    inline void refresh_accumulator()
+    {
+        accumulators.invalidate();
+    }
+
     inline void play(const Move move)
     {
         Color Us = get_side_to_move();
         eval_state.increment(move, Us);
+        if (NNUE::is_loaded())
+            accumulators.push(move, Us, *this);
         Board::play(move);
     }
     inline void unplay(const Move move)
@@ -83,12 +116,16 @@ public:
         Color Us = !get_side_to_move();
         Board::unplay(move);
         eval_state.decrement(move, Us);
+        if (NNUE::is_loaded())
+            accumulators.pop();
     }
 
     template <Color Us>
     inline void play(const Move move)
     {
         eval_state.increment(move, Us);
+        if (NNUE::is_loaded())
+            accumulators.push(move, Us, *this);
         Board::play<Us>(move);
     }
     template <Color Us>
@@ -96,6 +133,8 @@ public:
     {
         Board::unplay<Us>(move);
         eval_state.decrement(move, Us);
+        if (NNUE::is_loaded())
+            accumulators.pop();
     }
 
     inline EvalState &get_eval_state()
@@ -107,4 +146,24 @@ public:
     {
         return eval_state;
     }
+
+    // Met à jour paresseusement les coups joués depuis le dernier accumulateur calculé
+    inline const NNUE::Accumulator &get_accumulator() const
+    {
+        return accumulators.current(*this);
+    }
+
+    // Copy-make : la pile est tronquée au lieu de dépiler coup par coup
+    inline int get_accumulator_height() const
+    {
+        // La racine doit exister avant d'être mémorisée, sinon chaque retour à ce ply la recalculerait
+        if (NNUE::is_loaded() && accumulators.height() < 0)
+            accumulators.reset(*this);
+        return accumulators.height();
+    }
+
+    inline void set_accumulator_height(int h)
+    {
+        accumulators.truncate(h);
+    }
 };
\ No newline at end of file
@@ -31,11 +31,13 @@ struct MovePicker
     Move prev_prev_move;
     Move tt_move;
     int thread_id;
+    const CheckInfo &check_info; // Du nœud : échecs calmes classés comme dans score_move
 
     // NOUVEAU : On stocke l'info ici pour que negamax la lise en toute sécurité
     bool current_is_tactical;
 
-    MovePicker(VBoard &board, Move _tt_move, int _ply, Move _prev_move, int _thread_id)
+    MovePicker(VBoard &board, Move _tt_move, int _ply, Move _prev_move, int _thread_id, const CheckInfo &_check_info)
+        : check_info(_check_info)
     {
         list.clear();
         stage = TT;
@@ -199,8 +201,14 @@ struct MovePicker
                         uint64_t hash = (uint64_t(m.get_value()) + ply) ^ (uint64_t(thread_id) << 32);
                         noise = (hash & 0x7FF) - 1024;
                     }
-                    int history_score = worker.history_moves[Us][m.get_from_sq()][m.get_to_sq()];
-                    history_score = worker.score_quiet_history(history_score, m, prev_move, prev_prev_move, Us);
+                    int history_score;
+                    if (board.gives_check<Us>(m, check_info))
+                        history_score = 7000; // Échec calme : après les counter-moves, avant l'historique
+                    else
+                    {
+                        history_score = worker.history_moves[Us][m.get_from_sq()][m.get_to_sq()];
+                        history_score = worker.score_quiet_history(history_score, m, prev_move, prev_prev_move, Us);
+                    }
                     list.scores[i] = history_score + noise;
                     list.is_tactical[i] = false;
                     list[i++] = m;
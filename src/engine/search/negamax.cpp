@@ -88,16 +88,18 @@ namespace search
     {
         if (depth >= engine_constants::search::null_move_pruning::MinDepth && ply > 0 && allow_null && !in_check && !is_mate_node && beta < 9000 && alpha > -9000)
         {
-            int stored_ep;
+            int stored_ep, stored_irreversible;
             worker.get_tt().prefetch(worker.get_board().get_hash());
-            worker.get_board().play_null_move(stored_ep);
+            worker.get_board().play_null_move(stored_ep, stored_irreversible);
             int R = engine_constants::search::null_move_pruning::RConst + depth / engine_constants::search::null_move_pruning::RDiv;
             R = std::min(R, depth - 1);
+            SEARCH_STAT(worker.stats.nmp_tries);
             int score = -worker.negamax<!Us>(depth - 1 - R, -beta, -beta + 1, ply + 1, false);
-            worker.get_board().unplay_null_move(stored_ep);
+            worker.get_board().unplay_null_move(stored_ep, stored_irreversible);
 
             if (score >= beta)
             {
+                SEARCH_STAT(worker.stats.nmp_cutoffs);
                 return_score = (score >= engine_constants::eval::MateScore - engine_constants::search::MaxDepth) ? beta : score;
                 return true;
             }
@@ -195,11 +197,15 @@ namespace search
             int r = static_cast<int>(worker.lmr_table[std::min(depth, 63)][std::min(moves_searched, 63)]);
             r = std::clamp(r, 0, depth - engine_constants::search::late_move_reduction::MaxDepthReduction);
 
+            SEARCH_STAT(worker.stats.lmr_searches);
             score = -worker.negamax<!Us>(depth - 1 - r, -alpha - 1, -alpha, ply + 1, true);
 
             // Re-search si le coup réduit semble bon
             if (score > alpha)
+            {
+                SEARCH_STAT(worker.stats.lmr_researches);
                 score = -worker.negamax<!Us>(depth - 1, -alpha - 1, -alpha, ply + 1, true);
+            }
             return true;
         }
         return false;
@@ -229,18 +235,39 @@ inline int wdl_score(TableBase::WDL_Result r, int ply)
 }
 
 template <Color Us>
-int SearchWorker::negamax(int depth, int alpha, int beta, int ply, bool allow_null, Move excluded_move)
+FORCE_INLINE int SearchWorker::negamax_node(int depth, int alpha, int beta, int ply, bool allow_null, Move excluded_move)
 {
 
     // =============================== Quick return cases ===============================
     if (check_stop())
+    {
+        SEARCH_TRACE_REASON(Stopped);
         return alpha;
+    }
 
     if (max_extended_depth < ply)
         max_extended_depth = ply;
 
     if (search::is_null(board, ply))
+    {
+        SEARCH_TRACE_REASON(Draw);
         return (board.get_history_size() < 20) ? -25 : 0;
+    }
+
+    // Répétition atteignable en un coup : le score ne peut pas descendre sous la nulle
+    if (ply > 0 && board.has_upcoming_repetition(ply))
+    {
+        const int draw_score = (board.get_history_size() < 20) ? -25 : 0;
+        if (alpha < draw_score)
+        {
+            alpha = draw_score;
+            if (alpha >= beta)
+            {
+                SEARCH_TRACE_REASON(Draw);
+                return alpha;
+            }
+        }
+    }
 
     if (ply > 0 &&
         board.get_halfmove_clock() == 0 &&
@@ -249,33 +276,58 @@ int SearchWorker::negamax(int depth, int alpha, int beta, int ply, bool allow_nu
     {
         TableBase::WDL_Result r_tb = should_tb_probe(board, shared_tb);
         if (r_tb != TableBase::WDL_Result::FAIL)
+        {
+            SEARCH_TRACE_REASON(TableBase);
             return wdl_score(r_tb, ply);
+        }
     }
 
     if (ply >= engine_constants::search::MaxDepth)
+    {
+        SEARCH_TRACE_REASON(MaxPly);
         return Eval::lazy_eval_relative<Us>(board);
+    }
 
+    SEARCH_STAT(stats.nodes);
     const bool is_pv = (beta - alpha > 1);
     const bool in_check = board.is_king_attacked<Us>();
     const bool is_mate_node = (alpha < engine_constants::eval::MateScore && beta > -engine_constants::eval::MateScore && in_check);
 
     if (search::razoring<Us>(board, depth, alpha, is_pv, in_check, ply))
+    {
+        SEARCH_STAT(stats.razoring);
+        SEARCH_TRACE_REASON(Razoring);
         return qsearch<Us>(alpha, beta, ply);
+    }
 
     Move tt_move = 0;
     {
         TTFlag flag;
         int tt_score;
         bool tt_hit = shared_tt.probe(board.get_hash(), depth, ply, alpha, beta, tt_score, tt_move, flag);
+        SEARCH_STAT(stats.tt_probes);
+        if (tt_hit || tt_move != 0)
+            SEARCH_STAT(stats.tt_hits);
         if (tt_move != excluded_move && search::should_use_tt(tt_hit, ply, is_pv, flag, tt_score, beta))
+        {
+            SEARCH_STAT(stats.tt_cutoffs);
+            SEARCH_TRACE_REASON(TTCutoff);
             return tt_score;
+        }
     }
 
     if (search::should_qsearch(depth, ply, in_check))
+    {
+        SEARCH_TRACE_REASON(QSearch);
         return qsearch<Us>(alpha, beta, ply);
+    }
 
     if (search::reverse_futility_pruning<Us>(board, depth, ply, in_check, is_pv, beta))
+    {
+        SEARCH_STAT(stats.rfp);
+        SEARCH_TRACE_REASON(ReverseFutility);
         return beta;
+    }
 
     // =============================== Search ===============================
 
@@ -284,15 +336,21 @@ int SearchWorker::negamax(int depth, int alpha, int beta, int ply, bool allow_nu
     {
         int return_score;
         if (search::nmp<Us>(*this, depth, ply, allow_null, in_check, is_mate_node, alpha, beta, return_score))
+        {
+            SEARCH_TRACE_REASON(NullMove);
             return return_score;
+        }
     }
 
     const bool futil_pruning = search::should_futility_pruning<Us>(board, depth, ply, in_check, is_pv, is_mate_node, alpha);
+    CheckInfo check_info;
+    board.compute_check_info<Us>(check_info);
 
     const auto *history = board.get_history();
     const Move prev_m = ply > 0 ? history->back().move : 0;
     const Move prev_prev_m = (history->size() >= 2) ? (*history)[history->size() - 2].move : 0;
-    MovePicker list(board, tt_move, ply, prev_m, thread_id);
+    MovePicker list(board, tt_move, ply, prev_m, thread_id, check_info);
+    save_node(ply);
 
     // 7. PVS Loop (Principal Variation Search)
     int alpha_orig = alpha;
@@ -320,25 +378,26 @@ int SearchWorker::negamax(int depth, int alpha, int beta, int ply, bool allow_nu
         int score;
         const bool is_tactical = list.current_is_tactical;
         if (search::should_lmp(in_check, depth, is_tactical, moves_searched))
+        {
+            SEARCH_STAT(stats.lmp);
             continue;
+        }
 
-        if (futil_pruning && moves_searched >= 1 && !is_tactical)
+        const bool gives_check = board.gives_check<Us>(m, check_info);
+        if (futil_pruning && moves_searched >= 1 && !is_tactical && !gives_check)
         {
-            board.play<Us>(m);
-            bool gives_check_for_futility = board.is_king_attacked<!Us>();
-            board.unplay<Us>(m);
-
-            if (!gives_check_for_futility)
-                continue;
+            SEARCH_STAT(stats.futility);
+            continue;
         }
         if (search::should_see_pruning<Us>(*this, in_check, is_pv, depth, moves_searched, tt_move, m))
+        {
+            SEARCH_STAT(stats.see_prunes);
             continue;
+        }
 
         ++moves_searched;
 
-        board.play<Us>(m);
-
-        bool gives_check = board.is_king_attacked<!Us>();
+        make_move<Us>(m);
 
         int extension = 0;
         if (gives_check && depth >= 2)
@@ -368,11 +427,14 @@ int SearchWorker::negamax(int depth, int alpha, int beta, int ply, bool allow_nu
             score = -negamax<!Us>(new_depth, -beta, -alpha, ply + 1, true);
         }
 
-        board.unplay<Us>(m);
+        unmake_move<Us>(m, ply);
 
         // --- MISE À JOUR DES SCORES ET DES TABLES ---
         if (score >= beta)
         {
+            SEARCH_STAT(stats.fail_highs);
+            if (moves_searched == 1)
+                SEARCH_STAT(stats.fail_highs_first);
             shared_tt.store(board.get_hash(), depth, ply, score, TT_BETA, m);
 
             if (!is_tactical)
@@ -418,6 +480,7 @@ int SearchWorker::negamax(int depth, int alpha, int beta, int ply, bool allow_nu
                     killer_moves[ply][0] = m;
                 }
             }
+            SEARCH_TRACE_REASON(FailHigh);
             return score;
         }
 
@@ -441,18 +504,44 @@ int SearchWorker::negamax(int depth, int alpha, int beta, int ply, bool allow_nu
     {
         int score = in_check ? -engine_constants::eval::MateScore + ply : 0;
         shared_tt.store(board.get_hash(), depth, ply, score, TT_EXACT, 0);
+        SEARCH_TRACE_REASON(Terminal);
         return score;
     }
 
     if (shared_stop.load(std::memory_order_relaxed)) // We don't write in TT if shared_stop
+    {
+        SEARCH_TRACE_REASON(Stopped);
         return best_score;
+    }
 
     // 9. Sauvegarde TT Finale
     TTFlag flag = (best_score <= alpha_orig) ? TT_ALPHA : TT_EXACT;
     shared_tt.store(board.get_hash(), depth, ply, best_score, flag, best_move_this_node);
 
+    SEARCH_TRACE_REASON(Searched);
     return best_score;
 }
 
+template <Color Us>
+int SearchWorker::negamax(int depth, int alpha, int beta, int ply, bool allow_null, Move excluded_move)
+{
+#ifdef SEARCH_TRACE
+    if (tracer)
+    {
+        // Fils d'un coup nul : allow_null faux hors recherche singulière, l'historique ne contient pas le coup nul
+        const bool after_null = ply > 0 && !allow_null && excluded_move == 0;
+        const Move move = (ply > 0 && !after_null) ? board.get_history()->back().move : Move(0);
+        const std::uint8_t flags = (beta - alpha > 1 ? search_trace::PvWindow : 0) |
+                                   (excluded_move != 0 ? search_trace::Singular : 0) |
+                                   (after_null ? search_trace::AfterNullMove : 0);
+        const size_t slot = tracer->enter(move, alpha, beta, ply, depth, flags);
+        const int score = negamax_node<Us>(depth, alpha, beta, ply, allow_null, excluded_move);
+        tracer->exit(slot, score, trace_reason);
+        return score;
+    }
+#endif
+    return negamax_node<Us>(depth, alpha, beta, ply, allow_null, excluded_move);
+}
+
 template int SearchWorker::negamax<WHITE>(int depth, int alpha, int beta, int ply, bool allow_null, Move excluded_move);
 template int SearchWorker::negamax<BLACK>(int depth, int alpha, int beta, int ply, bool allow_null, Move excluded_move);
\ No newline at end of file
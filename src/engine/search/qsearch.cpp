@@ -6,6 +6,7 @@ int SearchWorker::qsearch(int alpha, int beta, int ply)
 {
     if (check_stop())
         return alpha;
+    SEARCH_STAT(stats.qnodes);
 
     // 2. Sondage de la Transposition Table (TT)
     // Utilisation du ply pour normaliser les scores de mat récupérés
@@ -43,17 +44,21 @@ int SearchWorker::qsearch(int alpha, int beta, int ply)
     }
 
     // 5. Tri des coups (SEE + MVV-LVA)
+    CheckInfo check_info;
+    if (in_check)
+        board.compute_check_info<Us>(check_info);
     for (int i = 0; i < list.count; ++i)
     {
         Move &m = list[i];
         if (m == tt_move) // On priorise le coup TT s'il existe
             list.scores[i] = 2000000;
         else if (in_check)
-            list.scores[i] = score_move<Us>(m, tt_move, ply, 0);
+            list.scores[i] = score_move<Us>(m, tt_move, ply, 0, check_info);
         else
             list.scores[i] = score_capture(m); // Juste MVV/LVA, pas de SEE !
     }
 
+    save_node(ply);
     int best_score = in_check ? -engine_constants::eval::Inf : stand_pat;
     int moves_searched = 0;
     int alpha_orig = alpha;
@@ -81,17 +86,17 @@ int SearchWorker::qsearch(int alpha, int beta, int ply)
             }
         }
 
-        board.play<Us>(m);
+        make_move<Us>(m);
         if (board.is_king_attacked<Us>())
         {
-            board.unplay<Us>(m);
+            unmake_move<Us>(m, ply);
             continue;
         }
 
         moves_searched++;
         // Appel récursif avec ply+1 pour la détection précise des mats
         int score = -qsearch<!Us>(-beta, -alpha, ply + 1);
-        board.unplay<Us>(m);
+        unmake_move<Us>(m, ply);
 
         if (score >= beta)
         {
@@ -0,0 +1,92 @@
+#pragma once
+
+// Statistiques de recherche, compilées seulement avec SEARCH_STATS (option CMake ENABLE_SEARCH_STATS).
+// Sans l'option, SEARCH_STAT(...) ne produit aucun code : la structure reste, les compteurs ne bougent pas.
+// Chaque SearchWorker compte dans ses propres champs (pas d'atomique) ; EngineManager les additionne à la fin
+// de chaque recherche.
+
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#ifdef SEARCH_STATS
+#define SEARCH_STAT(counter) (++(counter))
+#else
+#define SEARCH_STAT(counter) ((void)0)
+#endif
+
+struct SearchStats
+{
+    std::uint64_t nodes = 0;  // Entrées dans negamax (hors retours immédiats)
+    std::uint64_t qnodes = 0; // Entrées dans qsearch
+
+    std::uint64_t tt_probes = 0;
+    std::uint64_t tt_hits = 0;    // Entrée trouvée : coup ou score exploitable
+    std::uint64_t tt_cutoffs = 0; // Score de la TT retourné
+
+    std::uint64_t fail_highs = 0;
+    std::uint64_t fail_highs_first = 0; // Coupure sur le premier coup cherché
+
+    std::uint64_t razoring = 0;
+    std::uint64_t rfp = 0;
+    std::uint64_t nmp_tries = 0;
+    std::uint64_t nmp_cutoffs = 0;
+    std::uint64_t futility = 0; // Coups écartés
+    std::uint64_t lmp = 0;
+    std::uint64_t see_prunes = 0;
+
+    std::uint64_t lmr_searches = 0;
+    std::uint64_t lmr_researches = 0;
+
+    // Lus dans la table des pions (PawnTable::hits / misses) au moment du rapport, pas cumulés par add
+    std::uint64_t pawn_probes = 0;
+    std::uint64_t pawn_hits = 0;
+
+    void add(const SearchStats &o)
+    {
+        nodes += o.nodes;
+        qnodes += o.qnodes;
+        tt_probes += o.tt_probes;
+        tt_hits += o.tt_hits;
+        tt_cutoffs += o.tt_cutoffs;
+        fail_highs += o.fail_highs;
+        fail_highs_first += o.fail_highs_first;
+        razoring += o.razoring;
+        rfp += o.rfp;
+        nmp_tries += o.nmp_tries;
+        nmp_cutoffs += o.nmp_cutoffs;
+        futility += o.futility;
+        lmp += o.lmp;
+        see_prunes += o.see_prunes;
+        lmr_searches += o.lmr_searches;
+        lmr_researches += o.lmr_researches;
+    }
+
+    static double percent(std::uint64_t part, std::uint64_t total)
+    {
+        return total ? 100.0 * static_cast<double>(part) / static_cast<double>(total) : 0.0;
+    }
+
+    // Lignes "info string stats ..." : compteurs bruts puis taux en %
+    std::string format() const
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1);
+        out << "info string stats nodes " << nodes << " qnodes " << qnodes
+            << " qshare " << percent(qnodes, nodes + qnodes) << "%\n";
+        out << "info string stats tt probes " << tt_probes << " hits " << tt_hits
+            << " (" << percent(tt_hits, tt_probes) << "%) cutoffs " << tt_cutoffs
+            << " (" << percent(tt_cutoffs, tt_probes) << "%)\n";
+        out << "info string stats failhigh " << fail_highs << " first " << fail_highs_first
+            << " (" << percent(fail_highs_first, fail_highs) << "%)\n";
+        out << "info string stats prune razoring " << razoring << " rfp " << rfp
+            << " nmp " << nmp_cutoffs << "/" << nmp_tries << " (" << percent(nmp_cutoffs, nmp_tries) << "%)"
+            << " futility " << futility << " lmp " << lmp << " see " << see_prunes << "\n";
+        out << "info string stats lmr " << lmr_searches << " research " << lmr_researches
+            << " (" << percent(lmr_researches, lmr_searches) << "%)\n";
+        out << "info string stats pawn probes " << pawn_probes << " hits " << pawn_hits
+            << " (" << percent(pawn_hits, pawn_probes) << "%)";
+        return out.str();
+    }
+};
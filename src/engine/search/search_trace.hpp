@@ -0,0 +1,349 @@
+#pragma once
+
+// Trace de l'arbre exploré par negamax, pour comprendre une recherche anormalement lente.
+// Les points d'enregistrement ne sont compilés qu'avec SEARCH_TRACE (option CMake ENABLE_SEARCH_TRACE) ;
+// le format, l'écriture et l'analyse (commande tracestat) sont toujours disponibles.
+//
+// Un Tracer par thread, de capacité fixe : un enregistrement de 16 octets par nœud, en préordre.
+// La place est réservée à l'entrée du nœud (coup, fenêtre, profondeur) et complétée à la sortie
+// (score, raison). Une fois le tampon plein plus rien n'est enregistré : la trace reste un préfixe
+// cohérent de l'arbre, marqué tronqué.
+//
+// Fichier : pour chaque thread, un FileHeader puis ses enregistrements.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/mapped_file.hpp"
+#include "core/move/move.hpp"
+
+#ifdef SEARCH_TRACE
+#define SEARCH_TRACE_REASON(r) (trace_reason = search_trace::Reason::r)
+#else
+#define SEARCH_TRACE_REASON(r) ((void)0)
+#endif
+
+namespace search_trace
+{
+    // Pourquoi le nœud a rendu la main
+    enum class Reason : std::uint8_t
+    {
+        Searched,  // Tous les coups cherchés
+        FailHigh,  // Coupure beta dans la boucle de coups
+        Stopped,   // Arrêt de la recherche
+        Draw,      // Répétition, 50 coups ou répétition atteignable
+        TableBase, // Sonde Syzygy
+        MaxPly,
+        Razoring,
+        TTCutoff,
+        QSearch, // Profondeur épuisée
+        ReverseFutility,
+        NullMove,
+        Terminal, // Mat ou pat
+        Count
+    };
+
+    inline const char *reason_name(Reason r)
+    {
+        static constexpr const char *names[] = {"searched", "failhigh", "stopped", "draw", "tb", "maxply",
+                                                "razoring", "tt", "qsearch", "rfp", "nmp", "terminal"};
+        return r < Reason::Count ? names[static_cast<int>(r)] : "?";
+    }
+
+    enum Flags : std::uint8_t
+    {
+        PvWindow = 1,      // beta - alpha > 1
+        Singular = 2,      // Recherche d'exclusion (extension singulière)
+        AfterNullMove = 4, // Nœud fils d'un coup nul : move vaut 0
+    };
+
+    struct Record
+    {
+        std::uint32_t move; // Coup menant au nœud (0 : racine ou coup nul)
+        std::int16_t alpha;
+        std::int16_t beta;
+        std::int16_t score;
+        std::uint8_t level; // Profondeur d'imbrication des appels (IID et recherches singulières comprises)
+        std::uint8_t ply;
+        std::int8_t depth;
+        std::uint8_t reason;
+        std::uint8_t flags;
+        std::uint8_t pad = 0;
+    };
+    static_assert(sizeof(Record) == 16);
+
+    struct FileHeader
+    {
+        static constexpr std::uint32_t Magic = 0x52363243; // "C26R" (distinct du checkpoint Texel "C26T")
+        static constexpr std::uint32_t Version = 1;
+
+        std::uint32_t magic = Magic;
+        std::uint32_t version = Version;
+        std::uint32_t record_size = sizeof(Record);
+        std::uint32_t thread = 0;
+        std::uint64_t count = 0;
+        std::uint64_t root_key = 0;
+        std::uint32_t truncated = 0;
+        std::uint32_t reserved = 0;
+    };
+    static_assert(sizeof(FileHeader) == 40);
+
+    inline std::int16_t clamp16(int v)
+    {
+        return static_cast<std::int16_t>(std::clamp(v, -32000, 32000));
+    }
+
+    class Tracer
+    {
+        std::vector<Record> records;
+        size_t capacity;
+        int level = 0;
+        bool truncated = false;
+
+    public:
+        static constexpr size_t NoSlot = std::numeric_limits<size_t>::max();
+
+        // Tampon réservé d'avance : aucune réallocation pendant la recherche
+        explicit Tracer(size_t max_records) : capacity(max_records)
+        {
+            records.reserve(capacity);
+        }
+
+        size_t enter(Move move, int alpha, int beta, int ply, int depth, std::uint8_t flags)
+        {
+            const int l = level++;
+            if (truncated || records.size() >= capacity || l > 255)
+            {
+                truncated = true;
+                return NoSlot;
+            }
+            records.push_back({move.get_value(), clamp16(alpha), clamp16(beta), 0, static_cast<std::uint8_t>(l),
+                               static_cast<std::uint8_t>(std::min(ply, 255)), static_cast<std::int8_t>(std::clamp(depth, -128, 127)),
+                               static_cast<std::uint8_t>(Reason::Searched), flags});
+            return records.size() - 1;
+        }
+
+        void exit(size_t slot, int score, Reason reason)
+        {
+            --level;
+            if (slot == NoSlot)
+                return;
+            records[slot].score = clamp16(score);
+            records[slot].reason = static_cast<std::uint8_t>(reason);
+        }
+
+        const std::vector<Record> &get_records() const { return records; }
+        bool is_truncated() const { return truncated; }
+    };
+
+    // Une section par thread, dans l'ordre des threads
+    inline bool write(const std::string &path, const std::vector<Tracer> &tracers, std::uint64_t root_key)
+    {
+        const std::string tmp = path + ".tmp";
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        for (size_t t = 0; t < tracers.size(); ++t)
+        {
+            const std::vector<Record> &records = tracers[t].get_records();
+            FileHeader header;
+            header.thread = static_cast<std::uint32_t>(t);
+            header.count = records.size();
+            header.root_key = root_key;
+            header.truncated = tracers[t].is_truncated();
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(Record)));
+        }
+        out.close();
+        if (!out)
+            return false;
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        return !ec;
+    }
+
+    struct Section
+    {
+        FileHeader header;
+        std::vector<Record> records;
+    };
+
+    inline bool read(const std::string &path, std::vector<Section> &sections)
+    {
+        sections.clear();
+        file::MappedFile file;
+        if (!file.open(path, file::Access::Sequential))
+            return false;
+
+        size_t offset = 0;
+        while (offset < file.size())
+        {
+            Section s;
+            if (file.size() - offset < sizeof(FileHeader))
+                return false;
+            std::memcpy(&s.header, file.data() + offset, sizeof(FileHeader));
+            offset += sizeof(FileHeader);
+            if (s.header.magic != FileHeader::Magic || s.header.version != FileHeader::Version ||
+                s.header.record_size != sizeof(Record) || (file.size() - offset) / sizeof(Record) < s.header.count)
+                return false;
+            s.records.resize(s.header.count);
+            std::memcpy(s.records.data(), file.data() + offset, s.header.count * sizeof(Record));
+            offset += s.header.count * sizeof(Record);
+            sections.push_back(std::move(s));
+        }
+        return !sections.empty();
+    }
+
+    // Arbre reconstruit depuis le préordre : taille des sous-arbres (nœud compris) et parent de chaque nœud
+    struct Tree
+    {
+        std::vector<size_t> size;
+        std::vector<size_t> parent;
+        std::vector<size_t> children; // Nombre de fils directs
+
+        static constexpr size_t None = std::numeric_limits<size_t>::max();
+
+        explicit Tree(const std::vector<Record> &records)
+            : size(records.size(), 1), parent(records.size(), None), children(records.size(), 0)
+        {
+            std::vector<size_t> stack;
+            for (size_t i = 0; i <= records.size(); ++i)
+            {
+                while (!stack.empty() && (i == records.size() || records[stack.back()].level >= records[i].level))
+                {
+                    size[stack.back()] = i - stack.back();
+                    stack.pop_back();
+                }
+                if (i == records.size())
+                    break;
+                if (!stack.empty())
+                {
+                    parent[i] = stack.back();
+                    ++children[stack.back()];
+                }
+                stack.push_back(i);
+            }
+        }
+    };
+
+    struct Options
+    {
+        size_t top = 10;              // Points d'explosion listés
+        double explode_factor = 4.0;  // Sous-arbre >= facteur x moyenne de ses frères
+        double min_share = 0.005;     // ... et >= cette part de la section
+    };
+
+    inline std::string move_name(const Record &r)
+    {
+        if (r.flags & AfterNullMove)
+            return "null";
+        return r.move ? Move(r.move).to_uci() : "root";
+    }
+
+    // Coups depuis la racine de l'itération jusqu'au nœud
+    inline std::string path_of(const std::vector<Record> &records, const Tree &tree, size_t i)
+    {
+        std::vector<std::string> moves;
+        for (size_t n = i; n != Tree::None && records[n].level > 0; n = tree.parent[n])
+            moves.push_back(move_name(records[n]) + ((records[n].flags & Singular) ? "(se)" : ""));
+        std::string out;
+        for (auto it = moves.rbegin(); it != moves.rend(); ++it)
+            out += (out.empty() ? "" : " ") + *it;
+        return out;
+    }
+
+    // Résumé d'une section : nœuds par raison, sous-arbres par coup racine, points d'explosion
+    inline std::string summarize(const Section &section, const Options &options = {})
+    {
+        const std::vector<Record> &records = section.records;
+        const Tree tree(records);
+        const size_t total = records.size();
+        std::ostringstream out;
+        out << "info string trace thread " << section.header.thread << " nodes " << total
+            << (section.header.truncated ? " truncated" : "") << "\n";
+        if (total == 0)
+            return out.str();
+
+        size_t by_reason[static_cast<int>(Reason::Count) + 1] = {};
+        for (const Record &r : records)
+            ++by_reason[std::min<int>(r.reason, static_cast<int>(Reason::Count))];
+        out << "info string trace reasons";
+        for (int r = 0; r < static_cast<int>(Reason::Count); ++r)
+            if (by_reason[r])
+                out << " " << reason_name(static_cast<Reason>(r)) << " " << by_reason[r];
+        out << "\n";
+
+        // Coups racine : fils directs d'un nœud de ply 0, cumulés sur toutes les itérations
+        struct RootMove
+        {
+            std::uint32_t move;
+            size_t nodes = 0;
+            size_t visits = 0;
+            int depth = 0;
+            int score = 0;
+        };
+        std::vector<RootMove> roots;
+        for (size_t i = 0; i < total; ++i)
+        {
+            const size_t p = tree.parent[i];
+            if (p == Tree::None || records[p].ply != 0 || records[i].ply != 1)
+                continue;
+            auto it = std::find_if(roots.begin(), roots.end(), [&](const RootMove &m)
+                                   { return m.move == records[i].move; });
+            if (it == roots.end())
+                it = roots.insert(roots.end(), RootMove{records[i].move});
+            it->nodes += tree.size[i];
+            ++it->visits;
+            it->depth = records[p].depth;
+            it->score = -records[i].score;
+        }
+        std::stable_sort(roots.begin(), roots.end(), [](const RootMove &a, const RootMove &b)
+                         { return a.nodes > b.nodes; });
+        for (const RootMove &m : roots)
+            out << "info string trace root " << Move(m.move).to_uci() << " nodes " << m.nodes
+                << " share " << 100 * m.nodes / total << "% visits " << m.visits
+                << " last depth " << m.depth << " score " << m.score << "\n";
+
+        // Points d'explosion : sous-arbres bien plus gros que ceux de leurs frères
+        struct Point
+        {
+            size_t index;
+            double ratio;
+        };
+        std::vector<Point> points;
+        for (size_t i = 0; i < total; ++i)
+        {
+            const size_t p = tree.parent[i];
+            if (p == Tree::None || tree.children[p] < 2 || tree.size[i] < options.min_share * total)
+                continue;
+            const double siblings_mean = static_cast<double>(tree.size[p] - 1) / tree.children[p];
+            const double ratio = tree.size[i] / siblings_mean;
+            if (ratio >= options.explode_factor)
+                points.push_back({i, ratio});
+        }
+        // Le plus profond d'abord à taille égale : c'est là que l'arbre diverge
+        std::stable_sort(points.begin(), points.end(), [&](const Point &a, const Point &b)
+                         { return tree.size[a.index] != tree.size[b.index] ? tree.size[a.index] > tree.size[b.index]
+                                                                           : records[a.index].level > records[b.index].level; });
+        if (points.size() > options.top)
+            points.resize(options.top);
+        for (const Point &pt : points)
+        {
+            const Record &r = records[pt.index];
+            out << "info string trace explode nodes " << tree.size[pt.index]
+                << " x" << static_cast<int>(pt.ratio * 10) / 10.0
+                << " ply " << static_cast<int>(r.ply) << " depth " << static_cast<int>(r.depth)
+                << " window [" << r.alpha << "," << r.beta << "] score " << r.score
+                << " " << reason_name(static_cast<Reason>(r.reason))
+                << " path " << path_of(records, tree, pt.index) << "\n";
+        }
+        return out.str();
+    }
+}
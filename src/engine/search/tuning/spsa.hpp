@@ -0,0 +1,346 @@
+#pragma once
+
+#ifdef SPSA_TUNING
+
+// Tuner SPSA en processus, sans service externe.
+// À chaque itération, un vecteur de perturbation ±1 est tiré ; θ+ = θ + c_k·δ et θ- = θ - c_k·δ
+// s'affrontent en paires de parties à nombre de nœuds fixé (même ouverture, couleurs inversées),
+// une paire par thread. Puis θ += r_k·c_k·(gains - pertes de θ+)·δ, avec le calendrier d'OpenBench.
+// Chaque thread de partie applique à ses paramètres thread_local les valeurs du camp qui joue.
+//
+// Configuration : une ligne par paramètre au format OpenBench
+//     nom, int|float, valeur, min, max, c_end, r_end
+// et des réglages « clé valeur » (iterations, pairs, nodes, hash, seed, output...).
+// Le fichier de sortie reprend ce format avec l'itération atteinte : il sert de point de reprise.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/logger.hpp"
+#include "core/move/generator/move_generator.hpp"
+#include "engine/config/search_params.hpp"
+#include "engine/data/selfplay.hpp"
+#include "engine/engine_manager.hpp"
+#include "engine/utils/random.hpp"
+
+namespace spsa
+{
+    struct Param
+    {
+        const search_params::Param *target = nullptr;
+        double value = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double c_end = 1.0;
+        double r_end = 0.002;
+    };
+
+    // Règles de partie par défaut de selfplay::Rules
+    struct Config : selfplay::Rules
+    {
+        std::vector<Param> params;
+        long long iterations = 1000;
+        long long iteration = 0; // Itérations déjà faites (reprise)
+        unsigned pairs = std::max(1u, std::thread::hardware_concurrency());
+        long long nodes = 5000;
+        size_t hash_mb = 8;
+        std::uint64_t seed = 0;
+        double alpha = 0.602;
+        double gamma = 0.101;
+        double a_ratio = 0.1; // A = a_ratio * iterations
+        int report_every = 10;
+        std::string output = "spsa_output.txt";
+    };
+
+    struct Step
+    {
+        double c;
+        double r;
+    };
+
+    // Pas de l'itération k (à partir de 1) : c_k décroît jusqu'à c_end, r_k jusqu'à r_end à la dernière itération
+    inline Step step_for(const Config &config, const Param &p, long long k)
+    {
+        const double n = static_cast<double>(config.iterations);
+        const double big_a = config.a_ratio * n;
+        const double c = p.c_end * std::pow(n, config.gamma);
+        const double a = p.r_end * p.c_end * p.c_end * std::pow(big_a + n, config.alpha);
+        const double c_k = c / std::pow(static_cast<double>(k), config.gamma);
+        const double a_k = a / std::pow(big_a + static_cast<double>(k), config.alpha);
+        return {c_k, a_k / (c_k * c_k)};
+    }
+
+    inline bool parse_config(std::istream &in, Config &config, std::string &error)
+    {
+        std::string line;
+        for (int line_no = 1; std::getline(in, line); ++line_no)
+        {
+            if (const auto hash = line.find('#'); hash != std::string::npos)
+                line.erase(hash);
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+                continue;
+
+            if (line.find(',') != std::string::npos)
+            {
+                std::replace(line.begin(), line.end(), ',', ' ');
+                std::istringstream is(line);
+                std::string name, type;
+                Param p;
+                if (!(is >> name >> type >> p.value >> p.min >> p.max >> p.c_end >> p.r_end) || (type != "int" && type != "float"))
+                {
+                    error = "line " + std::to_string(line_no) + " : expected name, int|float, value, min, max, c_end, r_end";
+                    return false;
+                }
+                p.target = search_params::find(name);
+                if (!p.target)
+                {
+                    error = "line " + std::to_string(line_no) + " : unknown parameter " + name;
+                    return false;
+                }
+                if (p.min > p.max || p.c_end <= 0.0)
+                {
+                    error = "line " + std::to_string(line_no) + " : bad bounds or c_end for " + name;
+                    return false;
+                }
+                p.value = std::clamp(p.value, p.min, p.max);
+                config.params.push_back(p);
+                continue;
+            }
+
+            std::istringstream is(line);
+            std::string key;
+            is >> key;
+            bool ok = true;
+            if (key == "iterations")
+                ok = static_cast<bool>(is >> config.iterations) && config.iterations > 0;
+            else if (key == "iteration")
+                ok = static_cast<bool>(is >> config.iteration) && config.iteration >= 0;
+            else if (key == "pairs")
+                ok = static_cast<bool>(is >> config.pairs) && config.pairs > 0;
+            else if (key == "nodes")
+                ok = static_cast<bool>(is >> config.nodes) && config.nodes > 0;
+            else if (key == "hash")
+                ok = static_cast<bool>(is >> config.hash_mb) && config.hash_mb > 0;
+            else if (key == "seed")
+                ok = static_cast<bool>(is >> config.seed);
+            else if (key == "random_plies")
+                ok = static_cast<bool>(is >> config.random_plies) && config.random_plies >= 0;
+            else if (key == "max_plies")
+                ok = static_cast<bool>(is >> config.max_plies) && config.max_plies > 0;
+            else if (key == "alpha")
+                ok = static_cast<bool>(is >> config.alpha);
+            else if (key == "gamma")
+                ok = static_cast<bool>(is >> config.gamma);
+            else if (key == "a_ratio")
+                ok = static_cast<bool>(is >> config.a_ratio) && config.a_ratio >= 0.0;
+            else if (key == "report_every")
+                ok = static_cast<bool>(is >> config.report_every) && config.report_every > 0;
+            else if (key == "output")
+                ok = static_cast<bool>(is >> config.output);
+            else
+            {
+                error = "line " + std::to_string(line_no) + " : unknown setting " + key;
+                return false;
+            }
+            if (!ok)
+            {
+                error = "line " + std::to_string(line_no) + " : bad value for " + key;
+                return false;
+            }
+        }
+        if (config.params.empty())
+        {
+            error = "no parameter to tune";
+            return false;
+        }
+        return true;
+    }
+
+    inline bool load_config(const std::string &path, Config &config, std::string &error)
+    {
+        std::ifstream in(path);
+        if (!in.is_open())
+        {
+            error = "cannot open " + path;
+            return false;
+        }
+        return parse_config(in, config, error);
+    }
+
+    inline bool save_config(const std::string &path, const Config &config)
+    {
+        std::ofstream out(path + ".tmp");
+        if (!out.is_open())
+            return false;
+        out.precision(10);
+        out << "# SPSA chess26 : relancer avec ce fichier pour reprendre\n"
+            << "iterations " << config.iterations << "\n"
+            << "iteration " << config.iteration << "\n"
+            << "pairs " << config.pairs << "\n"
+            << "nodes " << config.nodes << "\n"
+            << "hash " << config.hash_mb << "\n"
+            << "seed " << config.seed << "\n"
+            << "random_plies " << config.random_plies << "\n"
+            << "max_plies " << config.max_plies << "\n"
+            << "alpha " << config.alpha << "\n"
+            << "gamma " << config.gamma << "\n"
+            << "a_ratio " << config.a_ratio << "\n"
+            << "report_every " << config.report_every << "\n"
+            << "output " << config.output << "\n\n";
+        for (const Param &p : config.params)
+            out << p.target->name << ", " << (p.target->real ? "float" : "int") << ", " << p.value << ", "
+                << p.min << ", " << p.max << ", " << p.c_end << ", " << p.r_end << "\n";
+        out.close();
+        return out && std::rename((path + ".tmp").c_str(), path.c_str()) == 0;
+    }
+
+    class Tuner
+    {
+        Config config;
+        search_params::Values base;
+        long long wins = 0, draws = 0, losses = 0; // Du point de vue de θ+, depuis le lancement
+
+        // Ouverture aléatoire déterministe ; vide si une position sans coup est atteinte
+        std::vector<Move> random_opening(std::uint64_t rng) const
+        {
+            VBoard board;
+            board.load_fen(constants::FenInitPos);
+            std::vector<Move> moves;
+            if (!selfplay::random_opening(board, config.random_plies, rng, &moves))
+                return {};
+            return moves;
+        }
+
+        // Résultat du point de vue des blancs : 1, 0 ou -1
+        int play_game(const std::vector<Move> &opening, EngineManager *managers[2], const search_params::Values *values[2]) const
+        {
+            VBoard board;
+            board.load_fen(constants::FenInitPos);
+            for (const Move m : opening)
+                board.play(m);
+            managers[WHITE]->clear();
+            managers[BLACK]->clear();
+
+            auto search = [&](const VBoard &position, Color us)
+            {
+                search_params::apply(*values[us]);
+                return managers[us]->search_nodes(position, config.nodes);
+            };
+            return selfplay::play(board, static_cast<int>(opening.size()), config, search, [](const selfplay::Ply &)
+                                  { return true; });
+        }
+
+        // Une paire : θ+ avec les blancs puis avec les noirs. results[0..1] du point de vue de θ+
+        void play_pair(long long iteration, unsigned pair, const search_params::Values &plus, const search_params::Values &minus, int results[2]) const
+        {
+            VBoard root_plus, root_minus;
+            EngineManager plus_manager(root_plus, config.hash_mb), minus_manager(root_minus, config.hash_mb);
+            search_params::apply(plus);
+            plus_manager.init_lmr_table();
+            search_params::apply(minus);
+            minus_manager.init_lmr_table();
+
+            std::vector<Move> opening;
+            for (std::uint64_t attempt = 0; attempt < 64 && opening.empty() && config.random_plies > 0; ++attempt)
+                opening = random_opening(config.seed ^ engine::random::splitmix64((static_cast<std::uint64_t>(iteration) << 20) + pair * 64 + attempt));
+
+            EngineManager *white_plus[2] = {&plus_manager, &minus_manager};
+            const search_params::Values *white_plus_values[2] = {&plus, &minus};
+            results[0] = play_game(opening, white_plus, white_plus_values);
+
+            EngineManager *black_plus[2] = {&minus_manager, &plus_manager};
+            const search_params::Values *black_plus_values[2] = {&minus, &plus};
+            results[1] = -play_game(opening, black_plus, black_plus_values);
+        }
+
+        void report(long long iteration, double seconds) const
+        {
+            const long long games = wins + draws + losses;
+            logs::uci << "info string spsa iteration " << iteration << "/" << config.iterations
+                      << " games " << games << " +" << wins << " =" << draws << " -" << losses
+                      << " time " << static_cast<long long>(seconds) << "s" << std::endl;
+            for (const Param &p : config.params)
+                logs::uci << "info string spsa " << p.target->name << " " << p.value << std::endl;
+        }
+
+    public:
+        explicit Tuner(const Config &c) : config(c), base(search_params::capture()) {}
+
+        const Config &get_config() const { return config; }
+
+        // Une itération : perturbation, parties en parallèle, mise à jour de θ
+        void iterate()
+        {
+            const long long k = ++config.iteration;
+            std::uint64_t rng = engine::random::splitmix64(config.seed ^ (static_cast<std::uint64_t>(k) * 0x9e3779b97f4a7c15ULL));
+
+            search_params::Values plus = base, minus = base;
+            std::vector<double> delta(config.params.size());
+            std::vector<Step> steps(config.params.size());
+            for (std::size_t i = 0; i < config.params.size(); ++i)
+            {
+                const Param &p = config.params[i];
+                rng = engine::random::splitmix64(rng);
+                delta[i] = (rng & 1) ? 1.0 : -1.0;
+                steps[i] = step_for(config, p, k);
+                const std::size_t idx = search_params::index_of(p.target);
+                plus[idx] = std::clamp(p.value + steps[i].c * delta[i], p.min, p.max);
+                minus[idx] = std::clamp(p.value - steps[i].c * delta[i], p.min, p.max);
+            }
+
+            std::vector<int> results(2 * config.pairs, 0);
+            {
+                std::vector<std::jthread> threads;
+                for (unsigned pair = 0; pair < config.pairs; ++pair)
+                    threads.emplace_back([&, pair]()
+                                         { play_pair(k, pair, plus, minus, &results[2 * pair]); });
+            }
+
+            int score = 0;
+            for (const int r : results)
+            {
+                score += r;
+                wins += (r > 0);
+                draws += (r == 0);
+                losses += (r < 0);
+            }
+            for (std::size_t i = 0; i < config.params.size(); ++i)
+            {
+                Param &p = config.params[i];
+                p.value = std::clamp(p.value + steps[i].r * steps[i].c * score * delta[i], p.min, p.max);
+            }
+        }
+
+        bool run()
+        {
+            const auto start = std::chrono::steady_clock::now();
+            logs::uci << "info string spsa " << config.params.size() << " params " << config.pairs << " pairs/iteration "
+                      << config.nodes << " nodes/move from iteration " << config.iteration << "/" << config.iterations << std::endl;
+
+            while (config.iteration < config.iterations)
+            {
+                iterate();
+                if (config.iteration % config.report_every == 0 || config.iteration == config.iterations)
+                {
+                    report(config.iteration, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+                    if (!save_config(config.output, config))
+                    {
+                        logs::uci << "info string spsa cannot write " << config.output << std::endl;
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    };
+}
+
+#endif
@@ -9,7 +9,7 @@
 #include "worker.hpp"
 
 template <Color Us>
-int SearchWorker::score_move(const Move &move, const Move &tt_move, int ply, const Move &prev_move) const
+int SearchWorker::score_move(const Move &move, const Move &tt_move, int ply, const Move &prev_move, const CheckInfo &check_info) const
 {
     const uint32_t move_val = move.get_value();
     if (move_val == tt_move.get_value())
@@ -60,8 +60,8 @@ int SearchWorker::score_move(const Move &move, const Move &tt_move, int ply, con
         return 7500;
 
     // Bonus spécial pour les échecs "calmes" (Crucial pour mat en 11)
-    // Attention : nécessite que ta MoveGen ou une fonction légère détecte l'échec
-    // if (gives_check(move)) return 6000000;
+    if (board.gives_check<Us>(move, check_info))
+        return 7000;
 
     // 3. History Moves (Score relatif)
     return history_moves[Us][move.get_from_sq()][move.get_to_sq()];
@@ -199,16 +199,14 @@ int SearchWorker::negamax_with_aspiration(int depth, int last_score)
         ++iterations;
         int score = negamax(depth, alpha, beta, 0);
 
-        if (abs(score) >= engine_constants::eval::MateScore - depth)
+        // Mat dans la fenêtre (ou fenêtre déjà complète) : score exact, out_move est le coup qui y mène.
+        // Hors fenêtre, out_move peut dater d'une itération précédente : on élargit ci-dessous.
+        const bool full_window = alpha <= -engine_constants::eval::MateScore && beta >= engine_constants::eval::MateScore;
+        if (abs(score) >= engine_constants::eval::MateScore - depth && (full_window || (score > alpha && score < beta)))
         {
+            best_root_move = out_move;
             return score;
         }
-        if (abs(score) >= engine_constants::eval::MateScore - engine_constants::search::aspiration::MateWindowMargin)
-        {
-            alpha = -engine_constants::eval::MateScore;
-            beta = engine_constants::eval::MateScore;
-            continue;
-        }
 
         if (shared_stop.load(std::memory_order_relaxed))
             return score;
@@ -217,8 +215,13 @@ int SearchWorker::negamax_with_aspiration(int depth, int last_score)
         {
             shared_stop.store(true, std::memory_order_relaxed);
             return score;
-            // 2. Vérification de pseudo-légalité AVANT de toucher au board
-            // Cela évite les asserts ou crashs dans is_move_legal si m est corrompu
+        }
+
+        if (!full_window && abs(score) >= engine_constants::eval::MateScore - engine_constants::search::aspiration::MateWindowMargin)
+        {
+            alpha = -engine_constants::eval::MateScore;
+            beta = engine_constants::eval::MateScore;
+            continue;
         }
 
         // Succès : score dans la fenêtre
@@ -258,13 +261,15 @@ int SearchWorker::negamax_with_aspiration(int depth, int last_score)
 void SearchWorker::iterative_deepening()
 {
     int last_score = 0;
-    for (int depth = 1; depth < engine_constants::search::MaxDepth; ++depth)
+    const int limit = manager.get_depth_limit();
+    const int last_depth = limit > 0 ? std::min(limit, engine_constants::search::MaxDepth - 1) : engine_constants::search::MaxDepth - 1;
+    for (int depth = 1; depth <= last_depth; ++depth)
     {
         age_history();
         last_score = negamax_with_aspiration(depth, last_score);
         if (shared_stop.load(std::memory_order_relaxed))
         {
-            if (thread_id == 0)
+            if (thread_id == 0 && manager.reports_uci())
             {
                 auto elapsed_ms = std::max<long long>(1,
                                                       std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -314,6 +319,8 @@ void SearchWorker::iterative_deepening()
     if (thread_id == 0)
     {
         shared_stop.store(true, std::memory_order_relaxed);
+        if (!manager.reports_uci())
+            return;
         auto elapsed_ms = std::max<long long>(1,
                                               std::chrono::duration_cast<std::chrono::milliseconds>(
                                                   std::chrono::steady_clock::now() - start_time_ref)
@@ -322,9 +329,9 @@ void SearchWorker::iterative_deepening()
         long long nodes = global_nodes.load(std::memory_order_relaxed);
         long long nps = nodes * 1000 / elapsed_ms;
         const Move pv_root = best_root_move.get_value() != 0 ? best_root_move : out_move;
-        const std::string pv_line = get_pv_line_with_root(pv_root, engine_constants::search::MaxDepth - 1);
+        const std::string pv_line = get_pv_line_with_root(pv_root, last_depth);
         logs::uci
-            << "info depth " << engine_constants::search::MaxDepth - 1
+            << "info depth " << last_depth
             << " seldepth " << max_extended_depth
             << " score cp " << last_score
             << " nodes " << nodes
@@ -339,7 +346,7 @@ void SearchWorker::iterative_deepening()
 
 bool SearchWorker::check_stop()
 {
-    if ((local_nodes & 32767) == 0)
+    if ((local_nodes & node_check_mask) == 0)
     {
         global_nodes.fetch_add(local_nodes, std::memory_order_relaxed);
         local_nodes = 0;
@@ -355,5 +362,5 @@ bool SearchWorker::check_stop()
     return false;
 }
 
-template int SearchWorker::score_move<WHITE>(const Move &move, const Move &tt_move, int ply, const Move &prev_move) const;
-template int SearchWorker::score_move<BLACK>(const Move &move, const Move &tt_move, int ply, const Move &prev_move) const;
\ No newline at end of file
+template int SearchWorker::score_move<WHITE>(const Move &move, const Move &tt_move, int ply, const Move &prev_move, const CheckInfo &check_info) const;
+template int SearchWorker::score_move<BLACK>(const Move &move, const Move &tt_move, int ply, const Move &prev_move, const CheckInfo &check_info) const;
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include "engine/eval/pos_eval.hpp"
 #include "engine/tt/transp_table.hpp"
 #include "engine/eval/virtual_board.hpp"
+#include "engine/search/search_stats.hpp"
+#include "engine/search/search_trace.hpp"
 
 class EngineManager;
 
@@ -34,8 +36,26 @@ struct SearchWorker
     int continuation_hist_2[2][7][64][64];  // [side][piece][from][to] for 2-ply continuation
     std::array<Move, engine_constants::search::MaxDepth> move_stack;
 
+#ifdef COPY_MAKE
+    // Copy-make : une copie compacte de la position par ply, restaurée au lieu de unplay
+    struct PlySnapshot
+    {
+        Position position;
+        EvalState eval_state;
+        int accumulator_height;
+    };
+    static constexpr int PlyStackSize = 2 * engine_constants::search::MaxDepth;
+    std::array<PlySnapshot, PlyStackSize> ply_stack;
+#endif
+
     // Métriques locales
     long long local_nodes = 0;
+    int node_check_mask = 32767; // Compteur publié et arrêt vérifié tous les node_check_mask + 1 nœuds
+    SearchStats stats;           // Alimenté seulement avec SEARCH_STATS
+#ifdef SEARCH_TRACE
+    search_trace::Tracer *tracer = nullptr; // Trace de ce thread, si demandée (commande trace)
+    search_trace::Reason trace_reason = search_trace::Reason::Searched;
+#endif
     int thread_id;
 
     Move best_root_move = 0;
@@ -73,6 +93,9 @@ struct SearchWorker
     // --- Méthodes de recherche ---
     template <Color Us>
     int negamax(int depth, int alpha, int beta, int ply, bool allow_null, Move excluded_move = 0);
+    // Corps de negamax ; negamax l'enveloppe pour la trace
+    template <Color Us>
+    FORCE_INLINE int negamax_node(int depth, int alpha, int beta, int ply, bool allow_null, Move excluded_move);
     inline int negamax(int depth, int alpha, int beta, int ply)
     {
         if (board.get_side_to_move() == WHITE)
@@ -85,6 +108,46 @@ struct SearchWorker
     template <Color Us>
     int qsearch(int alpha, int beta, int ply);
 
+    // --- Make / unmake ---
+    // Saves the node position once before its move loop (no-op without COPY_MAKE)
+    FORCE_INLINE void save_node(int ply)
+    {
+#ifdef COPY_MAKE
+        if (ply < PlyStackSize)
+        {
+            board.save_position(ply_stack[ply].position);
+            ply_stack[ply].eval_state = board.get_eval_state();
+            ply_stack[ply].accumulator_height = board.get_accumulator_height();
+        }
+#else
+        (void)ply;
+#endif
+    }
+
+    template <Color Us>
+    FORCE_INLINE void make_move(const Move m)
+    {
+        board.play<Us>(m);
+    }
+
+    template <Color Us>
+    FORCE_INLINE void unmake_move(const Move m, int ply)
+    {
+#ifdef COPY_MAKE
+        if (ply < PlyStackSize)
+        {
+            board.restore_position(ply_stack[ply].position);
+            board.get_eval_state() = ply_stack[ply].eval_state;
+            if (NNUE::is_loaded())
+                board.set_accumulator_height(ply_stack[ply].accumulator_height);
+            return;
+        }
+#else
+        (void)ply;
+#endif
+        board.unplay<Us>(m);
+    }
+
     // --- Heuristiques ---
     void clear_heuristics()
     {
@@ -105,7 +168,7 @@ struct SearchWorker
 
     // --- utilitaires ---
     template <Color Us>
-    int score_move(const Move &move, const Move &tt_move, int ply, const Move &prev_move) const;
+    int score_move(const Move &move, const Move &tt_move, int ply, const Move &prev_move, const CheckInfo &check_info) const;
     int score_capture(const Move &move) const;
     int score_quiet_history(int raw_score, const Move &move, const Move &prev_move, const Move &prev_prev_move, Color us) const;
     template <Color Side>
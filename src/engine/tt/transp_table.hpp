@@ -1,10 +1,17 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <string>
 
 #include "common/cpu.hpp"
+#include "common/mapped_file.hpp"
 #include "core/move/move.hpp"
 #include "engine/config/config.hpp"
+#include "engine/utils/random.hpp"
 
 enum TTFlag : std::uint8_t
 {
@@ -53,11 +60,30 @@ struct alignas(64) TTBucket
     TTEntry entries[4];
 };
 
+// Fichier de TT sauvegardée : en-tête puis entrées telles qu'en mémoire (clé, données XOR clé).
+// Les entrées sont réinsérées à la lecture : la taille de la table peut différer de celle de la sauvegarde.
+// eval_id identifie l'éval qui a produit les scores (Eval::fingerprint) : un fichier d'une autre éval est refusé.
+struct TTFileHeader
+{
+    static constexpr std::uint32_t Magic = 0x48363243; // "C26H"
+    static constexpr std::uint32_t Version = 2;
+
+    std::uint32_t magic = Magic;
+    std::uint32_t version = Version;
+    std::uint32_t entry_size = sizeof(TTEntry);
+    std::uint32_t min_depth = 0;
+    std::uint64_t count = 0;
+    std::uint64_t checksum = 0;
+    std::uint64_t eval_id = 0;
+};
+static_assert(sizeof(TTFileHeader) == 40);
+
 class TranspositionTable
 {
 private:
     std::unique_ptr<TTBucket[]> table;
     size_t bucket_count = 0;
+    size_t size_mb = 0;
     size_t index_mask = 0;
     std::uint8_t current_age = 0;
 
@@ -93,8 +119,12 @@ public:
         table = std::make_unique<TTBucket[]>(n);
         index_mask = n - 1;
         bucket_count = n;
+        size_mb = mb_size;
     }
 
+    // Taille demandée au dernier resize (option Hash)
+    size_t get_size_mb() const { return size_mb; }
+
     void clear()
     {
         if (!table)
@@ -111,6 +141,105 @@ public:
 
     void next_generation() { current_age = (current_age + 4) & 0xFC; }
 
+    // Somme de contrôle des entrées du fichier, dans l'ordre d'écriture
+    static uint64_t checksum_step(uint64_t h, const TTEntry &e)
+    {
+        return engine::random::splitmix64(h ^ e.key) ^ e.data;
+    }
+
+    // Écrit les entrées de profondeur >= min_depth (fichier temporaire puis renommage)
+    bool save(const std::string &path, int min_depth, std::uint64_t eval_id, size_t &written) const
+    {
+        written = 0;
+        if (!table)
+            return false;
+
+        const std::string tmp = path + ".tmp";
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+
+        TTFileHeader header;
+        header.min_depth = static_cast<std::uint32_t>(std::max(0, min_depth));
+        header.eval_id = eval_id;
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            for (const TTEntry &e : table[i].entries)
+            {
+                Move m;
+                int16_t s;
+                std::uint8_t d, f;
+                if (e.key == 0 || !e.load(e.key, m, s, d, f) || d < header.min_depth)
+                    continue;
+                out.write(reinterpret_cast<const char *>(&e), sizeof(e));
+                header.checksum = checksum_step(header.checksum, e);
+                ++header.count;
+            }
+        }
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.close();
+        if (!out)
+            return false;
+
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec)
+            return false;
+        written = header.count;
+        return true;
+    }
+
+    // Projette le fichier et réinsère ses entrées, marquées de la génération courante.
+    // Rien n'est inséré si l'en-tête (dont l'éval), la taille ou la somme de contrôle ne correspondent pas.
+    bool load(const std::string &path, std::uint64_t eval_id, size_t &loaded)
+    {
+        loaded = 0;
+        if (!table)
+            return false;
+
+        file::MappedFile file;
+        if (!file.open(path, file::Access::Sequential) || file.size() < sizeof(TTFileHeader))
+            return false;
+
+        TTFileHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        // Taille vérifiée par division : count * sizeof(TTEntry) pourrait déborder avec un count forgé
+        const size_t body = file.size() - sizeof(TTFileHeader);
+        if (header.magic != TTFileHeader::Magic || header.version != TTFileHeader::Version ||
+            header.entry_size != sizeof(TTEntry) || header.eval_id != eval_id ||
+            body % sizeof(TTEntry) != 0 || header.count != body / sizeof(TTEntry))
+            return false;
+
+        const char *data = file.data() + sizeof(TTFileHeader);
+        uint64_t checksum = 0;
+        for (uint64_t i = 0; i < header.count; ++i)
+        {
+            TTEntry e;
+            std::memcpy(&e, data + i * sizeof(TTEntry), sizeof(TTEntry));
+            checksum = checksum_step(checksum, e);
+        }
+        if (checksum != header.checksum)
+            return false;
+
+        for (uint64_t i = 0; i < header.count; ++i)
+        {
+            TTEntry e;
+            std::memcpy(&e, data + i * sizeof(TTEntry), sizeof(TTEntry));
+            Move m;
+            int16_t s;
+            std::uint8_t d, f;
+            e.load(e.key, m, s, d, f);
+            // Score déjà au format de la table : ply 0 le laisse tel quel
+            store(e.key, d, 0, s, f & 0x03, m);
+        }
+        loaded = header.count;
+        return true;
+    }
+
     void store(uint64_t key, int depth, int ply, int score, std::uint8_t flag, Move move)
     {
         TTBucket &bucket = table[key & index_mask];
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <cstddef>
 
 namespace engine::random
 {
@@ -11,4 +13,18 @@ namespace engine::random
         x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
         return x ^ (x >> 31);
     }
+
+    // Empreinte d'un bloc mémoire (mots de 8 octets, reste complété par des zéros)
+    inline uint64_t hash_bytes(const void *data, size_t size, uint64_t seed = 0)
+    {
+        const unsigned char *p = static_cast<const unsigned char *>(data);
+        uint64_t h = splitmix64(seed ^ size);
+        for (size_t i = 0; i < size; i += 8)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, p + i, size - i < 8 ? size - i : 8);
+            h = splitmix64(h ^ word);
+        }
+        return h;
+    }
 }
@@ -6,14 +6,23 @@
 #include <vector>
 #include <charconv>
 #include <cctype>
+#include <limits>
+#include <random>
 
 #include "common/file.hpp"
 #include "common/logger.hpp"
+#include "common/perf_counters.hpp"
 #include "core/board/board.hpp"
 #include "core/move/generator/move_generator.hpp"
+#include "core/move/generator/perft.hpp"
 
 #include "core/board/zobrist.hpp"
+#include "engine/data/analyze.hpp"
+#include "engine/data/bookgen.hpp"
+#include "engine/data/datagen.hpp"
+#include "engine/data/packed_io.hpp"
 #include "engine/eval/book.hpp"
+#include "engine/eval/nnue.hpp"
 #include "engine/engine_manager.hpp"
 #include "engine/config/config.hpp"
 
@@ -22,6 +31,7 @@
 #endif
 #ifdef SPSA_TUNING
 #include "interface/uci_option.hpp"
+#include "engine/search/tuning/spsa.hpp"
 #endif
 
 #ifdef TEXEL_TUNING
@@ -34,8 +44,37 @@ class UCI
 #ifdef SPSA_TUNING
     std::vector<UCIOption<int>> int_options;
     std::vector<UCIOption<double>> double_options;
+
+    // Une option UCI par entrée de CHESS26_SEARCH_PARAMS
+    void add_search_option(int *value, std::string_view name, long long min, long long max)
+    {
+        int_options.emplace_back(value, name, min, max);
+    }
+    void add_search_option(double *value, std::string_view name, long long min, long long max)
+    {
+        double_options.emplace_back(value, name, min, max);
+    }
 #endif
     bool ponder_enabled = true;
+    // TT sauvegardée rechargée après chaque vidage de la table (option HashFile), vide si aucune
+    std::string hash_file;
+    // Livre joué (option BookFile), vide si désactivé
+    std::string book_path = default_book_path();
+    // Tirage des coups du livre, graine aléatoire par processus
+    std::uint64_t book_rng = (std::uint64_t(std::random_device{}()) << 32) | std::random_device{}();
+
+    // Livre produit par bookgen s'il existe dans le dossier data, sinon le livre Polyglot fourni
+    static std::string default_book_path()
+    {
+        const std::string own = file::get_data_path("book.bin");
+        return std::filesystem::exists(own) ? own : file::get_data_path("komodo.bin");
+    }
+
+    // Valeur d'une option fichier qui désactive le fichier : vide, <empty>, <none> ou none
+    static bool is_no_file(const std::string &path)
+    {
+        return path.empty() || path == "<empty>" || path == "<none>" || path == "none";
+    }
 
     static bool parse_int(const std::string &s, int &out)
     {
@@ -52,6 +91,12 @@ class UCI
         return ec == std::errc() && ptr == end;
     }
 
+    static bool parse_double(const std::string &s, double &out)
+    {
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+        return ec == std::errc() && ptr == s.data() + s.size();
+    }
+
     std::expected<int, Move::MoveError> parse_position(VBoard &board, std::istringstream &is)
     {
         std::string token;
@@ -127,7 +172,7 @@ class UCI
         logs::debug << "info string DEBUG: My Hash is " << std::hex << board.polyglot_key() << std::dec << std::endl;
         if (!is_infinite && !is_ponder)
         {
-            Move book_move = Book::probe(board);
+            Move book_move = Book::probe(board, book_rng);
 
             if (book_move.get_value() != 0)
             {
@@ -174,10 +219,13 @@ class UCI
 
         if (is_infinite)
         {
-            engine.start_search(0, false, true);
+            engine.start_search(0, false, true, false, std::max(0, depth));
             return;
         }
-        engine.start_search(time_to_think, is_ponder && ponder_enabled, is_infinite, ponder_enabled);
+        // go depth seul : pas de limite de temps
+        if (depth > 0 && movetime == -1 && wtime == -1)
+            time_to_think = std::numeric_limits<int>::max() / 2;
+        engine.start_search(time_to_think, is_ponder && ponder_enabled, is_infinite, ponder_enabled, std::max(0, depth));
     }
 
     void set_option(std::istringstream &is)
@@ -250,6 +298,7 @@ class UCI
             {
                 e.get_tt().resize(size);
                 logs::debug << "info string Hash table resized" << std::endl;
+                reload_hash_file();
             }
             else
             {
@@ -257,9 +306,72 @@ class UCI
             }
             handled = true;
         }
+        else if (name == "EvalFile ")
+        {
+            e.stop();
+            e.wait();
+
+            std::string path = value;
+            while (!path.empty() && path.back() == ' ')
+                path.pop_back();
+
+            if (is_no_file(path))
+            {
+                NNUE::unload();
+                logs::uci << "info string NNUE disabled, using classical eval" << std::endl;
+            }
+            else
+            {
+                // Chemin tel quel, sinon relatif au dossier data
+                if (!std::filesystem::exists(path) && std::filesystem::exists(file::get_data_path(path)))
+                    path = file::get_data_path(path);
+
+                if (NNUE::load(path))
+                    logs::uci << "info string NNUE evaluation using " << path << std::endl;
+                else
+                    logs::uci << "info string error: cannot load EvalFile " << path
+                              << (NNUE::is_loaded() ? ", keeping the current network" : ", using classical eval") << std::endl;
+            }
+            b.refresh_accumulator();
+            // Scores de la TT calculés avec l'ancienne éval ; la HashFile n'est relue que si elle correspond
+            e.clear();
+            reload_hash_file();
+            handled = true;
+        }
+        else if (name == "EvalParams ")
+        {
+            e.stop();
+            e.wait();
+
+            std::string path = value;
+            while (!path.empty() && path.back() == ' ')
+                path.pop_back();
+            set_eval_params(path);
+            handled = true;
+        }
+        else if (name == "HashFile ")
+        {
+            e.stop();
+            e.wait();
+
+            std::string path = value;
+            while (!path.empty() && path.back() == ' ')
+                path.pop_back();
+            set_hash_file(path);
+            handled = true;
+        }
+        else if (name == "BookFile ")
+        {
+            std::string path = value;
+            while (!path.empty() && path.back() == ' ')
+                path.pop_back();
+            set_book(path);
+            handled = true;
+        }
         else if (name == "Clear Hash ")
         {
             e.get_tt().clear();
+            reload_hash_file();
             logs::debug << "info string Hash table cleared" << std::endl;
             handled = true;
         }
@@ -270,27 +382,31 @@ class UCI
         }
     }
 
+    // Positions communes à bench et evalbench
+    static constexpr std::array<const char *, 16> bench_fens = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/2pP4/1p2P3/2N2N2/PPQBBPPP/R3K2R w KQkq - 0 1",
+        "4rrk1/2p2ppp/p1np1q2/1p2p3/4P3/1NN1BP2/PPP2QPP/3RR1K1 w - - 0 1",
+        "r3q1k1/1b1n1ppp/p2pr3/1pp1p3/4P3/1PN1BN1P/PBP1QPP1/2KR3R w - - 0 1",
+        "2r2rk1/pp1n1pp1/2pb1q1p/3p4/3P4/2PBPN2/PPQ2PPP/2R2RK1 w - - 0 1",
+        "r2q1rk1/pp2bppp/2n2n2/2bp4/2P5/1PN1PN2/PB1QBPPP/2R2RK1 w - - 0 1",
+        "r4rk1/pp1n1ppp/2pb1q2/3p4/3P4/2PBPN2/PPQ2PPP/R4RK1 w - - 0 1",
+        "2r2rk1/1bq1bpp1/p2ppn1p/1p6/3NP3/1BN1BP2/PPQ2P1P/2RR2K1 w - - 0 1",
+        "r1bq1rk1/pp2ppbp/2np1np1/8/2PNP3/2N1B3/PP2BPPP/R2Q1RK1 w - - 0 1",
+        "r2q1rk1/pp1n1ppp/2pbpn2/8/2PP4/2N1PN2/PP2BPPP/R1BQ1RK1 w - - 0 1",
+        "r1bq1rk1/1p2bppp/p1np1n2/2p1p3/2P1P3/1PN1BN1P/PB1QBPP1/2RR2K1 w - - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/4p3/2P1P3/1PN1BN1P/PB1Q1PP1/2KR3R w - - 0 1",
+        "2r2rk1/pp1n1ppp/2pb1q2/3p4/3P4/2PBPN2/PPQ2PPP/2R1R1K1 w - - 0 1",
+        "r1bq1rk1/pp2ppbp/2np1np1/8/2PNP3/2N1B3/PP2BPPP/2RQ1RK1 w - - 0 1",
+        "r2q1rk1/pp2bppp/2n2n2/2bp4/2P5/1PN1PN2/PB1QBPPP/2R2RK1 b - - 0 1",
+        "8/5pk1/1p1p2p1/2pP1p1p/2P2P1P/1P4P1/5K2/8 w - - 0 1",
+    };
+
+    // bench <depth> [perf] : signature, un seul SearchWorker (run_benchmark_fixed_depth) sur bench_fens
+    // bench <depth> <threads> <hash> [fenfile] [json [out]] [perf] : recherche réelle (start_workers) de chaque position
+    // perf : compteurs matériels (perf_counters.hpp) pendant les recherches seulement, rapportés par nœud
     void run_bench(std::istringstream &is)
     {
-        static constexpr std::array<const char *, 16> bench_fens = {
-            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
-            "r3k2r/p1ppqpb1/bn2pnp1/2pP4/1p2P3/2N2N2/PPQBBPPP/R3K2R w KQkq - 0 1",
-            "4rrk1/2p2ppp/p1np1q2/1p2p3/4P3/1NN1BP2/PPP2QPP/3RR1K1 w - - 0 1",
-            "r3q1k1/1b1n1ppp/p2pr3/1pp1p3/4P3/1PN1BN1P/PBP1QPP1/2KR3R w - - 0 1",
-            "2r2rk1/pp1n1pp1/2pb1q1p/3p4/3P4/2PBPN2/PPQ2PPP/2R2RK1 w - - 0 1",
-            "r2q1rk1/pp2bppp/2n2n2/2bp4/2P5/1PN1PN2/PB1QBPPP/2R2RK1 w - - 0 1",
-            "r4rk1/pp1n1ppp/2pb1q2/3p4/3P4/2PBPN2/PPQ2PPP/R4RK1 w - - 0 1",
-            "2r2rk1/1bq1bpp1/p2ppn1p/1p6/3NP3/1BN1BP2/PPQ2P1P/2RR2K1 w - - 0 1",
-            "r1bq1rk1/pp2ppbp/2np1np1/8/2PNP3/2N1B3/PP2BPPP/R2Q1RK1 w - - 0 1",
-            "r2q1rk1/pp1n1ppp/2pbpn2/8/2PP4/2N1PN2/PP2BPPP/R1BQ1RK1 w - - 0 1",
-            "r1bq1rk1/1p2bppp/p1np1n2/2p1p3/2P1P3/1PN1BN1P/PB1QBPP1/2RR2K1 w - - 0 1",
-            "r4rk1/1pp1qppp/p1np1n2/4p3/2P1P3/1PN1BN1P/PB1Q1PP1/2KR3R w - - 0 1",
-            "2r2rk1/pp1n1ppp/2pb1q2/3p4/3P4/2PBPN2/PPQ2PPP/2R1R1K1 w - - 0 1",
-            "r1bq1rk1/pp2ppbp/2np1np1/8/2PNP3/2N1B3/PP2BPPP/2RQ1RK1 w - - 0 1",
-            "r2q1rk1/pp2bppp/2n2n2/2bp4/2P5/1PN1PN2/PB1QBPPP/2R2RK1 b - - 0 1",
-            "8/5pk1/1p1p2p1/2pP1p1p/2P2P1P/1P4P1/5K2/8 w - - 0 1",
-        };
-
         int bench_depth = 4;
         std::string arg;
         if (is >> arg)
@@ -310,8 +426,27 @@ class UCI
         e.stop();
         e.wait();
 
+        int threads = 0;
+        bool use_perf = false;
+        if (is >> arg)
+        {
+            if (arg == "perf")
+                use_perf = true;
+            else
+            {
+                if (!parse_int(arg, threads) || threads < 1)
+                    threads = 1;
+                run_bench_smp(is, bench_depth, threads);
+                return;
+            }
+        }
+
         long long total_nodes = 0;
         long long total_time_ms = 0;
+        e.reset_search_stats();
+        perf::Counters counters;
+        if (use_perf)
+            counters.open();
 
         logs::uci << "info string bench start depth " << bench_depth << " positions " << bench_fens.size() << std::endl;
 
@@ -321,7 +456,9 @@ class UCI
             bench_board.load_fen(bench_fens[i]);
             e.clear();
 
+            counters.enable();
             auto result = e.run_benchmark_fixed_depth(bench_board, bench_depth);
+            counters.disable();
             total_nodes += result.nodes;
             total_time_ms += result.elapsed_ms;
 
@@ -336,10 +473,551 @@ class UCI
         const long long safe_total_time = std::max<long long>(1, total_time_ms);
         const long long total_nps = total_nodes * 1000 / safe_total_time;
 
+#ifdef SEARCH_STATS
+        logs::uci << e.get_search_stats().format() << std::endl;
+#endif
+        if (use_perf)
+            logs::uci << perf::format(counters.read(), total_nodes) << std::endl;
         logs::uci << "info string bench done time " << total_time_ms << "ms nps " << total_nps << std::endl;
         logs::uci << total_nodes << " nodes " << total_nps << " nps" << std::endl;
     }
 
+    // Suite de run_bench : <hash> [fenfile] [json [out]] [perf]. Threads et Hash sont rétablis à la fin.
+    // Recherches silencieuses (search_depth) ; temps par position = temps jusqu'à la profondeur demandée.
+    // Sortie JSON : une ligne par position (à la place de la ligne info string) puis un résumé.
+    void run_bench_smp(std::istringstream &is, int bench_depth, int threads)
+    {
+        int hash_mb = 16;
+        std::string arg, fen_path, out_path;
+        bool json = false;
+        bool use_perf = false;
+        if (is >> arg && (!parse_int(arg, hash_mb) || hash_mb < 1))
+            hash_mb = 16;
+        while (is >> arg)
+        {
+            if (arg == "perf")
+                use_perf = true;
+            else if (arg == "json")
+            {
+                json = true;
+                if (is >> arg && arg == "perf")
+                    use_perf = true;
+                else if (is)
+                    out_path = arg;
+            }
+            else
+                fen_path = arg;
+        }
+
+        std::vector<std::string> fens;
+        if (!fen_path.empty())
+        {
+            std::ifstream in(fen_path);
+            if (!in)
+            {
+                logs::uci << "info string bench cannot open " << fen_path << std::endl;
+                return;
+            }
+            const analysis::Config epd_config;
+            std::string line;
+            while (std::getline(in, line))
+                if (const std::optional<analysis::Job> job = analysis::parse_epd_line(line, epd_config))
+                    fens.push_back(job->fen);
+        }
+        else
+            fens.assign(bench_fens.begin(), bench_fens.end());
+
+        // Lignes JSON : fichier out si donné, sinon sortie UCI
+        std::ofstream file;
+        if (!out_path.empty())
+        {
+            file.open(out_path, std::ios::trunc);
+            if (!file)
+            {
+                logs::uci << "info string bench cannot open " << out_path << std::endl;
+                return;
+            }
+        }
+        auto write_json = [&file](const std::string &line)
+        {
+            if (file.is_open())
+                file << line << std::endl;
+            else
+                logs::uci << line << std::endl;
+        };
+
+        const VBoard saved = b;
+        const int saved_threads = e.get_threads();
+        const size_t saved_hash = e.get_tt().get_size_mb();
+        e.set_threads(threads);
+        e.get_tt().resize(static_cast<size_t>(hash_mb));
+
+        long long total_nodes = 0;
+        long long total_time_ms = 0;
+        e.reset_search_stats();
+        perf::Counters counters;
+        if (use_perf)
+            counters.open();
+        logs::uci << "info string bench start depth " << bench_depth << " threads " << threads << " hash " << hash_mb
+                  << " positions " << fens.size() << std::endl;
+
+        for (size_t i = 0; i < fens.size(); ++i)
+        {
+            b.load_fen(fens[i]);
+            e.clear();
+            counters.enable();
+            const EngineManager::BenchResult r = e.search_depth(bench_depth);
+            counters.disable();
+            total_nodes += r.nodes;
+            total_time_ms += r.elapsed_ms;
+
+            const std::string best = r.best_move.get_value() == 0 ? "(none)" : r.best_move.to_uci();
+            if (json)
+            {
+                std::ostringstream line;
+                line << "{\"index\":" << i + 1 << ",\"fen\":\"" << fens[i] << "\",\"depth\":" << bench_depth
+                     << ",\"nodes\":" << r.nodes << ",\"time_ms\":" << r.elapsed_ms << ",\"nps\":" << r.nps
+                     << ",\"bestmove\":\"" << best << "\"}";
+                write_json(line.str());
+            }
+            else
+                logs::uci << "info string bench " << (i + 1) << "/" << fens.size()
+                          << " nodes " << r.nodes
+                          << " nps " << r.nps
+                          << " time " << r.elapsed_ms << "ms"
+                          << " bestmove " << best
+                          << std::endl;
+        }
+
+        b = saved;
+        e.set_threads(saved_threads);
+        e.get_tt().resize(saved_hash);
+        e.clear();
+        reload_hash_file();
+
+        const perf::Sample sample = counters.read();
+        const long long safe_total_time = std::max<long long>(1, total_time_ms);
+        const long long total_nps = total_nodes * 1000 / safe_total_time;
+        if (json)
+        {
+            std::ostringstream line;
+            line << "{\"summary\":true,\"depth\":" << bench_depth << ",\"threads\":" << threads << ",\"hash_mb\":" << hash_mb
+                 << ",\"positions\":" << fens.size() << ",\"nodes\":" << total_nodes << ",\"time_ms\":" << total_time_ms
+                 << ",\"nps\":" << total_nps;
+            if (use_perf)
+                line << ",\"perf\":" << perf::json(sample, total_nodes);
+            line << "}";
+            write_json(line.str());
+        }
+#ifdef SEARCH_STATS
+        logs::uci << e.get_search_stats().format() << std::endl;
+#endif
+        if (use_perf)
+            logs::uci << perf::format(sample, total_nodes) << std::endl;
+        logs::uci << "info string bench done time " << total_time_ms << "ms nps " << total_nps << std::endl;
+        logs::uci << total_nodes << " nodes " << total_nps << " nps" << std::endl;
+    }
+
+    // Perft on the current position, make/unmake vs copy-make
+    void run_perft(std::istringstream &is)
+    {
+        int depth = 5;
+        std::string arg;
+        if (is >> arg && !parse_int(arg, depth))
+            depth = 5;
+        depth = std::clamp(depth, 1, engine_constants::search::MaxDepth - 1);
+
+        e.stop();
+        e.wait();
+
+        std::array<Position, engine_constants::search::MaxDepth> stack;
+        Board perft_board = b;
+
+        auto report = [&](const char *mode, auto &&run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const U64 nodes = run();
+            const long long elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                             std::chrono::steady_clock::now() - start)
+                                             .count();
+            const long long nps = static_cast<long long>(nodes) * 1000 / std::max<long long>(1, elapsed_ms);
+            logs::uci << "info string perft " << mode << " depth " << depth << " nodes " << nodes
+                      << " time " << elapsed_ms << "ms nps " << nps << std::endl;
+            return nodes;
+        };
+
+        const U64 nodes = report("make-unmake", [&]()
+                                 { return MoveGen::perft(perft_board, depth); });
+        report("copy-make", [&]()
+               { return MoveGen::perft_copy_make(perft_board, depth, stack.data()); });
+        logs::uci << nodes << " nodes" << std::endl;
+    }
+
+    // epd2bin <in.epd> <out.bin> : EPD étiqueté -> positions binaires de 32 octets
+    void run_epd2bin(std::istringstream &is)
+    {
+        std::string in_path, out_path;
+        if (!(is >> in_path >> out_path))
+        {
+            logs::uci << "info string usage : epd2bin <in.epd> <out.bin>" << std::endl;
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        packed::ConvertStats stats;
+        if (!packed::convert_epd(in_path, out_path, std::max(1u, std::thread::hardware_concurrency()), stats))
+        {
+            logs::uci << "info string epd2bin cannot open " << in_path << " or " << out_path << std::endl;
+            return;
+        }
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        logs::uci << "info string epd2bin lines " << stats.lines << " written " << stats.written
+                  << " rejected " << stats.rejected << " bytes " << stats.written * sizeof(PackedPosition)
+                  << " time " << ms << "ms" << std::endl;
+    }
+
+    // datagen <out.bin> [parties] [nœuds par coup] [threads] [graine] : self-play, positions ajoutées à out.bin
+    void run_datagen(std::istringstream &is)
+    {
+        datagen::Config config;
+        config.threads = std::max(1u, std::thread::hardware_concurrency());
+        if (!(is >> config.out_path))
+        {
+            logs::uci << "info string usage : datagen <out.bin> [games] [nodes] [threads] [seed]" << std::endl;
+            return;
+        }
+
+        std::string arg;
+        int value;
+        if (is >> arg && parse_int(arg, value) && value > 0)
+            config.games = value;
+        if (is >> arg && parse_int(arg, value) && value > 0)
+            config.nodes = value;
+        if (is >> arg && parse_int(arg, value) && value > 0)
+            config.threads = static_cast<unsigned>(value);
+        if (is >> arg && parse_int(arg, value))
+            config.seed = static_cast<std::uint64_t>(value);
+
+        e.stop();
+        e.wait();
+        logs::uci << "info string datagen " << config.games << " games " << config.nodes << " nodes/move "
+                  << config.threads << " threads -> " << config.out_path << std::endl;
+        datagen::Generator(config).run();
+    }
+
+    // analyze <in.epd> [depth n] [nodes n] [threads n] [hash Mio] [out fichier] [json|csv]
+    // Une ligne de résultat par position, dans l'ordre où elles se terminent
+    void run_analyze(std::istringstream &is)
+    {
+        analysis::Config config;
+        config.threads = std::max(1u, std::thread::hardware_concurrency());
+        if (!(is >> config.in_path))
+        {
+            logs::uci << "info string usage : analyze <in.epd> [depth n] [nodes n] [threads n] [hash mb] [out file] [json|csv]" << std::endl;
+            return;
+        }
+
+        std::string arg, value;
+        int n;
+        while (is >> arg)
+        {
+            if (arg == "json" || arg == "csv")
+                config.format = (arg == "csv") ? analysis::Format::Csv : analysis::Format::Json;
+            else if (arg == "out" && is >> value)
+                config.out_path = value;
+            else if (arg == "depth" && is >> value && parse_int(value, n) && n > 0)
+                config.depth = n;
+            else if (arg == "nodes" && is >> value && parse_int(value, n) && n > 0)
+                config.nodes = n;
+            else if (arg == "threads" && is >> value && parse_int(value, n) && n > 0)
+                config.threads = static_cast<unsigned>(n);
+            else if (arg == "hash" && is >> value && parse_int(value, n) && n > 0)
+                config.hash_mb = static_cast<size_t>(n);
+            else
+                logs::uci << "info string analyze : ignored argument " << arg << std::endl;
+        }
+
+        e.stop();
+        e.wait();
+        analysis::Analyzer(config).run();
+    }
+
+    // savehash <fichier> [profondeur min] : écrit les entrées de la TT de profondeur >= min
+    void run_savehash(std::istringstream &is)
+    {
+        std::string path, arg;
+        int min_depth = 0;
+        if (!(is >> path))
+        {
+            logs::uci << "info string usage : savehash <file> [min depth]" << std::endl;
+            return;
+        }
+        if (is >> arg && !parse_int(arg, min_depth))
+            min_depth = 0;
+
+        e.stop();
+        e.wait();
+        size_t written = 0;
+        if (e.get_tt().save(path, min_depth, Eval::fingerprint(), written))
+            logs::uci << "info string savehash " << written << " entries depth >= " << min_depth << " -> " << path << std::endl;
+        else
+            logs::uci << "info string error: cannot write hash file " << path << std::endl;
+    }
+
+    // loadhash <fichier> : ajoute les entrées sauvegardées à la TT courante
+    void run_loadhash(std::istringstream &is)
+    {
+        std::string path;
+        if (!(is >> path))
+        {
+            logs::uci << "info string usage : loadhash <file>" << std::endl;
+            return;
+        }
+        e.stop();
+        e.wait();
+        load_hash(path);
+    }
+
+    // stats [reset] : compteurs de recherche cumulés depuis le dernier reset (build ENABLE_SEARCH_STATS)
+    void run_stats(std::istringstream &is)
+    {
+#ifdef SEARCH_STATS
+        std::string arg;
+        e.wait();
+        if (is >> arg && arg == "reset")
+            e.reset_search_stats();
+        else
+            logs::uci << e.get_search_stats().format() << std::endl;
+#else
+        (void)is;
+        logs::uci << "info string stats unavailable : build with ENABLE_SEARCH_STATS" << std::endl;
+#endif
+    }
+
+    // trace <fichier> [Mio par thread] | trace off : chaque recherche (go, bench multi-thread) écrit son arbre (build ENABLE_SEARCH_TRACE)
+    void run_trace(std::istringstream &is)
+    {
+#ifdef SEARCH_TRACE
+        std::string path, arg;
+        int mb = 64;
+        if (!(is >> path))
+        {
+            logs::uci << "info string usage : trace <file> [mb per thread] | trace off" << std::endl;
+            return;
+        }
+        if (is >> arg && (!parse_int(arg, mb) || mb < 1))
+            mb = 64;
+        e.wait();
+        e.set_trace(path == "off" ? "" : path, static_cast<size_t>(mb));
+        if (path == "off")
+            logs::uci << "info string trace off" << std::endl;
+        else
+            logs::uci << "info string trace -> " << path << " " << mb << " MB per thread" << std::endl;
+#else
+        (void)is;
+        logs::uci << "info string trace unavailable : build with ENABLE_SEARCH_TRACE" << std::endl;
+#endif
+    }
+
+    // tracestat <fichier> [top n] : sous-arbres par coup racine et points d'explosion de chaque thread
+    void run_tracestat(std::istringstream &is)
+    {
+        std::string path, arg;
+        if (!(is >> path))
+        {
+            logs::uci << "info string usage : tracestat <file> [top n]" << std::endl;
+            return;
+        }
+        search_trace::Options options;
+        int n;
+        if (is >> arg && arg == "top" && is >> arg && parse_int(arg, n) && n > 0)
+            options.top = static_cast<size_t>(n);
+
+        std::vector<search_trace::Section> sections;
+        if (!search_trace::read(path, sections))
+        {
+            logs::uci << "info string error: cannot read trace " << path << std::endl;
+            return;
+        }
+        for (const search_trace::Section &section : sections)
+            logs::uci << search_trace::summarize(section, options) << std::flush;
+    }
+
+    bool load_hash(const std::string &path)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        size_t loaded = 0;
+        if (!e.get_tt().load(path, Eval::fingerprint(), loaded))
+        {
+            logs::uci << "info string error: cannot load hash file " << path << " (missing, truncated, other version or other eval)" << std::endl;
+            return false;
+        }
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        logs::uci << "info string loadhash " << loaded << " entries from " << path << " in " << ms << "ms" << std::endl;
+        return true;
+    }
+
+    void reload_hash_file()
+    {
+        if (!hash_file.empty())
+            load_hash(hash_file);
+    }
+
+    // bookgen <out.bin> [demi-coups] [profondeur] [threads] [coups par position] [marge cp]
+    // Livre généré depuis la position courante ; reprend un fichier existant
+    void run_bookgen(std::istringstream &is)
+    {
+        bookgen::Config config;
+        config.threads = std::max(1u, std::thread::hardware_concurrency());
+        if (!(is >> config.out_path))
+        {
+            logs::uci << "info string usage : bookgen <out.bin> [plies] [depth] [threads] [moves] [margin]" << std::endl;
+            return;
+        }
+
+        std::string arg;
+        int value;
+        if (is >> arg && parse_int(arg, value) && value > 0)
+            config.plies = value;
+        if (is >> arg && parse_int(arg, value) && value > 0)
+            config.depth = value;
+        if (is >> arg && parse_int(arg, value) && value > 0)
+            config.threads = static_cast<unsigned>(value);
+        if (is >> arg && parse_int(arg, value) && value > 0)
+            config.max_moves = value;
+        if (is >> arg && parse_int(arg, value) && value >= 0)
+            config.margin_cp = value;
+
+        e.stop();
+        e.wait();
+        logs::uci << "info string bookgen " << config.plies << " plies depth " << config.depth << " "
+                  << config.threads << " threads -> " << config.out_path << std::endl;
+        bookgen::Generator(config).run(b);
+        // Le livre joué a pu être réécrit
+        if (!book_path.empty())
+            set_book(book_path);
+    }
+
+    // spsa <config> : tuning SPSA des paramètres de recherche, parties à nombre de nœuds fixé
+    void run_spsa(std::istringstream &is)
+    {
+        std::string path;
+        if (!(is >> path))
+        {
+            logs::uci << "info string usage : spsa <config>" << std::endl;
+            return;
+        }
+#ifdef SPSA_TUNING
+        spsa::Config config;
+        std::string error;
+        if (!spsa::load_config(path, config, error))
+        {
+            logs::uci << "info string spsa " << path << " : " << error << std::endl;
+            return;
+        }
+        e.stop();
+        e.wait();
+        spsa::Tuner(config).run();
+#else
+        logs::uci << "info string spsa needs a build with ENABLE_SPSA_TUNING=ON" << std::endl;
+#endif
+    }
+
+    // Parcours play / eval / unplay des arbres des positions de bench, fenêtre complète (pas de sortie paresseuse)
+    // Le coût de l'eval seule est la différence avec le même parcours sans eval (meilleur temps de 5 passes)
+    // HCE toujours, NNUE en plus si un EvalFile est chargé (le parcours inclut alors la mise à jour des accumulateurs)
+    void run_evalbench(std::istringstream &is)
+    {
+        int depth = 3;
+        std::string arg;
+        if (is >> arg && !parse_int(arg, depth))
+            depth = 3;
+        depth = std::clamp(depth, 1, 5);
+
+        e.stop();
+        e.wait();
+
+        enum class Mode
+        {
+            WalkOnly,
+            HCE,
+            NNUE
+        };
+
+        long long checksum = 0;
+        auto walk = [&](auto &&self, VBoard &board, int d, Mode mode) -> U64
+        {
+            MoveList list;
+            MoveGen::generate_legal_moves(board, list);
+            U64 nodes = 0;
+            for (int i = 0; i < list.count; ++i)
+            {
+                board.play(list[i]);
+                if (mode == Mode::HCE)
+                    checksum += Eval::hce_eval(board, -engine_constants::eval::Inf, engine_constants::eval::Inf);
+                else if (mode == Mode::NNUE)
+                    checksum += Eval::eval(board, -engine_constants::eval::Inf, engine_constants::eval::Inf);
+                ++nodes;
+                if (d > 1)
+                    nodes += self(self, board, d - 1, mode);
+                board.unplay(list[i]);
+            }
+            return nodes;
+        };
+
+        U64 nodes = 0;
+        auto timed_pass = [&](Mode mode)
+        {
+            nodes = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (const char *fen : bench_fens)
+            {
+                VBoard board;
+                board.load_fen(fen);
+                nodes += walk(walk, board, depth, mode);
+            }
+            return static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        };
+
+        // Meilleur temps sur quelques passes alternées, pour lisser le bruit de la machine
+        auto best_of = [&](Mode mode)
+        {
+            long long best = std::numeric_limits<long long>::max();
+            for (int pass = 0; pass < 5; ++pass)
+            {
+                checksum = 0;
+                best = std::min(best, timed_pass(mode));
+            }
+            return best;
+        };
+
+        const long long walk_ns = best_of(Mode::WalkOnly);
+        logs::uci << "info string evalbench depth " << depth << " evals " << nodes << " walk " << walk_ns / 1000000 << "ms" << std::endl;
+
+        auto report = [&](const char *name, Mode mode)
+        {
+            const long long eval_ns = best_of(mode);
+            const long long net_ns = std::max<long long>(1, eval_ns - walk_ns);
+            const long long evals_per_sec = static_cast<long long>(nodes * 1000000000.0 / net_ns);
+            logs::uci << "info string evalbench " << name << " time " << eval_ns / 1000000 << "ms"
+                      << " ns/eval " << static_cast<double>(net_ns) / std::max<U64>(1, nodes)
+                      << " evals/s " << evals_per_sec
+                      << " checksum " << checksum << std::endl;
+            return evals_per_sec;
+        };
+
+        const long long hce = report("hce", Mode::HCE);
+        if (NNUE::is_loaded())
+        {
+            const long long nnue = report("nnue", Mode::NNUE);
+            logs::uci << nodes << " evals " << hce << " hce evals/s " << nnue << " nnue evals/s" << std::endl;
+        }
+        else
+        {
+            logs::uci << nodes << " evals " << hce << " hce evals/s" << std::endl;
+        }
+    }
+
     void run_eval(std::istream &is)
     {
         int n{0};
@@ -371,57 +1049,12 @@ public:
         MoveGen::initialize_bitboard_tables();
         init_zobrist();
         b.load_fen(constants::FenInitPos);
-        Book::init(file::get_data_path("komodo.bin"));
+        Book::init(book_path);
 #ifdef SPSA_TUNING
-        int_options = {
-            UCIOption<int>(&engine_constants::search::aspiration::EnableDepth, "aspiration_enable_depth", 1, 63),
-            UCIOption<int>(&engine_constants::search::aspiration::MidDepth, "aspiration_mid_depth", 1, 63),
-            UCIOption<int>(&engine_constants::search::aspiration::HighDepth, "aspiration_high_depth", 1, 63),
-            UCIOption<int>(&engine_constants::search::aspiration::SmallDelta, "aspiration_small_delta", 1, 1000),
-            UCIOption<int>(&engine_constants::search::aspiration::MidDelta, "aspiration_mid_delta", 1, 1000),
-            UCIOption<int>(&engine_constants::search::aspiration::HighDelta, "aspiration_high_delta", 1, 2000),
-            UCIOption<int>(&engine_constants::search::aspiration::WidenMinDelta, "aspiration_widen_min_delta", 1, 1000),
-            UCIOption<int>(&engine_constants::search::aspiration::WidenMaxDelta, "aspiration_widen_max_delta", 50, 10000),
-            UCIOption<int>(&engine_constants::search::aspiration::MaxIterations, "aspiration_max_iterations", 1, 20),
-            UCIOption<int>(&engine_constants::search::aspiration::MateWindowMargin, "aspiration_mate_window_margin", 1, 1000),
-
-            UCIOption<int>(&engine_constants::search::razoring::MaxDepth, "razoring_max_depth"),
-            UCIOption<int>(&engine_constants::search::razoring::MarginDepthFactor, "razoring_depth_factor"),
-            UCIOption<int>(&engine_constants::search::razoring::MarginConst, "razoring_margin_const"),
-
-            UCIOption<int>(&engine_constants::search::reverse_futility_pruning::MaxDepth, "rfp_max_depth"),
-            UCIOption<int>(&engine_constants::search::reverse_futility_pruning::MarginDepthFactor, "rfp_marg_d_fact"),
-            UCIOption<int>(&engine_constants::search::reverse_futility_pruning::MarginConst, "rfp_marg_const"),
-
-            UCIOption<int>(&engine_constants::search::iterative_deepening::MaxDepth, "itd_max_depth"),
-            UCIOption<int>(&engine_constants::search::iterative_deepening::NewDepthIncr, "itd_new_depth_inc"),
-
-            UCIOption<int>(&engine_constants::search::null_move_pruning::MinDepth, "nmp_min_depth"),
-            UCIOption<int>(&engine_constants::search::null_move_pruning::RConst, "nmp_r_const"),
-            UCIOption<int>(&engine_constants::search::null_move_pruning::RDiv, "nmp_r_div"),
-
-            UCIOption<int>(&engine_constants::search::futility_pruning::MaxDepth, "fp_max_depth"),
-            UCIOption<int>(&engine_constants::search::futility_pruning::MarginConst, "fp_margin_const"),
-            UCIOption<int>(&engine_constants::search::futility_pruning::MarginDepthFactor, "fp_margin_d_fact"),
-
-            UCIOption<int>(&engine_constants::search::singular::MinDepth, "singular_min_depth"),
-
-            UCIOption<int>(&engine_constants::search::null_move_reduction::MaxDepth, "nmr_max_depth"),
-            UCIOption<int>(&engine_constants::search::null_move_reduction::MaxMovesConst, "nmr_max_moves_const"),
-
-            UCIOption<int>(&engine_constants::search::late_move_reduction::MinDepth, "lmr_min_depth"),
-            UCIOption<int>(&engine_constants::search::late_move_reduction::MinMovesSearched, "lmr_min_moves_searched"),
-            UCIOption<int>(&engine_constants::search::late_move_reduction::MaxDepthReduction, "lmr_max_depth_reduction"),
-
-            UCIOption<int>(&engine_constants::search::see_pruning::MaxDepth, "see_pruning_max_depth"),
-            UCIOption<int>(&engine_constants::search::see_pruning::ThresholdDepthFactor, "threshold_depth_factor"),
-
-        };
-
-        double_options = {
-            UCIOption<double>(&engine_constants::search::late_move_reduction::TableInitConst, "lmr_table_init_const"),
-            UCIOption<double>(&engine_constants::search::late_move_reduction::TableInitDiv, "lmr_table_init_div"),
-        };
+        using search_params::NoMin, search_params::NoMax;
+#define CHESS26_UCI_OPTION(var, label, min, max) add_search_option(&engine_constants::search::var, label, min, max);
+        CHESS26_SEARCH_PARAMS(CHESS26_UCI_OPTION)
+#undef CHESS26_UCI_OPTION
 #endif
     }
     void loop()
@@ -446,6 +1079,10 @@ public:
                 logs::uci << "option name Hash type spin default 512 min 1 max 2048" << std::endl;
                 logs::uci << "option name Move Overhead type spin default 100 min 0 max 1000" << std::endl; //@TODO
                 logs::uci << "option name Ponder type check default " << (ponder_enabled ? "true" : "false") << std::endl;
+                logs::uci << "option name EvalFile type string default <empty>" << std::endl;
+                logs::uci << "option name EvalParams type string default <empty>" << std::endl;
+                logs::uci << "option name HashFile type string default <empty>" << std::endl;
+                logs::uci << "option name BookFile type string default " << default_book_path() << std::endl;
 
 #ifdef SPSA_TUNING
                 for (auto int_option : int_options)
@@ -478,6 +1115,7 @@ public:
             else if (token == "ucinewgame")
             {
                 e.clear();
+                reload_hash_file();
                 b.load_fen(constants::FenInitPos);
             }
             else if (token == "position")
@@ -493,10 +1131,58 @@ public:
             {
                 run_bench(is);
             }
+            else if (token == "perft")
+            {
+                run_perft(is);
+            }
+            else if (token == "evalbench")
+            {
+                run_evalbench(is);
+            }
             else if (token == "eval")
             {
                 run_eval(is);
             }
+            else if (token == "epd2bin")
+            {
+                run_epd2bin(is);
+            }
+            else if (token == "datagen")
+            {
+                run_datagen(is);
+            }
+            else if (token == "bookgen")
+            {
+                run_bookgen(is);
+            }
+            else if (token == "analyze")
+            {
+                run_analyze(is);
+            }
+            else if (token == "savehash")
+            {
+                run_savehash(is);
+            }
+            else if (token == "loadhash")
+            {
+                run_loadhash(is);
+            }
+            else if (token == "stats")
+            {
+                run_stats(is);
+            }
+            else if (token == "trace")
+            {
+                run_trace(is);
+            }
+            else if (token == "tracestat")
+            {
+                run_tracestat(is);
+            }
+            else if (token == "spsa")
+            {
+                run_spsa(is);
+            }
             else if (token == "quit")
             {
                 break;
@@ -509,15 +1195,48 @@ public:
             }
 #endif
 #ifdef TEXEL_TUNING
-            else if (token == "texel")
+            else if (token == "texel" || token == "mean_eval" || token == "texel_loadbench")
             {
-                TexelTuner t = TexelTuner();
-                t.start_tuning();
-            }
-            else if (token == "mean_eval")
-            {
-                TexelTuner t;
-                logs::uci << "[INFO] Mean Abs : " << t.compute_mean_abs_eval() << std::endl;
+                // texel <fichier> [Mio en mémoire] [optimizer sgd|adam|lbfgs] [lr x] [epochs n] [patience n] [k x|fit] [resume]
+                // Fichier EPD ou .bin, quiet-labeled.v7.epd par défaut
+                std::string path;
+                TexelTuner t = (is >> path) ? TexelTuner(path) : TexelTuner();
+                TexelTuner::Settings &s = t.get_settings();
+                std::string arg, value;
+                int n;
+                double x;
+                while (is >> arg)
+                {
+                    if (parse_int(arg, n) && n >= 0)
+                        t.set_max_resident_mib(n);
+                    else if (arg == "resume")
+                        s.resume = true;
+                    else if (arg == "optimizer" && is >> value && Texel::parse_optimizer(value))
+                        s.optimizer = *Texel::parse_optimizer(value);
+                    else if (arg == "lr" && is >> value && parse_double(value, x) && x > 0)
+                        s.learning_rate = x;
+                    else if (arg == "epochs" && is >> value && parse_int(value, n) && n > 0)
+                        s.epochs = n;
+                    else if (arg == "patience" && is >> value && parse_int(value, n) && n >= 0)
+                        s.patience = n;
+                    else if (arg == "k" && is >> value)
+                    {
+                        s.fit_k = (value == "fit");
+                        if (!s.fit_k && parse_double(value, x) && x > 0)
+                            s.k = x;
+                    }
+                    else
+                        logs::uci << "info string texel : ignored argument " << arg << std::endl;
+                }
+                if (token == "texel")
+                {
+                    t.start_tuning();
+                    b.refresh_eval_state();
+                }
+                else if (token == "mean_eval")
+                    logs::uci << "[INFO] Mean Abs : " << t.compute_mean_abs_eval() << std::endl;
+                else
+                    t.benchmark_loader();
             }
 #endif
         }
@@ -528,4 +1247,120 @@ public:
         std::istringstream is(std::to_string(movetime_ms));
         run_bench(is);
     }
+
+    void run_bench_cli(const std::string &args)
+    {
+        std::istringstream is(args);
+        run_bench(is);
+    }
+
+    void run_perft_cli(int depth)
+    {
+        std::istringstream is(std::to_string(depth));
+        run_perft(is);
+    }
+
+    void run_evalbench_cli(int depth)
+    {
+        std::istringstream is(std::to_string(depth));
+        run_evalbench(is);
+    }
+
+    void run_epd2bin_cli(const std::string &in_path, const std::string &out_path)
+    {
+        std::istringstream is(in_path + " " + out_path);
+        run_epd2bin(is);
+    }
+
+    void run_datagen_cli(const std::string &args)
+    {
+        std::istringstream is(args);
+        run_datagen(is);
+    }
+
+    void run_analyze_cli(const std::string &args)
+    {
+        std::istringstream is(args);
+        run_analyze(is);
+    }
+
+    void run_tracestat_cli(const std::string &args)
+    {
+        std::istringstream is(args);
+        run_tracestat(is);
+    }
+
+    void run_bookgen_cli(const std::string &args)
+    {
+        std::istringstream is(args);
+        run_bookgen(is);
+    }
+
+    void run_spsa_cli(const std::string &path)
+    {
+        std::istringstream is(path);
+        run_spsa(is);
+    }
+
+    // TT sauvegardée (savehash), chargée tout de suite puis après chaque vidage ; vide, <empty>, <none> ou none : aucune
+    bool set_hash_file(std::string path)
+    {
+        if (is_no_file(path))
+        {
+            hash_file.clear();
+            return true;
+        }
+        if (!std::filesystem::exists(path) && std::filesystem::exists(file::get_data_path(path)))
+            path = file::get_data_path(path);
+        if (!load_hash(path))
+            return false;
+        hash_file = path;
+        return true;
+    }
+
+    // Livre d'ouverture joué ; vide, <empty>, <none> ou none : pas de livre
+    void set_book(std::string path)
+    {
+        if (is_no_file(path))
+        {
+            book_path.clear();
+            Book::close();
+            logs::uci << "info string book disabled" << std::endl;
+            return;
+        }
+        // Chemin tel quel, sinon relatif au dossier data
+        if (!std::filesystem::exists(path) && std::filesystem::exists(file::get_data_path(path)))
+            path = file::get_data_path(path);
+        book_path = path;
+        Book::init(book_path);
+        logs::debug << "info string book " << book_path << " entries " << Book::size() << std::endl;
+    }
+
+    // Jeu de paramètres de l'éval classique ; vide, <empty>, <none> ou none : valeurs compilées
+    bool set_eval_params(std::string path)
+    {
+        bool ok = true;
+        if (is_no_file(path))
+        {
+            Eval::reset_params();
+            logs::uci << "info string EvalParams reset to built-in values" << std::endl;
+        }
+        else
+        {
+            // Chemin tel quel, sinon relatif au dossier data
+            if (!std::filesystem::exists(path) && std::filesystem::exists(file::get_data_path(path)))
+                path = file::get_data_path(path);
+
+            ok = Eval::load_params(path);
+            if (ok)
+                logs::uci << "info string EvalParams loaded from " << path << std::endl;
+            else
+                logs::uci << "info string error: cannot load EvalParams " << path << ", keeping current values" << std::endl;
+        }
+        // Scores de la TT calculés avec l'ancien jeu
+        e.clear();
+        reload_hash_file();
+        b.refresh_eval_state();
+        return ok;
+    }
 };
\ No newline at end of file
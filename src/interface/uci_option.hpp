@@ -43,7 +43,7 @@ class UCIOption
 
 public:
     UCIOption(T *_option, std::string_view _option_name, long long _min = default_min(), long long _max = default_max())
-        : option_value(_option), option_name(_option_name), min_value(_min), max_value(_max)
+        : option_value(_option), option_name(_option_name), min_value(std::max(_min, default_min())), max_value(std::min(_max, default_max()))
     {
         if (min_value > max_value)
             std::swap(min_value, max_value);
@@ -13,14 +13,41 @@ static bool parse_int_arg(const char *s, int &out)
     return ec == std::errc() && ptr == end;
 }
 
+// argv[first..] séparés par des espaces, pour les commandes qui relisent leurs arguments comme une ligne UCI
+static std::string join_args(int argc, char **argv, int first)
+{
+    std::string args;
+    for (int i = first; i < argc; ++i)
+        args += std::string(argv[i]) + " ";
+    return args;
+}
+
 int main(int argc, char **argv)
 {
     UCI u;
 
+    // --params <fichier> : jeu de paramètres de l'éval chargé avant la commande
+    // --hash <fichier> : TT sauvegardée (savehash) chargée au démarrage, comme l'option HashFile
+    while (argc >= 3 && (std::strcmp(argv[1], "--params") == 0 || std::strcmp(argv[1], "--hash") == 0))
+    {
+        const bool ok = (std::strcmp(argv[1], "--params") == 0) ? u.set_eval_params(argv[2]) : u.set_hash_file(argv[2]);
+        if (!ok)
+            return 1;
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
     if (argc >= 2)
     {
         std::string cmd = argv[1];
 
+        if (cmd == "bench" && argc >= 4)
+        {
+            u.run_bench_cli(join_args(argc, argv, 2));
+            return 0;
+        }
+
         if (cmd == "bench")
         {
             int bench_depth = 4;
@@ -31,6 +58,64 @@ int main(int argc, char **argv)
             u.run_bench_cli(bench_depth);
             return 0;
         }
+
+        if (cmd == "perft")
+        {
+            int perft_depth = 5;
+
+            if (argc >= 3 && !parse_int_arg(argv[2], perft_depth))
+                perft_depth = 5;
+
+            u.run_perft_cli(perft_depth);
+            return 0;
+        }
+
+        if (cmd == "evalbench")
+        {
+            int eval_depth = 3;
+
+            if (argc >= 3 && !parse_int_arg(argv[2], eval_depth))
+                eval_depth = 3;
+
+            u.run_evalbench_cli(eval_depth);
+            return 0;
+        }
+
+        if (cmd == "datagen")
+        {
+            u.run_datagen_cli(join_args(argc, argv, 2));
+            return 0;
+        }
+
+        if (cmd == "analyze")
+        {
+            u.run_analyze_cli(join_args(argc, argv, 2));
+            return 0;
+        }
+
+        if (cmd == "tracestat")
+        {
+            u.run_tracestat_cli(join_args(argc, argv, 2));
+            return 0;
+        }
+
+        if (cmd == "bookgen")
+        {
+            u.run_bookgen_cli(join_args(argc, argv, 2));
+            return 0;
+        }
+
+        if (cmd == "spsa" && argc >= 3)
+        {
+            u.run_spsa_cli(argv[2]);
+            return 0;
+        }
+
+        if (cmd == "epd2bin" && argc >= 4)
+        {
+            u.run_epd2bin_cli(argv[2], argv[3]);
+            return 0;
+        }
     }
 
     u.loop();
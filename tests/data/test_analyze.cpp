@@ -0,0 +1,97 @@
+#include "engine/data/analyze.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+TEST(AnalyzeTest, ParsesEpdOpcodesAndCounters)
+{
+    analysis::Config config;
+    config.nodes = 5000;
+
+    auto job = analysis::parse_epd_line("4k3/8/8/8/8/8/4P3/4K3 w - - 3 40 acd 7; id \"pawn \\\"up\\\"\"; c0 \"x\";\r", config);
+    ASSERT_TRUE(job);
+    EXPECT_EQ(job->fen, "4k3/8/8/8/8/8/4P3/4K3 w - - 3 40");
+    EXPECT_EQ(job->depth, 7);
+    EXPECT_EQ(job->nodes, 5000);
+    EXPECT_EQ(job->id, "pawn \\\"up\\\"");
+
+    job = analysis::parse_epd_line("4k3/8/8/8/8/8/4P3/4K3 b - - acn 1200;", analysis::Config{});
+    ASSERT_TRUE(job);
+    EXPECT_EQ(job->fen, "4k3/8/8/8/8/8/4P3/4K3 b - -");
+    EXPECT_EQ(job->depth, 0);
+    EXPECT_EQ(job->nodes, 1200);
+
+    // Sans limite : profondeur par défaut
+    job = analysis::parse_epd_line(constants::FenInitPos, analysis::Config{});
+    ASSERT_TRUE(job);
+    EXPECT_EQ(job->depth, analysis::Config::DefaultDepth);
+
+    EXPECT_FALSE(analysis::parse_epd_line("", config));
+    EXPECT_FALSE(analysis::parse_epd_line("# commentaire", config));
+    EXPECT_FALSE(analysis::parse_epd_line("8/8/8 w", config));
+}
+
+TEST(AnalyzeTest, MateScoresAreReportedInMoves)
+{
+    EXPECT_EQ(analysis::mate_in(engine_constants::eval::MateScore - 1), 1);
+    EXPECT_EQ(analysis::mate_in(engine_constants::eval::MateScore - 4), 2);
+    EXPECT_EQ(analysis::mate_in(-engine_constants::eval::MateScore + 2), -1);
+    EXPECT_EQ(analysis::mate_in(250), 0);
+}
+
+// Toutes les positions sortent une fois, avec un coup et la limite demandée
+TEST(AnalyzeTest, AnalyzesBatchWithWorkerPool)
+{
+    MoveGen::initialize_bitboard_tables();
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string in_path = (dir / "chess26_test_analyze.epd").string();
+    const std::string out_path = (dir / "chess26_test_analyze.jsonl").string();
+    {
+        std::ofstream in(in_path);
+        in << constants::FenInitPos << "\n"
+           << "# commentaire\n"
+           << "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - acd 3;\n"
+           << "6k1/5ppp/8/8/8/8/8/R5K1 w - - id \"mate\";\n"
+           << "pas une position\n"
+           << "4k3/8/8/8/8/8/4P3/4K3 w - - acn 2000;\n"
+           << "   # commentaire indenté\n"
+           << "\t\n";
+    }
+
+    analysis::Config config;
+    config.in_path = in_path;
+    config.out_path = out_path;
+    config.depth = 4;
+    config.threads = 2;
+    config.hash_mb = 2;
+    analysis::Analyzer analyzer(config);
+    ASSERT_TRUE(analyzer.run());
+    EXPECT_EQ(analyzer.get_stats().positions.load(), 4);
+    EXPECT_EQ(analyzer.get_stats().rejected, 1);
+
+    std::ifstream out(out_path);
+    std::set<size_t> indexes;
+    std::string line;
+    while (std::getline(out, line))
+    {
+        ASSERT_TRUE(line.starts_with("{\"index\":")) << line;
+        EXPECT_EQ(line.find("\"bestmove\":\"\""), std::string::npos) << line;
+        const size_t index = std::stoul(line.substr(9));
+        indexes.insert(index);
+        if (index == 3)
+        {
+            EXPECT_NE(line.find("\"depth\":3,"), std::string::npos) << line;
+        }
+        if (index == 4)
+        {
+            EXPECT_NE(line.find("\"id\":\"mate\""), std::string::npos) << line;
+            EXPECT_NE(line.find("\"bestmove\":\"a1a8\""), std::string::npos) << line;
+            EXPECT_NE(line.find("\"mate\":1,"), std::string::npos) << line;
+        }
+    }
+    EXPECT_EQ(indexes, (std::set<size_t>{1, 3, 4, 6}));
+    std::filesystem::remove(in_path);
+    std::filesystem::remove(out_path);
+}
@@ -0,0 +1,73 @@
+#include "engine/data/bookgen.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <set>
+
+// Petit arbre : le livre se relit avec Book, chaque entrée est légale et porte sa profondeur ;
+// une seconde passe à la même profondeur ne recherche plus rien
+TEST(BookgenTest, WritesPlayableBookAndResumes)
+{
+    MoveGen::initialize_bitboard_tables();
+    const std::string path = (std::filesystem::temp_directory_path() / "chess26_test_bookgen.bin").string();
+    std::filesystem::remove(path);
+
+    bookgen::Config config;
+    config.out_path = path;
+    config.plies = 2;
+    config.depth = 2;
+    config.max_moves = 2;
+    config.margin_cp = 1000;
+    config.threads = 2;
+    config.hash_mb = 1;
+
+    Board root;
+    root.load_fen(constants::FenInitPos);
+
+    bookgen::Generator first(config);
+    ASSERT_TRUE(first.run(root));
+    EXPECT_EQ(first.get_stats().positions.load(), 3); // Racine et ses deux coups retenus
+    EXPECT_EQ(first.get_stats().skipped.load(), 0);
+
+    std::vector<Book::Record> records;
+    ASSERT_TRUE(Book::read_records(path, records));
+    ASSERT_EQ(records.size(), 6u);
+    for (size_t i = 1; i < records.size(); ++i)
+        EXPECT_LE(records[i - 1].key, records[i].key);
+    for (const Book::Record &r : records)
+    {
+        EXPECT_EQ(bookgen::learn_depth(r.learn), config.depth);
+        EXPECT_GT(r.weight, 0);
+    }
+
+    Book::init(path);
+    std::uint64_t rng = 3;
+    const Move m = Book::probe(root, rng);
+    EXPECT_NE(m.get_value(), 0);
+    Board after = root;
+    after.play(m);
+    EXPECT_NE(Book::probe(after, rng).get_value(), 0);
+    Book::close();
+
+    bookgen::Generator again(config);
+    ASSERT_TRUE(again.run(root));
+    EXPECT_EQ(again.get_stats().positions.load(), 0);
+    EXPECT_EQ(again.get_stats().skipped.load(), 3);
+
+    // Plus profond : l'arbre est recherché à nouveau, les positions déjà connues sont remplacées
+    // (les autres restent au livre), sans doublon dans le fichier
+    config.depth = 3;
+    bookgen::Generator deeper(config);
+    ASSERT_TRUE(deeper.run(root));
+    EXPECT_EQ(deeper.get_stats().positions.load(), 3);
+    ASSERT_TRUE(Book::read_records(path, records));
+    std::set<std::pair<std::uint64_t, std::uint16_t>> unique;
+    int deep = 0;
+    for (const Book::Record &r : records)
+    {
+        EXPECT_TRUE(unique.insert({r.key, r.move}).second);
+        deep += bookgen::learn_depth(r.learn) == 3;
+    }
+    EXPECT_EQ(deep, 6);
+    std::filesystem::remove(path);
+}
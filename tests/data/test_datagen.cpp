@@ -0,0 +1,43 @@
+#include "engine/data/datagen.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+
+// Quelques parties courtes : chaque enregistrement se décode, porte un résultat et un score
+TEST(DatagenTest, WritesLabeledQuietPositions)
+{
+    MoveGen::initialize_bitboard_tables();
+    const std::string path = (std::filesystem::temp_directory_path() / "chess26_test_datagen.bin").string();
+    std::filesystem::remove(path);
+
+    datagen::Config config;
+    config.out_path = path;
+    config.games = 4;
+    config.nodes = 300;
+    config.threads = 2;
+    config.max_plies = 60;
+    config.seed = 7;
+
+    datagen::Generator gen(config);
+    ASSERT_TRUE(gen.run());
+    EXPECT_EQ(gen.get_stats().games.load(), 4);
+    // W/D/L décrit les parties écrites
+    const datagen::Stats &stats = gen.get_stats();
+    EXPECT_EQ(stats.results[0].load() + stats.results[1].load() + stats.results[2].load(), stats.games.load());
+
+    packed::PackedFile file;
+    ASSERT_TRUE(file.open(path));
+    const auto positions = file.positions();
+    EXPECT_EQ(static_cast<long long>(positions.size()), gen.get_stats().positions.load());
+    EXPECT_GT(positions.size(), 0u);
+    for (const PackedPosition &p : positions)
+    {
+        Board b;
+        EXPECT_TRUE(b.unpack(p));
+        EXPECT_NE(p.result, PackedPosition::Unknown);
+        EXPECT_NE(p.score, PackedPosition::NoScore);
+        EXPECT_GE(p.ply, config.random_plies);
+        EXPECT_FALSE(b.is_king_attacked(b.get_side_to_move()));
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,145 @@
+#include "engine/eval/book.hpp"
+#include "core/move/generator/move_generator.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+class BookTest : public ::testing::Test
+{
+protected:
+    std::string path;
+
+    static void SetUpTestSuite()
+    {
+        MoveGen::initialize_bitboard_tables();
+    }
+
+    void SetUp() override
+    {
+        path = (std::filesystem::temp_directory_path() / "chess26_test_book.bin").string();
+    }
+
+    void TearDown() override
+    {
+        Book::init(path + ".missing");
+        std::remove(path.c_str());
+    }
+
+    static void put_be(std::vector<char> &out, uint64_t v, int bytes)
+    {
+        for (int i = bytes - 1; i >= 0; --i)
+            out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+
+    // Entrées (clé, coup, poids) déjà triées, au format Polyglot
+    void write_book(const std::vector<std::tuple<uint64_t, uint16_t, uint16_t>> &rows, size_t extra_bytes = 0)
+    {
+        std::vector<char> data;
+        for (const auto &[key, move, weight] : rows)
+        {
+            put_be(data, key, 8);
+            put_be(data, move, 2);
+            put_be(data, weight, 2);
+            put_be(data, 0, 4);
+        }
+        data.insert(data.end(), extra_bytes, '\0');
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    static uint16_t poly(int from, int to) { return static_cast<uint16_t>((from << 6) | to); }
+};
+
+TEST_F(BookTest, ProbesMappedFileInPlace)
+{
+    Board b;
+    b.load_fen(constants::FenInitPos);
+    const uint64_t start_key = b.polyglot_key();
+
+    // e2e4 et d2d4 pour la position initiale, entourées de clés voisines
+    write_book({{start_key - 1, poly(6, 21), 10},
+                {start_key, poly(12, 28), 5},
+                {start_key, poly(11, 27), 5},
+                {start_key + 1, poly(1, 18), 10}},
+               7);
+    Book::init(path);
+    ASSERT_EQ(Book::size(), 4u);
+
+    // Même graine, même suite de coups ; les deux coups finissent par sortir
+    std::uint64_t rng_a = 42, rng_b = 42;
+    bool seen_e4 = false, seen_d4 = false;
+    for (int i = 0; i < 64; ++i)
+    {
+        const Move m = Book::probe(b, rng_a);
+        ASSERT_EQ(m.get_value(), Book::probe(b, rng_b).get_value());
+        ASSERT_TRUE(m.to_uci() == "e2e4" || m.to_uci() == "d2d4") << m.to_uci();
+        seen_e4 |= m.to_uci() == "e2e4";
+        seen_d4 |= m.to_uci() == "d2d4";
+    }
+    EXPECT_TRUE(seen_e4 && seen_d4);
+
+    b.load_fen("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+    EXPECT_EQ(Book::probe(b, rng_a).get_value(), 0);
+}
+
+TEST_F(BookTest, ZeroWeightAndMissingFileGiveNoMove)
+{
+    Board b;
+    b.load_fen(constants::FenInitPos);
+    write_book({{b.polyglot_key(), poly(12, 28), 0}});
+    Book::init(path);
+    std::uint64_t rng = 1;
+    EXPECT_EQ(Book::probe(b, rng).get_value(), 0);
+
+    // Collision de clé : le coup du livre n'est pas légal ici
+    write_book({{b.polyglot_key(), poly(12, 36), 1}});
+    Book::init(path);
+    EXPECT_EQ(Book::probe(b, rng).get_value(), 0);
+
+    Book::init(path + ".missing");
+    EXPECT_EQ(Book::size(), 0u);
+    EXPECT_EQ(Book::probe(b, rng).get_value(), 0);
+}
+
+TEST_F(BookTest, DecodesSpecialMovesWithoutMoveGeneration)
+{
+    Board b;
+    // Roque Polyglot : le roi vers sa tour
+    b.load_fen("r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R w KQkq - 0 1");
+    Move m = Book::decode(poly(4, 7), b);
+    EXPECT_EQ(m.to_uci(), "e1g1");
+    EXPECT_TRUE(b.is_move_pseudo_legal(m) && b.is_move_legal(m));
+    EXPECT_EQ(Book::decode(poly(4, 0), b).to_uci(), "e1c1");
+    b.load_fen("r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R b KQkq - 0 1");
+    EXPECT_EQ(Book::decode(poly(60, 63), b).to_uci(), "e8g8");
+
+    // Promotion (code 3 : tour) et prise en passant
+    b.load_fen("8/4P1k1/8/8/8/8/6K1/8 w - - 0 1");
+    m = Book::decode(static_cast<uint16_t>((3 << 12) | poly(52, 60)), b);
+    EXPECT_TRUE(m.is_promotion());
+    EXPECT_EQ(m.get_promo_piece(), ROOK);
+    b.load_fen("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1");
+    m = Book::decode(poly(36, 43), b);
+    EXPECT_TRUE(b.is_move_pseudo_legal(m) && b.is_move_legal(m));
+    EXPECT_EQ(m.to_uci(), "e5d6");
+
+    // encode puis decode rend le coup du générateur pour chaque coup légal (roques, prises, promotions, en passant)
+    for (const char *fen : {constants::FenInitPos.data(),
+                            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                            "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 b kq - 0 1",
+                            "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"})
+    {
+        b.load_fen(fen);
+        MoveList list;
+        MoveGen::generate_legal_moves(b, list);
+        for (int i = 0; i < list.count; ++i)
+        {
+            const Move g = list[i];
+            const Move d = Book::decode(Book::encode(g), b);
+            EXPECT_EQ(d.get_value(), g.get_value()) << fen << " " << g.to_uci() << " " << d.to_uci();
+        }
+    }
+}
@@ -31,4 +31,40 @@ TEST_F(EngineTest, PinTest)
     e.wait();
     Move last_move = e.get_root_best_move();
     ASSERT_EQ(last_move, Move(Square::h2, Square::h3, PAWN));
-}
\ No newline at end of file
+}
+// Mat trouvé hors de la fenêtre d'aspiration : le coup racine doit être celui du mat, pas celui d'une itération précédente
+TEST_F(EngineTest, MateOutsideAspirationWindowUpdatesRootMove)
+{
+    VBoard b;
+    b.load_fen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+    EngineManager e{b, 8};
+    const auto r = e.search_nodes(b, 20000);
+    EXPECT_EQ(r.best_move, Move(Square::a1, Square::a8, ROOK));
+}
+
+TEST_F(EngineTest, FixedNodeSearchStopsNearLimit)
+{
+    VBoard b;
+    b.load_fen(constants::FenInitPos);
+    EngineManager e{b, 8};
+    const auto r = e.search_nodes(b, 5000);
+    EXPECT_NE(r.best_move.get_value(), 0u);
+    EXPECT_GE(r.nodes, 5000);
+    EXPECT_LT(r.nodes, 5000 + 1024 * 2);
+}
+
+TEST_F(EngineTest, DepthLimitedSearchUsesAllThreads)
+{
+    VBoard b;
+    b.load_fen("r3k2r/p1ppqpb1/bn2pnp1/2pP4/1p2P3/2N2N2/PPQBBPPP/R3K2R w KQkq - 0 1");
+    EngineManager e{b, 8};
+    e.set_threads(3);
+    const auto r = e.search_depth(5);
+    EXPECT_EQ(r.depth, 5);
+    EXPECT_GT(r.nodes, 0);
+    ASSERT_NE(r.best_move.get_value(), 0u);
+    EXPECT_TRUE(b.is_move_pseudo_legal(r.best_move) && b.is_move_legal(r.best_move));
+
+    // La limite ne survit pas à la recherche suivante
+    EXPECT_EQ(e.get_depth_limit(), 0);
+}
@@ -0,0 +1,105 @@
+#include "engine/eval/eval_params.hpp"
+#include "engine/eval/pos_eval.hpp"
+#include "core/move/generator/move_generator.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+class EvalParamsTest : public ::testing::Test
+{
+protected:
+    std::string path;
+
+    static void SetUpTestSuite()
+    {
+        MoveGen::initialize_bitboard_tables();
+    }
+
+    void SetUp() override
+    {
+        path = (std::filesystem::temp_directory_path() / "chess26_test_params.bin").string();
+    }
+
+    void TearDown() override
+    {
+        Eval::reset_params();
+        std::remove(path.c_str());
+    }
+};
+
+TEST_F(EvalParamsTest, DefaultsMatchCompiledValues)
+{
+    const Eval::ParamSet &p = Eval::default_params();
+    for (int piece = PAWN; piece <= KING; ++piece)
+        EXPECT_EQ(p[Eval::Layout::Material + piece], static_cast<int>(engine_constants::eval::pieces_score[piece]));
+    EXPECT_EQ(p[Eval::Layout::MgPst + KNIGHT * 64 + 27], static_cast<int>(engine_constants::eval::mg_knight_table[27]));
+    EXPECT_EQ(p[Eval::Layout::EgPst + KING * 64 + 63], static_cast<int>(engine_constants::eval::eg_king_table[63]));
+    EXPECT_EQ(p[Eval::Layout::QueenMob + 27], static_cast<int>(engine_constants::eval::queen_mob[27]));
+    EXPECT_EQ(Eval::params(), Eval::current_params().v);
+}
+
+TEST_F(EvalParamsTest, LoadedFileChangesEvalAndResetRestoresIt)
+{
+    VBoard b;
+    b.load_fen("r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/2N2N2/PPPP1PPP/R1BQK2R w KQkq - 0 1");
+    const int base_eval = Eval::hce_eval(b, -engine_constants::eval::Inf, engine_constants::eval::Inf);
+    const int base_material = b.get_eval_state().pieces_val[WHITE];
+    const std::uint64_t base_id = Eval::fingerprint();
+
+    Eval::ParamSet p = Eval::default_params();
+    p[Eval::Layout::Material + BISHOP] += 100;
+    ASSERT_TRUE(Eval::save_params(path, p));
+
+    Eval::ParamSet read;
+    ASSERT_TRUE(Eval::read_params(path, read));
+    for (int i = 0; i < Eval::Layout::Count; ++i)
+        ASSERT_EQ(read[i], p[i]) << i;
+
+    ASSERT_TRUE(Eval::load_params(path));
+    b.refresh_eval_state();
+    EXPECT_NE(Eval::fingerprint(), base_id);
+    EXPECT_EQ(Eval::get_piece_score(BISHOP), p[Eval::Layout::Material + BISHOP]);
+    EXPECT_EQ(b.get_eval_state().pieces_val[WHITE], base_material + 200);
+    // Une paire de fous de chaque côté : les deux camps gagnent autant
+    EXPECT_EQ(Eval::hce_eval(b, -engine_constants::eval::Inf, engine_constants::eval::Inf), base_eval);
+
+    b.load_fen("r1bqk2r/pppp1ppp/2n2n2/4p3/2B1P3/2N2N2/PPPP1PPP/R1BQK2R w KQkq - 0 1");
+    const int boosted = Eval::hce_eval(b, -engine_constants::eval::Inf, engine_constants::eval::Inf);
+
+    Eval::reset_params();
+    b.refresh_eval_state();
+    EXPECT_EQ(Eval::fingerprint(), base_id);
+    EXPECT_NEAR(boosted - Eval::hce_eval(b, -engine_constants::eval::Inf, engine_constants::eval::Inf), 100, 1);
+}
+
+TEST_F(EvalParamsTest, RejectsCorruptFiles)
+{
+    ASSERT_TRUE(Eval::save_params(path, Eval::default_params()));
+    const auto size = std::filesystem::file_size(path);
+
+    Eval::ParamSet p = Eval::default_params();
+    p[Eval::Layout::Material + KNIGHT] += 50;
+    Eval::set_params(p);
+
+    // Tronqué
+    std::filesystem::resize_file(path, size - 2);
+    EXPECT_FALSE(Eval::load_params(path));
+
+    // Octets en trop
+    std::filesystem::resize_file(path, size + 2);
+    EXPECT_FALSE(Eval::load_params(path));
+
+    // Mauvais magic
+    ASSERT_TRUE(Eval::save_params(path, Eval::default_params()));
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.put('X');
+    }
+    EXPECT_FALSE(Eval::load_params(path));
+    EXPECT_FALSE(Eval::load_params(path + ".missing"));
+
+    // Le jeu actif n'a pas bougé
+    EXPECT_EQ(Eval::get_piece_score(KNIGHT), p[Eval::Layout::Material + KNIGHT]);
+}
@@ -0,0 +1,202 @@
+#include "engine/eval/pos_eval.hpp"
+#include "core/move/generator/move_generator.hpp"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+class NNUETest : public ::testing::Test
+{
+protected:
+    std::string path;
+
+    static void SetUpTestSuite()
+    {
+        MoveGen::initialize_bitboard_tables();
+    }
+
+    // Réseau aléatoire au format attendu, petits poids pour rester loin de la saturation
+    void write_net(size_t size)
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> dist(-64, 64);
+
+        std::vector<int16_t> data(size / sizeof(int16_t));
+        for (auto &v : data)
+            v = static_cast<int16_t>(dist(rng));
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(data.data()), size);
+    }
+
+    void SetUp() override
+    {
+        path = (std::filesystem::temp_directory_path() / "chess26_test_net.bin").string();
+        write_net(NNUE::FileSize);
+    }
+
+    void TearDown() override
+    {
+        NNUE::unload();
+        std::filesystem::remove(path);
+    }
+
+    // leaves_only : l'accumulateur n'est demandé qu'aux feuilles, les coups intermédiaires restent en attente
+    static void check_tree(VBoard &b, int depth, int &checked, bool leaves_only = false)
+    {
+        MoveList list;
+        MoveGen::generate_legal_moves(b, list);
+        for (int i = 0; i < list.count; ++i)
+        {
+            const Move m = list[i];
+            b.play(m);
+
+            if (!leaves_only || depth == 1)
+            {
+                NNUE::Accumulator ref;
+                NNUE::refresh(ref, b);
+                ASSERT_EQ(std::memcmp(&ref, &b.get_accumulator(), sizeof(ref)), 0) << "Accumulateur faux après " << m.to_uci();
+                ++checked;
+            }
+
+            if (depth > 1)
+                check_tree(b, depth - 1, checked, leaves_only);
+            b.unplay(m);
+            if (::testing::Test::HasFatalFailure())
+                return;
+        }
+    }
+
+    static int check_fens(bool leaves_only)
+    {
+        int checked = 0;
+        for (const char *fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                                "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                                "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"})
+        {
+            VBoard b;
+            b.load_fen(fen);
+            check_tree(b, 3, checked, leaves_only);
+            if (::testing::Test::HasFatalFailure())
+            {
+                ADD_FAILURE() << fen;
+                break;
+            }
+        }
+        return checked;
+    }
+};
+
+TEST_F(NNUETest, RejectsWrongSize)
+{
+    std::filesystem::resize_file(path, NNUE::FileSize - 2);
+    EXPECT_FALSE(NNUE::load(path));
+    EXPECT_FALSE(NNUE::is_loaded());
+}
+
+TEST_F(NNUETest, BadFileKeepsLoadedNetwork)
+{
+    ASSERT_TRUE(NNUE::load(path));
+    const int16_t bias = NNUE::network.output_bias;
+    std::filesystem::resize_file(path, NNUE::FileSize - 2);
+    EXPECT_FALSE(NNUE::load(path));
+    EXPECT_FALSE(NNUE::load(path + ".missing"));
+    EXPECT_TRUE(NNUE::is_loaded());
+    EXPECT_EQ(NNUE::network.output_bias, bias);
+}
+
+TEST_F(NNUETest, IncrementalMatchesRefresh)
+{
+    ASSERT_TRUE(NNUE::load(path));
+    EXPECT_GT(check_fens(false), 10000);
+}
+
+TEST_F(NNUETest, LazyUpdatesMatchRefresh)
+{
+    ASSERT_TRUE(NNUE::load(path));
+    EXPECT_GT(check_fens(true), 10000);
+}
+
+// Copie et affectation repartent de la position copiée au premier usage, pile de l'original intacte
+TEST_F(NNUETest, CopiedBoardsMatchRefresh)
+{
+    ASSERT_TRUE(NNUE::load(path));
+    VBoard b;
+    b.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    MoveList list;
+    MoveGen::generate_legal_moves(b, list);
+    b.play(list[0]);
+
+    VBoard copy(b);
+    VBoard assigned;
+    assigned.load_fen(constants::FenInitPos);
+    assigned.get_accumulator();
+    assigned = b;
+    for (const VBoard *v : {&b, &copy, &assigned})
+    {
+        NNUE::Accumulator ref;
+        NNUE::refresh(ref, *v);
+        EXPECT_EQ(std::memcmp(&ref, &v->get_accumulator(), sizeof(ref)), 0);
+    }
+
+    int checked = 0;
+    check_tree(copy, 2, checked);
+    check_tree(assigned, 2, checked);
+    EXPECT_GT(checked, 1000);
+}
+
+// Les coups de roi qui changent de bucket ou de moitié repartent du cache de rafraîchissement
+TEST_F(NNUETest, KingBucketsMatchRefresh)
+{
+    write_net(NNUE::BucketedFileSize);
+    ASSERT_TRUE(NNUE::load(path));
+    ASSERT_TRUE(NNUE::is_bucketed());
+
+    EXPECT_GT(check_fens(false), 10000);
+    EXPECT_GT(check_fens(true), 10000);
+}
+
+TEST_F(NNUETest, MirroredPositionsScoreTheSame)
+{
+    for (size_t size : {NNUE::FileSize, NNUE::BucketedFileSize})
+    {
+        write_net(size);
+        ASSERT_TRUE(NNUE::load(path));
+
+        VBoard b, mirrored;
+        b.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+        mirrored.load_fen("r3k2r/pppbbppp/2n2q1P/1P2p3/3pn3/BN2PNP1/P1PPQPB1/R3K2R b KQkq - 0 1");
+
+        EXPECT_EQ(Eval::eval_relative<WHITE>(b, -engine_constants::eval::Inf, engine_constants::eval::Inf),
+                  Eval::eval_relative<BLACK>(mirrored, -engine_constants::eval::Inf, engine_constants::eval::Inf));
+    }
+}
+
+TEST_F(NNUETest, UnloadFallsBackToHCE)
+{
+    VBoard b;
+    b.load_fen(constants::FenInitPos);
+    const int hce = Eval::eval(b, -engine_constants::eval::Inf, engine_constants::eval::Inf);
+
+    ASSERT_TRUE(NNUE::load(path));
+    NNUE::unload();
+    EXPECT_EQ(Eval::eval(b, -engine_constants::eval::Inf, engine_constants::eval::Inf), hce);
+}
+
+// Élagage jugé sur l'échelle du réseau quand il est chargé
+TEST_F(NNUETest, LazyEvalUsesNetworkWhenLoaded)
+{
+    VBoard b;
+    b.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1");
+    const int material_pst = Eval::lazy_eval_relative<BLACK>(b);
+
+    ASSERT_TRUE(NNUE::load(path));
+    b.refresh_accumulator();
+    EXPECT_EQ(Eval::lazy_eval_relative<BLACK>(b), Eval::eval_relative<BLACK>(b, -engine_constants::eval::Inf, engine_constants::eval::Inf));
+
+    NNUE::unload();
+    EXPECT_EQ(Eval::lazy_eval_relative<BLACK>(b), material_pst);
+}
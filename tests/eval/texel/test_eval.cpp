@@ -2,11 +2,13 @@
 
 #include "engine/eval/pos_eval.hpp"
 #include "engine/eval/tuning/eval_features.hpp"
+#include "engine/eval/tuning/sparse_features.hpp"
 #include "engine/eval/virtual_board.hpp"
 #include "engine/config/eval.hpp"
 #include "gtest/gtest.h"
 #include <string>
 #include <array>
+#include <vector>
 
 class TexelTuningEvalTest : public ::testing::Test
 {
@@ -31,4 +33,80 @@ TEST_F(TexelTuningEvalTest, EvalConsistency)
     }
 }
 
+static Texel::SparseDataset make_dataset(const std::vector<std::pair<std::string, double>> &samples)
+{
+    Texel::SparseDataset d;
+    for (const auto &[fen, result] : samples)
+    {
+        VBoard b;
+        b.load_fen(fen);
+        d.add(Eval::extract_eval_features(b), b.get_eval_state().phase, result);
+    }
+    return d;
+}
+
+TEST_F(TexelTuningEvalTest, SparseScoreMatchesEval)
+{
+    const std::vector<std::pair<std::string, double>> samples = {
+        {"8/8/1kq5/8/4R3/3QK3/8/8 w - - 0 1", 0.5},
+        {"rn1qkbnr/pp2pppp/2p5/5b2/3PN3/8/PPP2PPP/R1BQKBNR w KQkq - 0 1", 0.5},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 0.5}};
+    const Texel::SparseDataset d = make_dataset(samples);
+    ASSERT_EQ(d.size(), samples.size());
+
+    std::vector<double> w;
+    Texel::gather_weights(w);
+    std::vector<double> scores(d.size());
+    Texel::score_batch(d, 0, d.size(), w.data(), scores.data());
+
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        VBoard b;
+        b.load_fen(samples[i].first);
+        EXPECT_EQ(static_cast<int>(scores[i]), Eval::hce_eval(b, -engine_constants::eval::Inf, engine_constants::eval::Inf)) << samples[i].first;
+    }
+}
+
+TEST_F(TexelTuningEvalTest, SparseGradientMatchesFiniteDifference)
+{
+    const Texel::SparseDataset d = make_dataset({
+        {"rn1qkbnr/pp2pppp/2p5/5b2/3PN3/8/PPP2PPP/R1BQKBNR w KQkq - 0 1", 1.0},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 0.0},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 0.5},
+    });
+    constexpr double k = 1.2755;
+
+    auto loss = [&]()
+    {
+        std::vector<double> w, eval(d.size()), common(d.size());
+        Texel::gather_weights(w);
+        Texel::score_batch(d, 0, d.size(), w.data(), eval.data());
+        return Texel::error_batch(d.result.data(), eval.data(), d.size(), k, common.data());
+    };
+
+    std::vector<double> w, eval(d.size()), common(d.size()), g(2 * Texel::Layout::Count, 0.0);
+    Texel::gather_weights(w);
+    Texel::score_batch(d, 0, d.size(), w.data(), eval.data());
+    Texel::error_batch(d.result.data(), eval.data(), d.size(), k, common.data());
+    Texel::gradient_batch(d, 0, d.size(), common.data(), g.data());
+
+    int non_zero = 0;
+    for (int i = 0; i < Texel::Layout::Count; ++i)
+    {
+        TunableParam &p = Texel::param(i);
+        const double saved = p.value;
+        constexpr double h = 1e-3;
+        p.value = saved + h;
+        const double up = loss();
+        p.value = saved - h;
+        const double down = loss();
+        p.value = saved;
+
+        const double numeric = (up - down) / (2 * h);
+        non_zero += (numeric != 0.0);
+        EXPECT_NEAR(Texel::param_gradient(g, i), numeric, 1e-9 + 1e-4 * std::abs(numeric)) << "param " << i;
+    }
+    EXPECT_GT(non_zero, 50);
+}
+
 #endif
\ No newline at end of file
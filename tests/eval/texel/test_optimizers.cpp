@@ -0,0 +1,82 @@
+#include "engine/eval/tuning/optimizers.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <vector>
+
+// f(x) = somme a_i (x_i - c_i)², mal conditionnée (a de 1 à 100)
+static double quadratic(const std::vector<double> &x, std::vector<double> &g)
+{
+    double f = 0.0;
+    g.resize(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        const double a = 1.0 + 99.0 * static_cast<double>(i) / static_cast<double>(x.size() - 1);
+        const double c = static_cast<double>(i) - 3.0;
+        f += a * (x[i] - c) * (x[i] - c);
+        g[i] = 2.0 * a * (x[i] - c);
+    }
+    return f;
+}
+
+TEST(TexelOptimizerTest, AdamConvergesOnQuadratic)
+{
+    std::vector<double> x(8, 0.0), g;
+    Texel::Adam adam;
+    adam.lr = 0.1;
+    for (int it = 0; it < 3000; ++it)
+    {
+        quadratic(x, g);
+        adam.step(x, g);
+    }
+    EXPECT_LT(quadratic(x, g), 1e-4);
+}
+
+TEST(TexelOptimizerTest, LbfgsConvergesOnQuadratic)
+{
+    std::vector<double> x(8, 0.0), g;
+    double fx = quadratic(x, g);
+    Texel::Lbfgs lbfgs;
+    int it = 0;
+    while (it < 100 && fx > 1e-12 && lbfgs.iterate(x, fx, g, quadratic))
+        ++it;
+    EXPECT_LT(fx, 1e-8);
+    EXPECT_LT(it, 60);
+}
+
+TEST(TexelOptimizerTest, CheckpointRoundTrip)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "chess26_test_checkpoint.bin").string();
+
+    Texel::Checkpoint c;
+    c.optimizer = Texel::OptimizerKind::LBFGS;
+    c.epoch = 12;
+    c.epochs_since_best = 3;
+    c.k = 1.31;
+    c.learning_rate = 0.5;
+    c.best_valid_loss = 0.0712;
+    c.adam_t = 99;
+    c.params = {1.0, -2.0, 3.5};
+    c.best_params = {0.5, -1.0, 3.0};
+    c.adam_m = {0.1, 0.2, 0.3};
+    c.adam_v = {};
+    ASSERT_TRUE(Texel::save_checkpoint(path, c));
+
+    Texel::Checkpoint r;
+    ASSERT_TRUE(Texel::load_checkpoint(path, 3, r));
+    EXPECT_EQ(r.optimizer, c.optimizer);
+    EXPECT_EQ(r.epoch, c.epoch);
+    EXPECT_EQ(r.epochs_since_best, c.epochs_since_best);
+    EXPECT_EQ(r.k, c.k);
+    EXPECT_EQ(r.learning_rate, c.learning_rate);
+    EXPECT_EQ(r.best_valid_loss, c.best_valid_loss);
+    EXPECT_EQ(r.adam_t, c.adam_t);
+    EXPECT_EQ(r.params, c.params);
+    EXPECT_EQ(r.best_params, c.best_params);
+    EXPECT_EQ(r.adam_m, c.adam_m);
+    EXPECT_TRUE(r.adam_v.empty());
+
+    // Autre nombre de paramètres : refusé
+    EXPECT_FALSE(Texel::load_checkpoint(path, 4, r));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,151 @@
+#ifdef TEXEL_TUNING
+
+#include "engine/eval/tuning/texel_data.hpp"
+#include "core/move/generator/move_generator.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class TexelDataTest : public ::testing::Test
+{
+protected:
+    std::string path;
+    std::vector<std::string> lines;
+
+    static void SetUpTestSuite()
+    {
+        MoveGen::initialize_bitboard_tables();
+    }
+
+    void SetUp() override
+    {
+        path = (std::filesystem::temp_directory_path() / "chess26_test_texel.epd").string();
+
+        const char *fens[] = {
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -",
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
+            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -",
+            "rn1qkbnr/pp2pppp/2p5/5b2/3PN3/8/PPP2PPP/R1BQKBNR b KQkq -"};
+        const char *results[] = {"\"1-0\";", "\"0-1\";", "\"1/2-1/2\";"};
+
+        for (int i = 0; i < 200; ++i)
+            lines.push_back(std::string(fens[i % 4]) + " c9 " + results[i % 3]);
+        lines[17] = "garbage line";
+        lines[42] += "\r"; // Fin de ligne Windows
+
+        std::ofstream out(path, std::ios::binary);
+        for (const auto &l : lines)
+            out << l << "\n";
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(TexelDataTest, ParsesQuietLabeledLines)
+{
+    const auto s = parse_quiet_labeled_line("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - c9 \"0-1\";");
+    ASSERT_TRUE(s.has_value());
+    EXPECT_EQ(s->fen, "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -");
+    EXPECT_EQ(s->result, 0.0);
+
+    EXPECT_FALSE(parse_quiet_labeled_line("8/8/8/8 w - - c0 \"1-0\";").has_value());
+    EXPECT_FALSE(parse_quiet_labeled_line("8/8/8/8 w - - c9 \"2-0\";").has_value());
+    EXPECT_FALSE(parse_quiet_labeled_line("8/8/8/8 w -").has_value());
+}
+
+// Petits morceaux et plusieurs threads : même contenu et même ordre qu'une lecture séquentielle
+TEST_F(TexelDataTest, ChunkedParallelReadMatchesSequential)
+{
+    Texel::SparseDataset expected;
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+        const auto s = parse_quiet_labeled_line(lines[i]);
+        if (!s.has_value())
+            continue;
+        VBoard b;
+        ASSERT_TRUE(b.load_fen(s->fen));
+        expected.add(Eval::extract_eval_features(b), b.get_eval_state().phase, s->result);
+    }
+    ASSERT_EQ(expected.size(), lines.size() - 1);
+
+    TexelDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    Texel::SparseDataset got;
+    std::size_t chunks = 0, next_first = 0;
+    const auto stats = reader.for_each_chunk(1000, 3, [&](const Texel::SparseDataset &chunk, std::size_t first, std::size_t done)
+                                             {
+        EXPECT_EQ(first, next_first);
+        EXPECT_LE(done, reader.size_bytes());
+        next_first += chunk.size();
+        got.append(chunk);
+        ++chunks;
+        return true; });
+
+    EXPECT_GT(chunks, 5u);
+    EXPECT_EQ(stats.lines, lines.size());
+    EXPECT_EQ(stats.rejected, 1u);
+    EXPECT_EQ(stats.samples, expected.size());
+
+    EXPECT_EQ(got.result, expected.result);
+    EXPECT_EQ(got.phase, expected.phase);
+    EXPECT_EQ(got.offset, expected.offset);
+    EXPECT_EQ(got.index, expected.index);
+    EXPECT_EQ(got.coeff, expected.coeff);
+}
+
+// epd2bin puis lecture du .bin : mêmes features et mêmes résultats que l'EPD
+TEST_F(TexelDataTest, PackedFileMatchesEpd)
+{
+    const std::string bin_path = (std::filesystem::temp_directory_path() / "chess26_test_texel.bin").string();
+    packed::ConvertStats conv;
+    ASSERT_TRUE(packed::convert_epd(path, bin_path, 3, conv));
+    EXPECT_EQ(conv.lines, lines.size());
+    EXPECT_EQ(conv.rejected, 1u);
+    EXPECT_EQ(std::filesystem::file_size(bin_path), conv.written * sizeof(PackedPosition));
+
+    auto read_all = [](const std::string &p, TexelDataReader::Stats &stats)
+    {
+        TexelDataReader reader;
+        EXPECT_TRUE(reader.open(p));
+        Texel::SparseDataset all;
+        stats = reader.for_each_chunk(1000, 3, [&](const Texel::SparseDataset &chunk, std::size_t, std::size_t)
+                                      {
+            all.append(chunk);
+            return true; });
+        return all;
+    };
+
+    TexelDataReader::Stats epd_stats, bin_stats;
+    const Texel::SparseDataset epd = read_all(path, epd_stats);
+    const Texel::SparseDataset bin = read_all(bin_path, bin_stats);
+    std::filesystem::remove(bin_path);
+
+    EXPECT_EQ(bin_stats.samples, epd_stats.samples);
+    EXPECT_EQ(bin_stats.rejected, 0u);
+    EXPECT_EQ(bin.result, epd.result);
+    EXPECT_EQ(bin.phase, epd.phase);
+    EXPECT_EQ(bin.offset, epd.offset);
+    EXPECT_EQ(bin.index, epd.index);
+    EXPECT_EQ(bin.coeff, epd.coeff);
+}
+
+TEST_F(TexelDataTest, StopsWhenCallbackReturnsFalse)
+{
+    TexelDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    int calls = 0;
+    const auto stats = reader.for_each_chunk(1000, 2, [&](const Texel::SparseDataset &, std::size_t, std::size_t)
+                                             { return ++calls < 2; });
+    EXPECT_EQ(calls, 2);
+    EXPECT_LT(stats.lines, lines.size());
+}
+
+#endif
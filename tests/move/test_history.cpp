@@ -171,4 +171,30 @@ TEST_F(HistoryTest, ZobristConsistency_DeepRandomSearch)
         EXPECT_EQ(b.get_hash(), keys_at_ply[0])
             << "La clé finale après avoir tout annulé ne correspond pas à la clé initiale.";
     }
-}
\ No newline at end of file
+}
+// 6. Copie partielle : seule la fenêtre réversible est copiée, la détection de répétition reste correcte
+TEST_F(HistoryTest, TailWindowCopy_KeepsRepetitions)
+{
+    Board b;
+    b.load_fen(constants::FenInitPos);
+
+    const char *moves[] = {"e2e4", "e7e5", "g1f3", "b8c6", "f3g1", "c6b8", "g1f3", "b8c6", "f3g1"};
+    for (const char *uci : moves)
+        b.play(Board::parse_move_uci(uci, b).value());
+
+    // Dernier coup irréversible : e7e5 (index 1)
+    EXPECT_EQ(b.history_window_start(), 1u);
+
+    b.play(Board::parse_move_uci("c6b8", b).value());
+    Board copy = b;
+    EXPECT_EQ(copy.get_history()->size(), b.get_history()->size());
+    EXPECT_EQ(copy.get_history()->back().zobrist_key, b.get_history()->back().zobrist_key);
+    EXPECT_TRUE(b.is_repetition());
+    EXPECT_TRUE(copy.is_repetition());
+
+    // Le bloc recyclé par l'arène ne doit pas garder l'ancien contenu
+    Board assigned;
+    assigned = copy;
+    EXPECT_TRUE(assigned.is_repetition());
+    EXPECT_EQ(assigned.get_history()->size(), b.get_history()->size());
+}
@@ -0,0 +1,47 @@
+#include "core/move/generator/perft.hpp"
+#include "gtest/gtest.h"
+
+class CopyMakeTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        MoveGen::initialize_bitboard_tables();
+    }
+};
+
+TEST_F(CopyMakeTest, PerftMatchesMakeUnmake)
+{
+    Board b{};
+    b.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 0");
+    std::array<Position, 8> stack;
+
+    ASSERT_EQ(MoveGen::perft_copy_make(b, 3, stack.data()), 97862ULL);
+    ASSERT_EQ(MoveGen::perft_copy_make(b, 3, stack.data()), MoveGen::perft(b, 3));
+}
+
+TEST_F(CopyMakeTest, RestoreGivesBackSamePosition)
+{
+    Board b{};
+    b.load_fen("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+    const Board reference = b;
+
+    MoveList list;
+    MoveGen::generate_legal_moves(b, list);
+
+    Position p;
+    b.save_position(p);
+    for (int i = 0; i < list.count; ++i)
+    {
+        b.play(list[i]);
+        b.restore_position(p);
+
+        ASSERT_EQ(b.get_hash(), reference.get_hash()) << list[i].to_uci();
+        ASSERT_EQ(b.get_all_bitboards(), reference.get_all_bitboards()) << list[i].to_uci();
+        ASSERT_EQ(b.get_occupancy<NO_COLOR>(), reference.get_occupancy<NO_COLOR>());
+        ASSERT_EQ(std::memcmp(b.mailbox, reference.mailbox, sizeof(b.mailbox)), 0);
+        ASSERT_EQ(b.get_castling_rights(), reference.get_castling_rights());
+        ASSERT_EQ(b.get_en_passant_sq(), reference.get_en_passant_sq());
+        ASSERT_EQ(b.get_history()->size(), reference.get_history()->size());
+    }
+}
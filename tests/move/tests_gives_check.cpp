@@ -0,0 +1,76 @@
+#include "core/move/generator/move_generator.hpp"
+#include "gtest/gtest.h"
+
+class GivesCheckTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        MoveGen::initialize_bitboard_tables();
+    }
+
+    // Compare gives_check avec play + is_king_attacked sur tout l'arbre
+    static void check_tree(Board &b, int depth, int &checked)
+    {
+        MoveList list;
+        MoveGen::generate_legal_moves(b, list);
+        const Color us = b.get_side_to_move();
+
+        for (int i = 0; i < list.count; ++i)
+        {
+            const Move m = list[i];
+            const bool predicted = b.gives_check(m);
+
+            SCOPED_TRACE(m.to_uci());
+            b.play(m);
+            const bool expected = b.is_king_attacked((Color)!us);
+            ASSERT_EQ(predicted, expected) << "Coup " << m.to_uci() << " mal détecté";
+            ++checked;
+            if (depth > 1)
+                check_tree(b, depth - 1, checked);
+            b.unplay(m);
+        }
+    }
+};
+
+TEST_F(GivesCheckTest, MatchesMakeUnmake)
+{
+    const std::array<const char *, 6> fens = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "5rk1/8/8/3pP3/8/8/8/R3K2R w KQ d6 0 1",
+    };
+
+    int checked = 0;
+    for (const char *fen : fens)
+    {
+        Board b{};
+        SCOPED_TRACE(fen);
+        ASSERT_TRUE(b.load_fen(fen));
+        check_tree(b, 3, checked);
+    }
+    ASSERT_GT(checked, 0);
+}
+
+TEST_F(GivesCheckTest, SpecialMoves)
+{
+    Board b{};
+
+    // Roque qui donne échec par la tour
+    b.load_fen("5k2/8/8/8/8/8/8/4K2R w K - 0 1");
+    ASSERT_TRUE(b.gives_check(Board::parse_move_uci("e1g1", b).value()));
+
+    // Prise en passant qui découvre la dame
+    b.load_fen("8/8/8/K2pP2k/8/8/8/8 w - d6 0 1");
+    ASSERT_FALSE(b.gives_check(Board::parse_move_uci("e5d6", b).value()));
+    b.load_fen("8/8/8/Q2pP2k/8/8/8/4K3 w - d6 0 1");
+    ASSERT_TRUE(b.gives_check(Board::parse_move_uci("e5d6", b).value()));
+
+    // Promotion : la case de départ libérée ouvre la ligne
+    b.load_fen("8/1P6/8/8/8/8/8/1k2K3 w - - 0 1");
+    ASSERT_TRUE(b.gives_check(Board::parse_move_uci("b7b8q", b).value()));
+    ASSERT_FALSE(b.gives_check(Board::parse_move_uci("b7b8n", b).value()));
+}
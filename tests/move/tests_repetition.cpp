@@ -0,0 +1,102 @@
+#include "core/board/cuckoo.hpp"
+#include "core/move/generator/move_generator.hpp"
+#include "gtest/gtest.h"
+
+class RepetitionTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        MoveGen::initialize_bitboard_tables();
+        init_zobrist();
+        Cuckoo::init();
+    }
+
+    static void play_all(Board &b, std::initializer_list<const char *> moves)
+    {
+        for (const char *uci : moves)
+            b.play(Board::parse_move_uci(uci, b).value());
+    }
+};
+
+TEST_F(RepetitionTest, CuckooTable_HoldsEveryReversibleMove)
+{
+    int filled = 0;
+    for (int i = 0; i < Cuckoo::Size; ++i)
+    {
+        if (Cuckoo::moves[i].get_value() == 0)
+            continue;
+        ++filled;
+
+        // Chaque clé est retrouvée par l'une de ses deux fonctions de hachage
+        const U64 key = Cuckoo::keys[i];
+        EXPECT_TRUE(Cuckoo::h1(key) == i || Cuckoo::h2(key) == i);
+    }
+    EXPECT_EQ(filled, 3668);
+}
+
+TEST_F(RepetitionTest, UpcomingRepetition_AfterKnightShuffle)
+{
+    Board b{};
+    b.load_fen(constants::FenInitPos);
+
+    // Ng1-f3 Ng8-f6 Nf3-g1 : les noirs peuvent répéter avec Nf6-g8
+    play_all(b, {"g1f3", "g8f6", "f3g1"});
+    EXPECT_FALSE(b.is_repetition());
+    EXPECT_TRUE(b.has_upcoming_repetition(4));
+
+    // La position répétée se situe avant la racine : pas de coupure
+    EXPECT_FALSE(b.has_upcoming_repetition(3));
+
+    play_all(b, {"f6g8"});
+    EXPECT_TRUE(b.is_repetition());
+}
+
+TEST_F(RepetitionTest, UpcomingRepetition_BlockedPath)
+{
+    // La tour fait le tour par la colonne b, le roi noir boucle e8-d8-d7-e7-e8 :
+    // seule Ta5-a1 rejoint la position de départ, 7 demi-coups plus tôt
+    for (const bool blocked : {false, true})
+    {
+        Board b{};
+        b.load_fen(blocked ? "4k3/8/8/8/8/N7/8/R3K3 b - - 0 1" : "4k3/8/8/8/8/8/8/R3K3 b - - 0 1");
+        play_all(b, {"e8d8", "a1b1", "d8d7", "b1b5", "d7e7", "b5a5", "e7e8"});
+
+        // Le cavalier en a3 coupe le chemin a5-a1
+        EXPECT_EQ(b.has_upcoming_repetition(10), !blocked);
+    }
+}
+
+TEST_F(RepetitionTest, UpcomingRepetition_ResetByNullMove)
+{
+    Board b{};
+    b.load_fen(constants::FenInitPos);
+    play_all(b, {"g1f3", "g8f6", "f3g1"});
+    ASSERT_TRUE(b.has_upcoming_repetition(10));
+
+    int ep, irreversible;
+    b.play_null_move(ep, irreversible);
+    EXPECT_FALSE(b.has_upcoming_repetition(10));
+    EXPECT_FALSE(b.is_repetition());
+    b.unplay_null_move(ep, irreversible);
+    EXPECT_TRUE(b.has_upcoming_repetition(10));
+}
+
+TEST_F(RepetitionTest, KeyFilter_TracksPushPop)
+{
+    History h;
+    const U64 key = 0xABCDEF0123ULL;
+    EXPECT_FALSE(h.may_contain(key));
+
+    h.push_back({key, 0, 0, Move(), 0, 0});
+    h.push_back({key, 0, 0, Move(), 0, 0});
+    EXPECT_TRUE(h.may_contain(key));
+    h.pop_back();
+    EXPECT_TRUE(h.may_contain(key));
+    h.pop_back();
+    EXPECT_FALSE(h.may_contain(key));
+
+    h.push_back({key, 0, 0, Move(), 0, 0});
+    h.clear();
+    EXPECT_FALSE(h.may_contain(key));
+}
@@ -28,4 +28,48 @@ TEST_F(BoardTest, KnightMove_Initial)
     // Vérifie l'ancienne case (doit être vide)
     ASSERT_EQ(b.get_piece_on_square(Square::b1), empty_square)
         << "Erreur : La case de départ a2 n'est pas vide.";
-}
\ No newline at end of file
+}
+// Encodage 32 octets : même position, même hash, sans passer par une FEN
+TEST_F(BoardTest, PackUnpackRoundTrip)
+{
+    const std::string_view fens[] = {
+        constants::FenInitPos,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 12 40",
+        "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 b kq - 0 1"};
+
+    for (const std::string_view fen : fens)
+    {
+        ASSERT_TRUE(b.load_fen(fen));
+        PackedPosition p;
+        b.pack(p);
+
+        Board u;
+        ASSERT_TRUE(u.unpack(p)) << fen;
+        EXPECT_EQ(u.get_hash(), b.get_hash()) << fen;
+        EXPECT_EQ(u.get_side_to_move(), b.get_side_to_move()) << fen;
+        EXPECT_EQ(u.get_castling_rights(), b.get_castling_rights()) << fen;
+        EXPECT_EQ(u.get_en_passant_sq(), b.get_en_passant_sq()) << fen;
+        EXPECT_EQ(u.get_halfmove_clock(), b.get_halfmove_clock()) << fen;
+        for (int sq = 0; sq < 64; ++sq)
+            EXPECT_EQ(u.get_piece_on_square(sq), b.get_piece_on_square(sq)) << fen << " sq " << sq;
+        EXPECT_EQ(u.get_all_bitboards(), b.get_all_bitboards()) << fen;
+    }
+}
+
+TEST_F(BoardTest, UnpackRejectsCorruptRecords)
+{
+    ASSERT_TRUE(b.load_fen(constants::FenInitPos));
+    PackedPosition p;
+    b.pack(p);
+
+    // Cinquième pièce dans l'ordre de l'occupation : le roi blanc en e1, remplacé par une dame
+    PackedPosition no_king = p;
+    no_king.pieces[2] = (no_king.pieces[2] & 0xF0) | QUEEN;
+    EXPECT_FALSE(b.unpack(no_king));
+
+    PackedPosition bad_piece = p;
+    bad_piece.pieces[0] = 0x77;
+    EXPECT_FALSE(b.unpack(bad_piece));
+}
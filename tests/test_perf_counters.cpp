@@ -0,0 +1,40 @@
+#include "gtest/gtest.h"
+
+#include "common/perf_counters.hpp"
+
+TEST(PerfCountersTest, FormatPerNode)
+{
+    perf::Sample s;
+    EXPECT_EQ(perf::format(s, 100), "info string perf unavailable");
+    EXPECT_EQ(perf::json(s, 100), "null");
+
+    s.values[perf::Cycles] = 4000;
+    s.values[perf::Instructions] = 10000;
+    s.values[perf::DtlbMisses] = 50;
+    s.valid[perf::Cycles] = s.valid[perf::Instructions] = s.valid[perf::DtlbMisses] = true;
+    const std::string text = perf::format(s, 100);
+    EXPECT_NE(text.find("cycles 4000 instructions 10000 dtlb-misses 50"), std::string::npos) << text;
+    EXPECT_NE(text.find("ipc 2.50 cycles/node 40.00 instructions/node 100.00 dtlb-misses/node 0.50"), std::string::npos) << text;
+    EXPECT_EQ(text.find("llc"), std::string::npos) << text;
+    EXPECT_NE(perf::json(s, 100).find("\"ipc\":2.5000"), std::string::npos);
+}
+
+TEST(PerfCountersTest, CountsOnlyWhileEnabled)
+{
+    perf::Counters counters;
+    if (!counters.open())
+        GTEST_SKIP() << "perf_event counters unavailable";
+    counters.reset();
+    EXPECT_EQ(counters.read().values[perf::Instructions], 0u);
+
+    volatile std::uint64_t x = 0;
+    counters.enable();
+    for (int i = 0; i < 100000; ++i)
+        x = x + i;
+    counters.disable();
+    const perf::Sample s = counters.read();
+    if (!s.valid[perf::Instructions])
+        GTEST_SKIP() << "instructions counter unavailable";
+    EXPECT_GT(s.values[perf::Instructions], 100000u);
+    EXPECT_EQ(counters.read().values[perf::Instructions], s.values[perf::Instructions]);
+}
@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+
+#include "engine/engine_manager.hpp"
+
+TEST(SearchStatsTest, AddAndFormat)
+{
+    SearchStats a, b;
+    a.tt_probes = 4;
+    a.tt_hits = 1;
+    b.tt_probes = 4;
+    b.tt_hits = 3;
+    b.qnodes = 10;
+    a.add(b);
+    EXPECT_EQ(a.tt_probes, 8u);
+    EXPECT_EQ(a.tt_hits, 4u);
+    EXPECT_DOUBLE_EQ(SearchStats::percent(a.tt_hits, a.tt_probes), 50.0);
+    EXPECT_DOUBLE_EQ(SearchStats::percent(1, 0), 0.0);
+    EXPECT_NE(a.format().find("hits 4 (50.0%)"), std::string::npos);
+}
+
+#ifdef SEARCH_STATS
+
+TEST(SearchStatsTest, SearchFillsCountersAndManagerAggregates)
+{
+    MoveGen::initialize_bitboard_tables();
+    VBoard b;
+    b.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    EngineManager e{b, 8};
+
+    e.run_benchmark_fixed_depth(b, 7);
+    const SearchStats first = e.get_search_stats();
+    EXPECT_GT(first.nodes, 0u);
+    EXPECT_GT(first.qnodes, 0u);
+    EXPECT_GT(first.tt_probes, 0u);
+    EXPECT_LE(first.tt_cutoffs, first.tt_probes);
+    EXPECT_LE(first.tt_hits, first.tt_probes);
+    EXPECT_GT(first.fail_highs, 0u);
+    EXPECT_LE(first.fail_highs_first, first.fail_highs);
+    EXPECT_LE(first.nmp_cutoffs, first.nmp_tries);
+    EXPECT_LE(first.lmr_researches, first.lmr_searches);
+    // Table des pions lue au rapport : toutes les évaluations HCE, pas seulement le stand-pat
+    EXPECT_GT(first.pawn_probes, 0u);
+    EXPECT_LE(first.pawn_hits, first.pawn_probes);
+
+    // Cumul d'une recherche à l'autre, y compris multi-thread, jusqu'au reset
+    e.set_threads(2);
+    e.search_depth(5);
+    EXPECT_GT(e.get_search_stats().nodes, first.nodes);
+    e.reset_search_stats();
+    EXPECT_EQ(e.get_search_stats().nodes, 0u);
+    EXPECT_EQ(e.get_search_stats().pawn_probes, 0u);
+}
+
+#else
+
+TEST(SearchStatsTest, DisabledWithoutSearchStats)
+{
+    GTEST_SKIP() << "SEARCH_STATS not enabled";
+}
+
+#endif
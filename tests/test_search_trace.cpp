@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <filesystem>
+
+#include "engine/engine_manager.hpp"
+
+namespace
+{
+    std::string trace_path()
+    {
+        return (std::filesystem::temp_directory_path() / "chess26_test_trace.bin").string();
+    }
+}
+
+TEST(SearchTraceTest, PreorderTreeAndExplosionPoints)
+{
+    using search_trace::Reason;
+    // Racine, deux coups racine : e2e4 (1 fils) et d2d4 (sous-arbre de 12 nœuds), puis buffer plein
+    search_trace::Tracer tracer(16);
+    EXPECT_GE(tracer.get_records().capacity(), 16u); // Réservé d'avance
+    const search_trace::Record *const buffer = tracer.get_records().data();
+    const size_t root = tracer.enter(0, -100, 100, 0, 3, search_trace::PvWindow);
+    const size_t e4 = tracer.enter(Move(12, 28, PAWN), -100, 100, 1, 2, search_trace::PvWindow);
+    tracer.exit(tracer.enter(Move(52, 36, PAWN), -100, 100, 2, 1, 0), 5, Reason::QSearch);
+    tracer.exit(e4, -5, Reason::Searched);
+    const size_t d4 = tracer.enter(Move(11, 27, PAWN), -6, -5, 1, 2, 0);
+    const size_t d5 = tracer.enter(Move(51, 35, PAWN), 5, 6, 2, 1, 0);
+    for (int i = 0; i < 10; ++i)
+        tracer.exit(tracer.enter(Move(1, 18, KNIGHT), -6, -5, 3, 0, 0), 0, Reason::QSearch);
+    tracer.exit(d5, 7, Reason::Searched);
+    tracer.exit(tracer.enter(Move(52, 44, PAWN), 5, 6, 2, 1, 0), 0, Reason::TTCutoff);
+    EXPECT_EQ(tracer.enter(Move(50, 42, PAWN), 5, 6, 2, 1, 0), search_trace::Tracer::NoSlot);
+    tracer.exit(search_trace::Tracer::NoSlot, 0, Reason::Searched);
+    tracer.exit(d4, -7, Reason::FailHigh);
+    tracer.exit(root, 5, Reason::Searched);
+    ASSERT_TRUE(tracer.is_truncated());
+    EXPECT_EQ(tracer.get_records().data(), buffer); // Pas de réallocation
+    ASSERT_EQ(tracer.get_records().size(), 16u);
+
+    const std::string path = trace_path();
+    ASSERT_TRUE(search_trace::write(path, {tracer}, 42));
+    std::vector<search_trace::Section> sections;
+    ASSERT_TRUE(search_trace::read(path, sections));
+    std::remove(path.c_str());
+    ASSERT_EQ(sections.size(), 1u);
+    EXPECT_EQ(sections[0].header.root_key, 42u);
+    EXPECT_EQ(sections[0].records[d5].reason, static_cast<std::uint8_t>(Reason::Searched));
+
+    const search_trace::Tree tree(sections[0].records);
+    EXPECT_EQ(tree.size[root], 16u);
+    EXPECT_EQ(tree.size[e4], 2u);
+    EXPECT_EQ(tree.size[d4], 13u);
+    EXPECT_EQ(tree.size[d5], 11u);
+    EXPECT_EQ(tree.parent[d5], d4);
+    EXPECT_EQ(tree.children[d4], 2u);
+
+    // Sous-arbre / moyenne des fils du parent : d2d4 13 / 7.5, d7d5 11 / 6
+    search_trace::Options options;
+    options.explode_factor = 1.8;
+    const std::string summary = search_trace::summarize(sections[0], options);
+    EXPECT_NE(summary.find("truncated"), std::string::npos);
+    EXPECT_NE(summary.find("root d2d4 nodes 13"), std::string::npos) << summary;
+    EXPECT_NE(summary.find("root e2e4 nodes 2"), std::string::npos) << summary;
+    EXPECT_NE(summary.find("explode nodes 11 x1.8 ply 2 depth 1 window [5,6] score 7 searched path d2d4 d7d5"), std::string::npos) << summary;
+    EXPECT_EQ(summary.find("explode nodes 13"), std::string::npos) << summary;
+}
+
+#ifdef SEARCH_TRACE
+
+TEST(SearchTraceTest, SearchWritesOneSectionPerThread)
+{
+    MoveGen::initialize_bitboard_tables();
+    VBoard b;
+    b.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    EngineManager e{b, 8};
+    e.set_threads(2);
+    const std::string path = trace_path();
+    e.set_trace(path, 1);
+    e.search_depth(6);
+    e.set_trace("", 1);
+
+    std::vector<search_trace::Section> sections;
+    ASSERT_TRUE(search_trace::read(path, sections));
+    std::remove(path.c_str());
+    ASSERT_EQ(sections.size(), 2u);
+    const std::vector<search_trace::Record> &records = sections[0].records;
+    ASSERT_FALSE(records.empty());
+    EXPECT_EQ(records[0].level, 0);
+    EXPECT_EQ(records[0].ply, 0);
+    EXPECT_EQ(records[0].move, 0u);
+    EXPECT_EQ(sections[0].header.root_key, b.get_hash());
+
+    // Une racine par appel de ply 0 (itérations, fenêtres d'aspiration), tout autre nœud a un parent
+    const search_trace::Tree tree(records);
+    for (size_t i = 1; i < records.size(); ++i)
+        EXPECT_TRUE(records[i].level == 0 || tree.parent[i] != search_trace::Tree::None);
+    EXPECT_NE(search_trace::summarize(sections[0]).find("info string trace root "), std::string::npos);
+}
+
+#else
+
+TEST(SearchTraceTest, DisabledWithoutSearchTrace)
+{
+    GTEST_SKIP() << "SEARCH_TRACE not enabled";
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+
+#ifdef SPSA_TUNING
+
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+
+#include "engine/search/tuning/spsa.hpp"
+
+namespace
+{
+    const char *TestConfig =
+        "# test\n"
+        "iterations 4\n"
+        "pairs 2\n"
+        "nodes 300\n"
+        "hash 1\n"
+        "seed 7\n"
+        "max_plies 40\n"
+        "nmp_r_const, int, 3, 1, 6, 1, 0.002\n"
+        "lmr_table_init_const, float, 0.6295, 0.2, 1.2, 0.05, 0.002\n";
+}
+
+TEST(SPSATunerTest, ParsesOpenBenchStyleConfig)
+{
+    std::istringstream in(TestConfig);
+    spsa::Config config;
+    std::string error;
+    ASSERT_TRUE(spsa::parse_config(in, config, error)) << error;
+
+    EXPECT_EQ(config.iterations, 4);
+    EXPECT_EQ(config.pairs, 2u);
+    EXPECT_EQ(config.nodes, 300);
+    ASSERT_EQ(config.params.size(), 2u);
+    EXPECT_EQ(config.params[0].target->name, "nmp_r_const");
+    EXPECT_FALSE(config.params[0].target->real);
+    EXPECT_TRUE(config.params[1].target->real);
+    EXPECT_DOUBLE_EQ(config.params[1].c_end, 0.05);
+
+    std::istringstream unknown("no_such_param, int, 1, 0, 2, 1, 0.002\n");
+    spsa::Config bad;
+    EXPECT_FALSE(spsa::parse_config(unknown, bad, error));
+    EXPECT_NE(error.find("no_such_param"), std::string::npos);
+}
+
+TEST(SPSATunerTest, ScheduleEndsAtCEndAndREnd)
+{
+    spsa::Config config;
+    config.iterations = 500;
+    spsa::Param p;
+    p.c_end = 2.0;
+    p.r_end = 0.002;
+
+    const spsa::Step first = spsa::step_for(config, p, 1);
+    const spsa::Step last = spsa::step_for(config, p, config.iterations);
+    EXPECT_NEAR(last.c, p.c_end, 1e-9);
+    EXPECT_NEAR(last.r, p.r_end, 1e-12);
+    EXPECT_GT(first.c, last.c);
+}
+
+TEST(SPSATunerTest, SearchParamsAreThreadLocal)
+{
+    const int before = engine_constants::search::null_move_pruning::RConst;
+    int seen = 0;
+    std::thread([&]()
+                {
+        search_params::find("nmp_r_const")->set(before + 2);
+        seen = engine_constants::search::null_move_pruning::RConst; })
+        .join();
+    EXPECT_EQ(seen, before + 2);
+    EXPECT_EQ(engine_constants::search::null_move_pruning::RConst, before);
+}
+
+TEST(SPSATunerTest, RunIsDeterministicAndResumable)
+{
+    MoveGen::initialize_bitboard_tables();
+    const std::string out = (std::filesystem::temp_directory_path() / "chess26_test_spsa.txt").string();
+
+    auto run = [&](std::vector<double> &values)
+    {
+        std::istringstream in(TestConfig);
+        spsa::Config config;
+        std::string error;
+        EXPECT_TRUE(spsa::parse_config(in, config, error)) << error;
+        config.output = out;
+        config.report_every = 2;
+        spsa::Tuner tuner(config);
+        EXPECT_TRUE(tuner.run());
+        for (const spsa::Param &p : tuner.get_config().params)
+        {
+            EXPECT_GE(p.value, p.min);
+            EXPECT_LE(p.value, p.max);
+            values.push_back(p.value);
+        }
+    };
+
+    std::vector<double> a, b;
+    run(a);
+    run(b);
+    EXPECT_EQ(a, b);
+
+    // Le fichier de sortie est une configuration complète, à l'itération atteinte
+    spsa::Config resumed;
+    std::string error;
+    ASSERT_TRUE(spsa::load_config(out, resumed, error)) << error;
+    EXPECT_EQ(resumed.iteration, 4);
+    ASSERT_EQ(resumed.params.size(), 2u);
+    EXPECT_NEAR(resumed.params[1].value, a[1], 1e-8);
+    std::remove(out.c_str());
+}
+
+#else
+
+TEST(SPSATunerTest, DisabledWithoutSPSATuning)
+{
+    GTEST_SKIP() << "SPSA_TUNING not enabled";
+}
+
+#endif
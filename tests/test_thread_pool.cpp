@@ -0,0 +1,52 @@
+#include "common/thread_pool.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+// Chaque élément est traité exactement une fois, même avec des blocs de coût très inégal
+TEST(ThreadPoolTest, CoversEveryElementOnce)
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(10007);
+
+    for (int round = 0; round < 200; ++round)
+    {
+        std::vector<long long> per_worker(pool.size(), 0);
+        pool.run(3, hits.size(), 17, [&](unsigned w, std::size_t b, std::size_t e)
+                 {
+            ASSERT_LT(w, pool.size());
+            volatile long long spin = 0;
+            for (std::size_t i = b; i < e; ++i)
+            {
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+                if (i % 1000 == 0)
+                    for (int k = 0; k < 20000; ++k)
+                        spin = spin + k;
+            }
+            per_worker[w] += static_cast<long long>(e - b); });
+        EXPECT_EQ(std::accumulate(per_worker.begin(), per_worker.end(), 0LL), static_cast<long long>(hits.size() - 3));
+    }
+
+    for (std::size_t i = 0; i < hits.size(); ++i)
+        EXPECT_EQ(hits[i].load(), i < 3 ? 0 : 200) << i;
+}
+
+TEST(ThreadPoolTest, ResizeAndEmptyRanges)
+{
+    ThreadPool pool(1);
+    int calls = 0;
+    pool.run(5, 5, 8, [&](unsigned, std::size_t, std::size_t)
+             { ++calls; });
+    EXPECT_EQ(calls, 0);
+
+    pool.resize(3);
+    EXPECT_EQ(pool.size(), 3u);
+    std::atomic<long long> sum{0};
+    pool.run(0, 1000, 1, [&](unsigned, std::size_t b, std::size_t e)
+             {
+        for (std::size_t i = b; i < e; ++i)
+            sum += static_cast<long long>(i); });
+    EXPECT_EQ(sum.load(), 999 * 1000 / 2);
+}
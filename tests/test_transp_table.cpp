@@ -1,6 +1,11 @@
 #include "engine/tt/transp_table.hpp"
 #include "gtest/gtest.h"
 
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
 class TTTest : public ::testing::Test
 {
 protected:
@@ -78,4 +83,95 @@ TEST_F(TTTest, AlphaBetaCuts)
     // On ne peut pas couper. hit doit être FALSE.
     hit = tt.probe(key, 10, 0, 30, 40, score, m, flag);
     ASSERT_FALSE(hit);
-}
\ No newline at end of file
+}
+TEST_F(TTTest, SaveLoadKeepsDeepEntriesAcrossTableSizes)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "chess26_test_tt.bin").string();
+    TranspositionTable tt;
+    tt.resize(1);
+    const Move move(12, 28, PAWN); // e2e4
+    tt.store(0x1234, 12, 0, 35, TT_EXACT, move);
+    tt.store(0x5678, 3, 0, -20, TT_BETA, Move());
+    tt.store(0x9ABC, 20, 4, engine_constants::eval::MateScore - 9, TT_EXACT, Move());
+
+    size_t written = 0;
+    ASSERT_TRUE(tt.save(path, 10, 0xE7A1, written));
+    EXPECT_EQ(written, 2u);
+
+    TranspositionTable warm;
+    warm.resize(4);
+    size_t loaded = 0;
+    ASSERT_TRUE(warm.load(path, 0xE7A1, loaded));
+    EXPECT_EQ(loaded, 2u);
+
+    int score;
+    Move m = 0;
+    TTFlag flag;
+    ASSERT_TRUE(warm.probe(0x1234, 12, 0, -engine_constants::eval::Inf, engine_constants::eval::Inf, score, m, flag));
+    EXPECT_EQ(score, 35);
+    EXPECT_EQ(m, move);
+    EXPECT_EQ(flag, TT_EXACT);
+    // Distance au mat conservée
+    ASSERT_TRUE(warm.probe(0x9ABC, 20, 4, -engine_constants::eval::Inf, engine_constants::eval::Inf, score, m, flag));
+    EXPECT_EQ(score, engine_constants::eval::MateScore - 9);
+    // Sous la profondeur minimale : non sauvegardée
+    EXPECT_EQ(warm.get_move(0x5678), Move(0));
+    std::remove(path.c_str());
+}
+
+TEST_F(TTTest, LoadRejectsCorruptFiles)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "chess26_test_tt.bin").string();
+    TranspositionTable tt;
+    tt.resize(1);
+    tt.store(0x1234, 12, 0, 35, TT_EXACT, Move(12, 28, PAWN));
+    tt.store(0x4321, 8, 0, 10, TT_ALPHA, Move());
+    size_t count = 0;
+    ASSERT_TRUE(tt.save(path, 0, 0xE7A1, count));
+    const auto size = std::filesystem::file_size(path);
+
+    TranspositionTable target;
+    target.resize(1);
+
+    // Un octet d'entrée modifié : somme de contrôle fausse
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(sizeof(TTFileHeader) + 3);
+        f.put('\x5A');
+    }
+    EXPECT_FALSE(target.load(path, 0xE7A1, count));
+
+    // Tronqué
+    ASSERT_TRUE(tt.save(path, 0, 0xE7A1, count));
+    std::filesystem::resize_file(path, size - 1);
+    EXPECT_FALSE(target.load(path, 0xE7A1, count));
+
+    // Autre version
+    ASSERT_TRUE(tt.save(path, 0, 0xE7A1, count));
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(offsetof(TTFileHeader, version));
+        f.put('\x7F');
+    }
+    EXPECT_FALSE(target.load(path, 0xE7A1, count));
+    EXPECT_FALSE(target.load(path + ".missing", 0xE7A1, count));
+
+    // count forgé : count * sizeof(TTEntry) déborde et retombe sur la taille réelle
+    ASSERT_TRUE(tt.save(path, 0, 0xE7A1, count));
+    {
+        const std::uint64_t forged = (std::uint64_t{1} << 60) + 2;
+        static_assert(sizeof(TTEntry) == 16);
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(offsetof(TTFileHeader, count));
+        f.write(reinterpret_cast<const char *>(&forged), sizeof(forged));
+    }
+    EXPECT_FALSE(target.load(path, 0xE7A1, count));
+
+    // Sauvegardé sous une autre éval
+    ASSERT_TRUE(tt.save(path, 0, 0xE7A1, count));
+    EXPECT_FALSE(target.load(path, 0xE7A2, count));
+
+    EXPECT_EQ(target.get_move(0x1234), Move(0));
+    EXPECT_EQ(count, 0u);
+    std::remove(path.c_str());
+}